@@ -84,7 +84,7 @@ by reading AGENTS.md before starting.
 ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
 """
 
-from typing import Dict, List, Any, Optional, Union, Literal, overload
+from typing import Callable, Dict, List, Any, Optional, Tuple, Union, Literal, overload
 
 # Type aliases for JSON-like structures
 JsonDict = Dict[str, Any]
@@ -109,6 +109,9 @@ WireType = Literal["round", "litz", "rectangular", "foil"]
 
 ModelsDict = Dict[str, str]
 
+# 1-D float64 sample buffer (numpy.ndarray or anything numpy can convert)
+FloatArray = Any
+
 # =============================================================================
 # DATABASE ACCESS - Core Shapes
 # =============================================================================
@@ -233,6 +236,17 @@ def get_core_material_steinmetz_coefficients(material: Union[str, CoreMaterial],
     """
     ...
 
+def fit_steinmetz_coefficients_batch(jobs: List[JsonDict], threads: int = 0, update_database: bool = False) -> JsonDict:
+    """Fit Steinmetz coefficients for many materials in parallel.
+
+    Each job is {"material": name, "data": [...], "ranges": [[fmin, fmax], ...]};
+    omitted data and ranges come from the database material. Returns
+    {"data": [{material, coefficientsPerRange, errorPerRange} or {material, error}]}
+    in job order. With update_database, each fitted material's Steinmetz
+    method in the database is replaced and the entry gains "updated".
+    """
+    ...
+
 # =============================================================================
 # DATABASE ACCESS - Wires
 # =============================================================================
@@ -263,6 +277,18 @@ def find_wire_by_dimension(dimension: float, wire_type: WireType, standard: str)
     """
     ...
 
+def query_wire_index(query: JsonDict) -> JsonDict:
+    """Binary-search the sorted wire index.
+
+    Keys (all optional): type, standard, conductingArea [min, max],
+    outerDimension [min, max], frequency, maximumSkinAcFactor,
+    maximumNumberResults. Returns {"data": [{name, conductingArea,
+    outerDimension, skinAcFactor?}], "count", "total"} ordered by area.
+    With maximumSkinAcFactor, wires whose factor cannot be computed are
+    dropped. The wire adviser and the other wire finders do not use the index.
+    """
+    ...
+
 def get_available_wire_types() -> List[str]:
     """Get list of available wire types."""
     ...
@@ -423,12 +449,15 @@ def calculate_core_losses(
     core: Core, 
     coil: Coil, 
     inputs: Inputs, 
-    models: ModelsDict
+    models: ModelsDict,
+    outputs: Optional[List[str]] = None
 ) -> JsonDict:
     """Calculate core losses for operating conditions.
     
     Args:
         models: Dict with "coreLosses", "reluctance", "coreTemperature" keys.
+        outputs: Subset of the returned keys to compute ("coreLosses" is the
+            whole CoreLossesOutput); None computes everything.
         
     Returns:
         Dict with: coreLosses (W), magneticFluxDensityPeak (T),
@@ -480,10 +509,71 @@ def calculate_dc_losses_per_meter(wire: Wire, current: JsonDict, temperature: fl
     """DC losses per meter in W/m."""
     ...
 
+@overload
 def calculate_skin_ac_losses_per_meter(wire: Wire, current: JsonDict, temperature: float) -> float:
     """Skin effect AC losses per meter in W/m."""
     ...
 
+@overload
+def calculate_skin_ac_losses_per_meter(wire: Wire, time: FloatArray, data: FloatArray, frequency: float, temperature: float) -> float:
+    """Skin effect AC losses per meter in W/m for a current sampled into NumPy arrays."""
+    ...
+
+# =============================================================================
+# WAVEFORM PROCESSING
+# =============================================================================
+
+@overload
+def calculate_harmonics(waveform: JsonDict, frequency: float, energy_threshold: Optional[float] = None) -> JsonDict:
+    """Harmonic amplitudes and frequencies of a waveform.
+
+    With energy_threshold, adaptively sampled and truncated to the harmonics
+    holding all but that fraction of the AC energy; adds numberSamples,
+    totalHarmonics, retainedHarmonics and truncationError.
+    """
+    ...
+
+@overload
+def calculate_harmonics(time: FloatArray, data: FloatArray, frequency: float) -> Dict[str, FloatArray]:
+    """Harmonics of NumPy samples; returns {"amplitudes", "frequencies"} arrays."""
+    ...
+
+@overload
+def calculate_sampled_waveform(waveform: JsonDict, frequency: float) -> JsonDict:
+    """Uniformly resampled waveform."""
+    ...
+
+@overload
+def calculate_sampled_waveform(time: FloatArray, data: FloatArray, frequency: float) -> Tuple[FloatArray, FloatArray]:
+    """Uniformly resampled NumPy samples as a (time, data) tuple of arrays."""
+    ...
+
+@overload
+def calculate_processed_data(signal_descriptor: JsonDict, sampled_waveform: JsonDict, include_dc_component: bool) -> JsonDict:
+    """RMS, peak, offset, effective frequency and other metrics."""
+    ...
+
+@overload
+def calculate_processed_data(time: FloatArray, data: FloatArray, frequency: float, include_dc_component: bool) -> JsonDict:
+    """Processed data of NumPy samples; harmonics are computed internally."""
+    ...
+
+def transform_excitations(
+    excitations: List[JsonDict],
+    steps: Union[List[JsonDict], List[List[JsonDict]]],
+    threads: int = 0,
+) -> List[JsonDict]:
+    """Apply reflection, rescaling and induced-signal steps to many excitations.
+
+    Each step is {"operation": ..., <value>}: reflectToSecondary and
+    reflectToPrimary take "turnRatio", scaleToFrequency "frequency",
+    inducedVoltage and inducedCurrent "magnetizingInductance". `steps` is
+    applied to every excitation, or given as one list per excitation.
+    Harmonics and processed data are computed once per signal. The list is
+    overwritten with the results and returned.
+    """
+    ...
+
 def calculate_skin_ac_resistance_per_meter(wire: Wire, current: JsonDict, temperature: float) -> float:
     """Skin effect AC resistance per meter in Ohm/m."""
     ...
@@ -574,10 +664,14 @@ def get_layers_by_winding_index(coil: Coil, winding_index: int) -> List[JsonDict
 # DESIGN ADVISER
 # =============================================================================
 
-def process_inputs(inputs: Inputs) -> Inputs:
+def process_inputs(inputs: Inputs, harmonic_energy_threshold: Optional[float] = None) -> Inputs:
     """Process inputs adding harmonics and processed data.
     
     REQUIRED before calling adviser functions.
+
+    With harmonic_energy_threshold, each signal keeps only the harmonics
+    holding all but that fraction of its AC energy, and the result gains
+    "harmonicTruncation" (per operating point, per excitation) reports.
     """
     ...
 
@@ -585,7 +679,11 @@ def calculate_advised_cores(
     inputs: Inputs,
     weights: Dict[str, float],
     max_results: int = 10,
-    core_mode: str = "available cores"
+    core_mode: str = "available cores",
+    conversion_threads: int = 1,
+    prefilter: Optional[Dict[str, List[Optional[float]]]] = None,
+    return_handles: bool = False,
+    settings: Optional[JsonDict] = None
 ) -> List[JsonDict]:
     """Get recommended cores for design requirements.
     
@@ -598,6 +696,14 @@ def calculate_advised_cores(
         weights: {"EFFICIENCY": 1.0, "DIMENSIONS": 0.5, "COST": 0.3}.
         max_results: Maximum number of recommendations.
         core_mode: "available cores" or "standard cores" (lowercase with space!).
+        conversion_threads: Threads converting the results to dicts
+                 (1 = serial, 0 = all cores). Only that conversion is
+                 parallel; the search itself is single-threaded and its
+                 time and ranking are identical for every value.
+        prefilter: {column: [min, max]} ranges over the core feature index
+                   (see query_core_index); only matching cores are advised.
+        return_handles: Put a MasHandle in "data" instead of each result dict.
+        settings: set_settings() dict applied for this call only.
         
     Returns:
         JSON object with "data" array containing ranked results.
@@ -611,7 +717,14 @@ def calculate_advised_cores(
 def calculate_advised_magnetics(
     inputs: Inputs,
     max_results: int = 5,
-    core_mode: str = "available cores"
+    core_mode: str = "available cores",
+    conversion_threads: int = 1,
+    prefilter: Optional[Dict[str, List[Optional[float]]]] = None,
+    progress_callback: Optional[Callable[[JsonDict], Optional[bool]]] = None,
+    cancellation_token: Optional["CancellationToken"] = None,
+    return_handles: bool = False,
+    settings: Optional[JsonDict] = None,
+    interruptible: bool = False
 ) -> JsonDict:
     """Get complete magnetic designs (core + winding).
     
@@ -623,6 +736,33 @@ def calculate_advised_magnetics(
         inputs: Processed inputs dict with "designRequirements" and "operatingPoints".
         max_results: Maximum number of recommendations.
         core_mode: "available cores" or "standard cores" (lowercase with space!).
+        conversion_threads: Threads converting the results to dicts
+                 (1 = serial, 0 = all cores). Only that conversion is
+                 parallel; the search itself is single-threaded and its
+                 time and ranking are identical for every value.
+        prefilter: {column: [min, max]} ranges over the core feature index
+                   (see query_core_index); only matching cores are advised.
+        progress_callback: Called at most every 100 ms with {"phase",
+                   "evaluated", "total", "bestScore", "elapsedMs"}; phase is
+                   "search" and "done", or with interruptible "screening",
+                   "ranking" and "done". Return False to stop.
+        cancellation_token: CancellationToken; cancel() from another thread
+                   stops an interruptible search between two steps, a
+                   plain one only before it starts.
+        return_handles: Put a MasHandle in "data" instead of each result
+                   dict; a handle converts only the fields that are read.
+        settings: set_settings() dict applied for this call only; the
+                   global settings are restored afterwards.
+        interruptible: Search the cores in steps so the callback or token
+                   can stop it between two. This changes the ranking: the
+                   merged result can differ from the single adviser call.
+
+    A token or a callback returning False does nothing to a running search
+    unless interruptible=True; without it a token only skips a search that
+    has not started yet.
+
+    Advisers hold the library exclusively, so concurrent adviser calls run
+    one after another; other Python threads keep running meanwhile.
     
     Returns:
         JSON object with "data" array containing ranked results.
@@ -630,6 +770,9 @@ def calculate_advised_magnetics(
         - "mas": Mas object with magnetic, inputs, and optionally outputs
         - "scoring": Overall float score
         - "scoringPerFilter": Object with individual scores per filter
+        With interruptible also "cancelled", "truncated",
+        "evaluatedCores", "totalCores" and "elapsedMs"; with only a
+        callback or token, "cancelled".
 
     Example (CORRECT — positional args, lowercase core_mode):
         >>> result = PyOM.calculate_advised_magnetics(mas_inputs, 3, "available cores")
@@ -643,6 +786,109 @@ def calculate_advised_magnetics(
     """
     ...
 
+def save_state_snapshot(path: str) -> JsonDict:
+    """Write settings, databases, loaded cores and the magnetics cache to a binary snapshot.
+    
+    Returns:
+        Entry counts per database plus "bytes".
+    """
+    ...
+
+def load_state_snapshot(path: str) -> JsonDict:
+    """Replace the loaded state with a snapshot from save_state_snapshot (no NDJSON parsing).
+    
+    Returns:
+        Restored entry counts plus "bytes", or {"data": "Exception: ..."}.
+    """
+    ...
+
+def attach_shared_state(path: str, hydrate: bool = False) -> JsonDict:
+    """Map a snapshot read-only so all worker processes share one copy via the page cache.
+    
+    find_core_material_by_name / find_core_shape_by_name / find_wire_by_name
+    then decode single entries from the mapping. They are its only readers:
+    MKF's own name lookups (cores and magnetics built from names, losses,
+    simulations, advisers) do not see the store. hydrate=True fills the
+    in-process databases they use.
+    """
+    ...
+
+def detach_shared_state() -> None:
+    """Unmap the shared store; lookups fall back to the in-process databases."""
+    ...
+
+def get_shared_state_info() -> JsonDict:
+    """{"attached": bool, "path", "bytes", entry counts per database}."""
+    ...
+
+def query_core_index(ranges: Dict[str, List[Optional[float]]]) -> JsonDict:
+    """Range-scan the core feature index built by load_cores(..., index_path).
+    
+    Args:
+        ranges: {column: [min, max]}, null bounds open. Columns: effectiveArea,
+                effectiveVolume, windingWindowArea, magneticFluxDensitySaturation,
+                volume, steinmetzK, steinmetzAlpha, steinmetzBeta (SI units).
+    
+    Returns:
+        {"names": [...], "count": int, "total": int}. Cores missing a
+        feature are never excluded.
+    """
+    ...
+
+def calculate_advised_wires_batch(
+    requests: List[JsonDict],
+    max_results: int,
+    use_planar_wires: bool = False
+) -> JsonDict:
+    """Wire advice for many sections at once.
+
+    Each request has "winding", "section", "current",
+    "solidInsulationRequirements", "temperature" and optional
+    "numberSections". Returns {"data": [...]} with one
+    calculate_advised_wires result (or {"error"}) per request.
+    """
+    ...
+
+def calculate_advised_magnetics_fast(
+    inputs: Inputs,
+    max_results: int = 5,
+    core_mode: str = "available cores",
+    time_budget_ms: float = 0,
+    max_evaluations: int = 0,
+    progress_callback: Optional[Callable[[JsonDict], Optional[bool]]] = None,
+    cancellation_token: Optional["CancellationToken"] = None,
+    return_handles: bool = False,
+    settings: Optional[JsonDict] = None,
+    interruptible: bool = False
+) -> JsonDict:
+    """Fast analytical designs ranked by total losses (lower is better).
+    
+    With time_budget_ms, max_evaluations or interruptible, cores are tried
+    in batches of increasing effective volume and the best so far is
+    returned with "truncated", "cancelled", "evaluatedCores", "totalCores"
+    and "elapsedMs". Candidates are not pruned by a score bound; only the
+    budget, the cap and cancellation cut the search short.
+    progress_callback, cancellation_token, return_handles and settings work
+    as in calculate_advised_magnetics.
+    """
+    ...
+
+def calculate_advised_magnetics_with_filters(
+    inputs: Inputs,
+    filter_flow: List[JsonDict],
+    max_results: int = 5,
+    core_mode: str = "available cores",
+    time_budget_ms: float = 0,
+    max_evaluations: int = 0,
+    progress_callback: Optional[Callable[[JsonDict], Optional[bool]]] = None,
+    cancellation_token: Optional["CancellationToken"] = None,
+    return_handles: bool = False,
+    settings: Optional[JsonDict] = None,
+    interruptible: bool = False
+) -> JsonDict:
+    """Fast designs with a caller-supplied filter flow; same budget and progress options as the fast adviser."""
+    ...
+
 def calculate_advised_magnetics_from_catalog(
     inputs: Inputs,
     catalog: List[Magnetic],
@@ -663,14 +909,233 @@ def calculate_advised_magnetics_from_catalog(
 # SIMULATION
 # =============================================================================
 
-def simulate(inputs: Inputs, magnetic: Magnetic, models: ModelsDict) -> Mas:
+def simulate(inputs: Inputs, magnetic: Magnetic, models: ModelsDict, outputs: Optional[List[str]] = None) -> Mas:
     """Run complete simulation.
     
+    outputs limits the run to any of "coreLosses", "windingLosses" and
+    "magnetizingInductance"; each Mas output then holds only those fields.
+    
     Returns:
         Mas object with outputs (losses, temperatures, etc.).
     """
     ...
 
+def configure_simulation_cache(max_entries: int, max_bytes: int = 0) -> None:
+    """Enable (max_entries > 0) or disable the simulate() LRU result cache.
+    
+    Results are keyed on canonical inputs, magnetic, models and settings.
+    max_bytes bounds the serialized size of the cache (0 = unbounded).
+    """
+    ...
+
+def get_simulation_cache_stats() -> JsonDict:
+    """{"hits", "misses", "evictions", "entries", "bytes", "maxEntries", "maxBytes"}."""
+    ...
+
+def clear_simulation_cache() -> str:
+    """Drop all cached simulate() results (counters are kept)."""
+    ...
+
+def configure_field_solution_cache(max_entries: int, max_bytes: int = 0) -> None:
+    """Enable (max_entries > 0) or disable the winding-window field solution cache.
+
+    Shared by calculate_magnetic_field_strength_field,
+    calculate_winding_losses and plot_wire_losses; plot_magnetic_field
+    caches its painter-grid field too. It stores field solutions only, never
+    losses or SVGs. Keyed on magnetic, operating point and settings;
+    max_bytes bounds the serialized size (0 = unbounded).
+    """
+    ...
+
+def get_field_solution_cache_stats() -> JsonDict:
+    """{"hits", "misses", "evictions", "entries", "bytes", "maxEntries", "maxBytes"}."""
+    ...
+
+def clear_field_solution_cache() -> str:
+    """Drop all cached field solutions (counters are kept)."""
+    ...
+
+class CancellationToken:
+    """Stops a running adviser / converter design when cancelled from another thread."""
+
+    def __init__(self) -> None: ...
+    def cancel(self) -> None: ...
+    def reset(self) -> None: ...
+
+    @property
+    def cancelled(self) -> bool: ...
+
+class MagneticHandle:
+    """Read-only view of the native Magnetic inside a MasHandle."""
+
+    @property
+    def reference(self) -> Optional[str]: ...
+    @property
+    def core_name(self) -> Optional[str]: ...
+    @property
+    def core_shape(self) -> str: ...
+    @property
+    def core_material(self) -> str: ...
+    @property
+    def winding_names(self) -> List[str]: ...
+    @property
+    def number_turns(self) -> List[int]: ...
+    @property
+    def core(self) -> Core:
+        """Converted on each access."""
+        ...
+    @property
+    def coil(self) -> Coil:
+        """Converted on each access."""
+        ...
+    def to_dict(self) -> Magnetic: ...
+    def __getitem__(self, key: str) -> Any: ...
+
+class MasHandle:
+    """One adviser result kept as a native Mas (return_handles=True).
+
+    scoring, reference and the names on magnetic convert nothing; inputs,
+    outputs and to_dict() convert on each access. handle["scoring"],
+    handle["scoringPerFilter"] and handle["mas"] mirror the dict results.
+    """
+
+    @property
+    def scoring(self) -> float: ...
+    @property
+    def scoring_per_filter(self) -> Optional[Dict[str, float]]: ...
+    @property
+    def reference(self) -> Optional[str]: ...
+    @property
+    def magnetic(self) -> MagneticHandle: ...
+    @property
+    def inputs(self) -> Inputs: ...
+    @property
+    def outputs(self) -> List[JsonDict]: ...
+    def to_dict(self) -> Mas:
+        """The full Mas, as the "mas" entry of the dict results."""
+        ...
+    def to_result_dict(self) -> JsonDict:
+        """{"mas", "scoring", "scoringPerFilter"} as the dict results."""
+        ...
+    def __getitem__(self, key: str) -> Any: ...
+    def __contains__(self, key: str) -> bool: ...
+
+class MagneticSession:
+    """A magnetic built once and evaluated against many operating points."""
+
+    def __init__(self, magnetic_json: Magnetic, models_json: Optional[ModelsDict] = None) -> None: ...
+
+    @property
+    def magnetic(self) -> Magnetic: ...
+
+    @property
+    def models(self) -> Optional[ModelsDict]: ...
+
+    def evaluate(self, operating_point_json: OperatingPoint) -> JsonDict:
+        """{"coreLosses", "windingLosses", "totalLosses", "magneticFluxDensityPeak", "maximumCoreTemperature"}."""
+        ...
+
+    def calculate_core_losses(self, operating_point_json: OperatingPoint) -> JsonDict:
+        """Full CoreLossesOutput at one operating point."""
+        ...
+
+    def calculate_winding_losses(self, operating_point_json: OperatingPoint, temperature: Optional[float] = None) -> JsonDict:
+        """Full WindingLossesOutput; temperature defaults to the ambient temperature."""
+        ...
+
+    def simulate(self, inputs_json: Inputs) -> Mas:
+        """Same as simulate(inputs, magnetic, models) for the session magnetic."""
+        ...
+
+class DesignPipeline:
+    """A converter specification designed in stages, each cached for reuse."""
+
+    def __init__(
+        self,
+        topology_name: str,
+        converter_json: JsonDict,
+        use_ngspice: bool = True,
+        max_designs: int = 16,
+    ) -> None: ...
+
+    def inputs(self) -> JsonDict:
+        """The processed converter, as process_converter() returns it."""
+        ...
+
+    def design(
+        self,
+        max_results: int = 1,
+        core_mode_json: str = "available cores",
+        weights_json: Optional[Dict[str, float]] = None,
+        fast: bool = False,
+    ) -> JsonDict:
+        """Advised magnetics for the cached inputs; a repeated request is served from the cache."""
+        ...
+
+    def rerank(self, weights_json: Dict[str, float], max_results: int = -1) -> JsonDict:
+        """Candidates of the last full design() ranked by the weighted sum of their scoringPerFilter."""
+        ...
+
+    def clear(self) -> None:
+        """Drop every cached stage."""
+        ...
+
+    def info(self) -> JsonDict:
+        """{"inputsCached", "designs", "maxDesigns", "hits", "misses"}."""
+        ...
+
+class MaterialPropertyTable:
+    """Lazily built lookup tables of one material's permeability and resistivity."""
+
+    def __init__(
+        self,
+        material: Union[str, CoreMaterial],
+        temperature_range: Tuple[float, float] = (-40.0, 200.0),
+        magnetic_field_dc_bias_range: Tuple[float, float] = (0.0, 0.0),
+        frequency_range: Tuple[float, float] = (1e3, 10e6),
+        points: int = 33,
+        max_relative_error: float = 1e-4,
+        max_points: int = 257,
+    ) -> None: ...
+
+    @property
+    def material_name(self) -> str: ...
+
+    def permeability(self, temperature: FloatArray, magnetic_field_dc_bias: FloatArray, frequency: FloatArray) -> FloatArray:
+        """Initial permeability, as get_material_permeability; inputs broadcast."""
+        ...
+
+    def resistivity(self, temperature: FloatArray) -> FloatArray:
+        """Resistivity in Ohm·m, as get_material_resistivity."""
+        ...
+
+    def complex_permeability(self, frequency: FloatArray) -> Tuple[FloatArray, FloatArray]:
+        """(real, imaginary) arrays, as calculate_complex_permeability."""
+        ...
+
+    def build(self) -> None:
+        """Sample every table now instead of on first use."""
+        ...
+
+    def info(self) -> Dict[str, JsonDict]:
+        """{"points", "errorEstimate"} of each built table."""
+        ...
+
+def sweep_grid(
+    magnetic: Magnetic,
+    operating_point: OperatingPoint,
+    axes: List[Tuple[str, FloatArray]],
+    models: Optional[ModelsDict] = None,
+    threads: int = 0
+) -> Dict[str, Any]:
+    """Losses over the Cartesian grid of temperature/frequency/dcBias/dutyCycle axes.
+    
+    Returns "coreLosses", "windingLosses", "totalLosses" and
+    "magneticFluxDensityPeak" as arrays shaped like the axes, plus "axes",
+    "coordinates" and "failedPoints" (NaN entries).
+    """
+    ...
+
 def magnetic_autocomplete(magnetic: Magnetic, config: JsonDict) -> Magnetic:
     """Autocomplete partial magnetic specification."""
     ...
@@ -706,6 +1171,32 @@ def calculate_insulation(inputs: Inputs) -> JsonDict:
     """
     ...
 
+# =============================================================================
+# PROFILING
+# =============================================================================
+
+def enable_profiling(reset: bool = True) -> None:
+    """Record wall time of the instrumented hot paths into per-thread call trees."""
+    ...
+
+def disable_profiling() -> None:
+    """Stop recording; the profile so far stays readable."""
+    ...
+
+def reset_profile() -> None:
+    """Drop all recorded timers and counters."""
+    ...
+
+def get_profile() -> JsonDict:
+    """Merged profile of all threads.
+
+    Returns:
+        {"enabled", "threads", "scopes": [{"path", "name", "depth", "calls",
+        "totalMs", "selfMs"}, ...] heaviest first, "counters": {name: int},
+        "folded": collapsed stacks ("a;b <self µs>") for flamegraph.pl / speedscope}
+    """
+    ...
+
 # =============================================================================
 # VISUALIZATION
 # =============================================================================
@@ -761,6 +1252,21 @@ def plot_bobbin(bobbin: Bobbin, use_colors: bool = True) -> str:
     """Generate SVG of bobbin."""
     ...
 
+def plot_batch(items: List[JsonDict], threads: int = 0) -> List[JsonDict]:
+    """Render many plots in parallel, without leaving files on disk.
+
+    Args:
+        items: Plot requests {"kind", "magnetic", "wire", "operatingPoint",
+            "textColor", "bgColor"}; kind is the suffix of a plot_* function
+            ("core", "magnetic", "wire", "turns", "wire_losses", ...).
+        threads: Worker threads; 0 or less uses all hardware threads.
+
+    Returns:
+        One {"success", "svg"} or {"success", "error"} dict per request,
+        in request order.
+    """
+    ...
+
 # =============================================================================
 # SETTINGS
 # =============================================================================
@@ -789,7 +1295,25 @@ def get_default_models() -> JsonDict:
 # CONVERTER TOPOLOGY PROCESSORS
 # =============================================================================
 
-def process_converter(topology: str, converter: JsonDict, use_ngspice: bool = True) -> JsonDict:
+def run_ngspice_batch(
+    decks: List[str],
+    threads: int = 0,
+    ngspice_path: str = "ngspice",
+    keep_files: bool = False
+) -> List[Dict[str, Any]]:
+    """Run SPICE decks concurrently, one `ngspice -b` process per deck.
+    
+    Returns one dict per deck in order with "index", "ok", "vectors"
+    (name -> NumPy array of the first plot), "plots" and, on failure,
+    "error" and "log".
+
+    Needs a standalone ngspice executable on PATH or at ngspice_path; the
+    wheel only bundles the shared library. Raises RuntimeError when the
+    executable cannot be found.
+    """
+    ...
+
+def process_converter(topology: str, converter: JsonDict, use_ngspice: bool = True, threads: int = 1) -> JsonDict:
     """Process a converter topology specification to designRequirements + operatingPoints.
     
     Generic endpoint that dispatches to the appropriate topology processor.
@@ -809,6 +1333,14 @@ def process_converter(topology: str, converter: JsonDict, use_ngspice: bool = Tr
         converter: JSON object — see AGENTS.md Section 5 for verified schemas.
                    DO NOT invent fields. Use exactly the schemas in AGENTS.md.
         use_ngspice: If True, uses ngspice simulation (bundled in wheel).
+        threads: Worker threads for the analytical path (use_ngspice=False)
+                 of a flyback, buck or boost base spec with several
+                 inputVoltage values: each input voltage is processed in
+                 parallel against the design requirements of the whole spec.
+                 1 (default) runs sequentially; 0 uses one per hardware
+                 thread. The result is the same either way. With
+                 use_ngspice=True, and for every other topology or an
+                 Advanced spec, the spec is processed sequentially.
     
     Returns:
         {"designRequirements": {...}, "operatingPoints": [...]}
@@ -844,7 +1376,12 @@ def design_magnetics_from_converter(
     max_results: int = 1,
     core_mode: str = "available cores",
     use_ngspice: bool = True,
-    weights: Optional[Dict[str, float]] = None
+    weights: Optional[Dict[str, float]] = None,
+    fast: bool = False,
+    progress_callback: Optional[Callable[[JsonDict], Optional[bool]]] = None,
+    cancellation_token: Optional["CancellationToken"] = None,
+    settings: Optional[JsonDict] = None,
+    interruptible: bool = False
 ) -> JsonDict:
     """Design magnetic components from a converter specification.
     
@@ -891,9 +1428,15 @@ def design_magnetics_from_converter(
         weights: Optional scoring weights. None = defaults.
                  Keys: "maximizeEfficiency", "minimizeCost", "minimizeDimensions", etc.
                  See AGENTS.md Section 7 for verified weight key names.
+        fast: Fast core-only adviser instead of the full winding+simulation one.
+        progress_callback: As in calculate_advised_magnetics (keyword is safe).
+        cancellation_token: As in calculate_advised_magnetics (keyword is safe).
+        settings: set_settings() dict for this call only (keyword is safe).
+        interruptible: As in calculate_advised_magnetics (keyword is safe).
     
     Returns:
         {"data": [{"mas": {...}, "scoring": float, "scoringPerFilter": {...}}, ...]}
+        With interruptible also "cancelled", "evaluatedCores", ...
         Access pattern: result["data"][0]["mas"]["magnetic"]["core"]["functionalDescription"]
     
     Example (≤50W offline flyback — Advanced schema):
@@ -930,6 +1473,37 @@ def design_magnetics_from_converter(
     ...
 
 
+def design_magnetics_from_converter_batch(
+    specs: List[Tuple[str, JsonDict]],
+    max_results: int = 1,
+    core_mode: str = "available cores",
+    use_ngspice: bool = True,
+    weights: Optional[Dict[str, float]] = None,
+    fast: bool = False,
+    threads: int = 0,
+    on_result: Optional[Callable[[JsonDict], None]] = None,
+    cancellation_token: Optional["CancellationToken"] = None,
+    settings: Optional[JsonDict] = None
+) -> List[JsonDict]:
+    """Run design_magnetics_from_converter over many specs in one call.
+
+    Same schemas and core_mode rules as design_magnetics_from_converter.
+    The specs are designed one after another (the advisers share MKF's
+    global state); threads only spreads the conversion of each item's
+    designs to dicts, and threads=0 uses one per hardware thread.
+
+    Returns:
+        One item per spec, in spec order:
+        {"index": int, "topologyName": str, "data": [...]}  or
+        {"index": int, "topologyName": str, "error": "Exception: ..."}
+        on_result, if given, is called with each item as it completes.
+        Once cancellation_token is cancelled, specs not yet started come
+        back as {"error": "Cancelled", "cancelled": True}.
+        settings, if given, applies to every spec and is undone at the end.
+    """
+    ...
+
+
 def process_flyback(flyback: JsonDict) -> Inputs:
     """Process Flyback converter specification to Inputs.
     ⚠️ See AGENTS.md Section 5 for the correct JSON schema.
@@ -0,0 +1,424 @@
+// Benchmarks for the binding layer, one or more per binding family, run
+// against a fixed set of reference specs so numbers are comparable release
+// to release. Built with -DBUILD_BENCHMARKS=ON; `cmake --build . --target
+// run_benchmarks` writes the results to benchmarks.json in the build tree.
+//
+// The benchmarks call the same C++ entry points the Python module exposes,
+// with an embedded interpreter holding the GIL: the adviser and converter
+// functions that take a progress callback release it themselves, exactly as
+// they do when called from Python.
+
+#include <benchmark/benchmark.h>
+#include <pybind11/embed.h>
+
+#include "common.h"
+#include "advisers.h"
+#include "converter.h"
+#include "core.h"
+#include "database.h"
+#include "losses.h"
+#include "simulation.h"
+#include "winding.h"
+#include "wire.h"
+
+namespace {
+
+using namespace PyMKF;
+
+// ─── Reference specs ────────────────────────────────────────────────────────
+// The inductor is the one the Python tests use (tests/conftest.py): 100 µH,
+// 10 A peak-to-peak triangular current at 100 kHz. The flyback and buck are
+// the converter endpoint test specs.
+
+const json referenceInductorInputs = json::parse(R"({
+    "designRequirements": {
+        "magnetizingInductance": {"nominal": 100e-6},
+        "turnsRatios": []
+    },
+    "operatingPoints": [{
+        "name": "Nominal",
+        "conditions": {"ambientTemperature": 25},
+        "excitationsPerWinding": [{
+            "frequency": 100000,
+            "current": {"waveform": {"data": [-5, 5, -5], "time": [0, 0.0000025, 0.00001]}}
+        }]
+    }]
+})");
+
+const json referenceFlyback = json::parse(R"({
+    "inputVoltage": {"minimum": 150, "maximum": 150},
+    "desiredInductance": 400e-6,
+    "desiredTurnsRatios": [6.14],
+    "desiredDutyCycle": [[0.45, 0.45]],
+    "maximumDutyCycle": 0.5,
+    "efficiency": 0.9,
+    "diodeVoltageDrop": 0.7,
+    "operatingPoints": [{
+        "outputVoltages": [20.0],
+        "outputCurrents": [1.5],
+        "switchingFrequency": 100000,
+        "ambientTemperature": 25
+    }]
+})");
+
+const json referenceBuck = json::parse(R"({
+    "inputVoltage": {"minimum": 12, "maximum": 12},
+    "desiredInductance": 10e-6,
+    "diodeVoltageDrop": 0.7,
+    "operatingPoints": [{
+        "outputVoltages": [5.0],
+        "outputCurrents": [2.0],
+        "switchingFrequency": 100000,
+        "ambientTemperature": 25
+    }]
+})");
+
+const json referenceModels = {{"coreLosses", "IGSE"}, {"reluctance", "ZHANG"}};
+const json referenceWeights = {{"COST", 1}, {"EFFICIENCY", 1}, {"DIMENSIONS", 1}};
+const char* referenceCoreMaterial = "3C95";
+const char* referenceCoreShape = "ETD 49/25/16";
+const char* referenceWire = "Round 0.5 - Grade 1";
+
+// The reference magnetic is the adviser's best design for the reference
+// inductor, computed once and shared by every benchmark that needs one.
+struct ReferenceDesign {
+    json inputs;
+    json operatingPoint;
+    json magnetic;
+    std::string error;
+};
+
+const ReferenceDesign& reference_design() {
+    static const ReferenceDesign design = [] {
+        ReferenceDesign result;
+        result.inputs = process_inputs(referenceInductorInputs);
+        if (result.inputs.contains("data")) {
+            result.error = "process_inputs failed: " + result.inputs["data"].dump();
+            return result;
+        }
+        result.operatingPoint = result.inputs["operatingPoints"][0];
+        auto advised = calculate_advised_magnetics(result.inputs, 1, "available cores");
+        if (!advised.contains("data") || !advised["data"].is_array() || advised["data"].empty()) {
+            result.error = "adviser returned no reference design: " + advised.dump().substr(0, 200);
+            return result;
+        }
+        result.magnetic = advised["data"][0]["mas"]["magnetic"];
+        return result;
+    }();
+    return design;
+}
+
+// Bindings report failures in the result rather than by throwing; a failed
+// call must not be timed as if it had done the work.
+bool failed(benchmark::State& state, const json& result) {
+    std::string message;
+    if (result.is_object() && result.contains("data") && result["data"].is_string() &&
+        result["data"].get<std::string>().starts_with("Exception")) {
+        message = result["data"];
+    }
+    else if (result.is_object() && result.contains("error")) {
+        message = result["error"].is_string() ? result["error"].get<std::string>() : result["error"].dump();
+    }
+    if (message.empty()) {
+        return false;
+    }
+    state.SkipWithError(message.c_str());
+    return true;
+}
+
+bool missing_reference_design(benchmark::State& state) {
+    auto& design = reference_design();
+    if (design.error.empty()) {
+        return false;
+    }
+    state.SkipWithError(design.error.c_str());
+    return true;
+}
+
+// ─── Databases ──────────────────────────────────────────────────────────────
+
+void BM_LoadDatabases(benchmark::State& state) {
+    for (auto _ : state) {
+        clear_databases();
+        benchmark::DoNotOptimize(load_core_materials(""));
+        benchmark::DoNotOptimize(load_core_shapes(""));
+        benchmark::DoNotOptimize(load_wires(""));
+    }
+}
+BENCHMARK(BM_LoadDatabases)->Unit(benchmark::kMillisecond);
+
+void BM_LoadCores(benchmark::State& state) {
+    bool includeToroids = OpenMagnetics::settings.get_use_toroidal_cores();
+    bool onlyInStock = OpenMagnetics::settings.get_use_only_cores_in_stock();
+    for (auto _ : state) {
+        auto result = load_cores(nullptr, includeToroids, onlyInStock);
+        if (failed(state, result)) {
+            break;
+        }
+        state.counters["cores"] = result.value("count", 0);
+    }
+}
+BENCHMARK(BM_LoadCores)->Unit(benchmark::kMillisecond);
+
+void BM_FindCoreMaterialByName(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = find_core_material_by_name(referenceCoreMaterial);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FindCoreMaterialByName);
+
+void BM_FindCoreShapeByName(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = find_core_shape_by_name(referenceCoreShape);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FindCoreShapeByName);
+
+void BM_FindWireByName(benchmark::State& state) {
+    for (auto _ : state) {
+        auto result = find_wire_by_name(referenceWire);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FindWireByName);
+
+// ─── Losses, winding and simulation ─────────────────────────────────────────
+
+void BM_CalculateCoreLosses(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& design = reference_design();
+    for (auto _ : state) {
+        auto result = calculate_core_losses(design.magnetic["core"], design.magnetic["coil"], design.inputs, referenceModels);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_CalculateCoreLosses)->Unit(benchmark::kMicrosecond);
+
+void BM_CalculateWindingLosses(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& design = reference_design();
+    double temperature = design.operatingPoint["conditions"]["ambientTemperature"];
+    for (auto _ : state) {
+        auto result = calculate_winding_losses(design.magnetic, design.operatingPoint, temperature);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_CalculateWindingLosses)->Unit(benchmark::kMicrosecond);
+
+void BM_Wind(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& coil = reference_design().magnetic["coil"];
+    json proportions = json::array();
+    json pattern = json::array();
+    for (size_t windingIndex = 0; windingIndex < coil["functionalDescription"].size(); ++windingIndex) {
+        proportions.push_back(1.0 / coil["functionalDescription"].size());
+        pattern.push_back(windingIndex);
+    }
+    for (auto _ : state) {
+        auto result = wind(coil, 1, proportions, pattern, json::array());
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Wind)->Unit(benchmark::kMillisecond);
+
+void BM_Simulate(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& design = reference_design();
+    for (auto _ : state) {
+        auto result = simulate(design.inputs, design.magnetic, referenceModels);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_Simulate)->Unit(benchmark::kMillisecond);
+
+// ─── Sweeps ─────────────────────────────────────────────────────────────────
+// 200 points each; the argument is the `threads` parameter (0 = one per
+// hardware thread), so serial and chunked timings are tracked side by side.
+
+constexpr size_t sweepPoints = 200;
+
+template <typename Sweep>
+void run_sweep(benchmark::State& state, Sweep&& sweep) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    int threads = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        json result = sweep(reference_design(), threads);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * sweepPoints);
+}
+
+#define PYMKF_SWEEP_BENCHMARK(name) BENCHMARK(name)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)
+
+void BM_SweepImpedanceOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_impedance_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, "log", "Impedance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepImpedanceOverFrequency);
+
+void BM_SweepDifferentialModeImpedanceOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_differential_mode_impedance_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, "log", "Impedance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepDifferentialModeImpedanceOverFrequency);
+
+void BM_SweepQFactorOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_q_factor_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, "log", "Q factor", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepQFactorOverFrequency);
+
+void BM_SweepWindingResistanceOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_winding_resistance_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, 0, 25, "log", "Resistance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepWindingResistanceOverFrequency);
+
+void BM_SweepResistanceOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_resistance_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, 25, "log", "Resistance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepResistanceOverFrequency);
+
+void BM_SweepMagnetizingInductanceOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_magnetizing_inductance_over_frequency(design.magnetic, 1e3, 1e7, sweepPoints, 25, "log", "Inductance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepMagnetizingInductanceOverFrequency);
+
+void BM_SweepMagnetizingInductanceOverTemperature(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_magnetizing_inductance_over_temperature(design.magnetic, -40, 150, sweepPoints, 100000, "linear", "Inductance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepMagnetizingInductanceOverTemperature);
+
+void BM_SweepMagnetizingInductanceOverDcBias(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_magnetizing_inductance_over_dc_bias(design.magnetic, 0, 10, sweepPoints, 25, "linear", "Inductance", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepMagnetizingInductanceOverDcBias);
+
+void BM_SweepCoreLossesOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_core_losses_over_frequency(design.magnetic, design.operatingPoint, 2e4, 5e5, sweepPoints, 25, "log", "Core losses", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepCoreLossesOverFrequency);
+
+void BM_SweepWindingLossesOverFrequency(benchmark::State& state) {
+    run_sweep(state, [](const ReferenceDesign& design, int threads) {
+        return sweep_winding_losses_over_frequency(design.magnetic, design.operatingPoint, 2e4, 5e5, sweepPoints, 25, "log", "Winding losses", threads);
+    });
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepWindingLossesOverFrequency);
+
+void BM_SweepGrid(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& design = reference_design();
+    std::vector<double> temperatures{25, 50, 75, 100};
+    std::vector<double> frequencies;
+    for (size_t index = 0; index < sweepPoints / temperatures.size(); ++index) {
+        frequencies.push_back(2e4 + index * 1e4);
+    }
+    py::list axes;
+    axes.append(py::make_tuple("temperature", temperatures));
+    axes.append(py::make_tuple("frequency", frequencies));
+    int threads = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto result = sweep_grid(design.magnetic, design.operatingPoint, axes, referenceModels, threads);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * temperatures.size() * frequencies.size());
+}
+PYMKF_SWEEP_BENCHMARK(BM_SweepGrid);
+
+// ─── Advisers and converter design ──────────────────────────────────────────
+// Seconds per call, so a handful of iterations is enough to track.
+
+void BM_CalculateAdvisedCores(benchmark::State& state) {
+    if (missing_reference_design(state)) {
+        return;
+    }
+    auto& design = reference_design();
+    int threads = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        auto result = calculate_advised_cores(design.inputs, referenceWeights, 10, "available cores", threads);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_CalculateAdvisedCores)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+void BM_DesignMagneticsFromConverter(benchmark::State& state, const char* topology, const json* converter, bool fast) {
+    for (auto _ : state) {
+        auto result = design_magnetics_from_converter(topology, *converter, 5, "available cores", false, referenceWeights, fast);
+        if (failed(state, result)) {
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK_CAPTURE(BM_DesignMagneticsFromConverter, flyback, "flyback", &referenceFlyback, false)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_CAPTURE(BM_DesignMagneticsFromConverter, flyback_fast, "flyback", &referenceFlyback, true)->Unit(benchmark::kMillisecond)->Iterations(3);
+BENCHMARK_CAPTURE(BM_DesignMagneticsFromConverter, buck_fast, "buck", &referenceBuck, true)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+} // namespace
+
+int main(int argc, char** argv) {
+    py::scoped_interpreter interpreter;
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
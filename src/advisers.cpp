@@ -1,101 +1,445 @@
 #include "advisers.h"
+#include "concurrency.h"
+#include "core_index.h"
+#include "profiling.h"
+#include "result_handles.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <numeric>
 
 namespace PyMKF {
 
-json calculate_advised_cores(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson) {
-    try {
-        OpenMagnetics::Inputs inputs(inputsJson);
-        OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
-        from_json(coreModeJson, coreMode);
-        std::map<std::string, double> weightsKeysJson = weightsJson;
-        std::map<OpenMagnetics::CoreAdviser::CoreAdviserFilters, double> weights;
-
-        weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::COST] = 1;
-        weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::EFFICIENCY] = 1;
-        weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::DIMENSIONS] = 1;
-
-        for (auto const& [filterName, weight] : weightsKeysJson) {
-            OpenMagnetics::CoreAdviser::CoreAdviserFilters filter;
-            OpenMagnetics::from_json(filterName, filter);
-            weights[filter] = weight;
+// Per-filter scorings of the design `name`, or null when the adviser kept none.
+template <typename ScoringsPerFilter>
+static json filter_scorings_json(const ScoringsPerFilter& scoringsPerFilter, const std::string& name) {
+    auto filterScoringsIt = scoringsPerFilter.find(name);
+    if (filterScoringsIt == scoringsPerFilter.end()) {
+        return nullptr;
+    }
+    json filterScorings;
+    for (auto& [filter, filterScore] : filterScoringsIt->second) {
+        filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
+    }
+    return filterScorings;
+}
+
+// Best-first order of adviser results: a stable sort on scoring, so it is
+// identical for every thread count and ties keep the adviser's order.
+template <typename AdvisedMagnetics>
+static std::vector<size_t> ranked_order(const AdvisedMagnetics& masMagnetics) {
+    std::vector<size_t> order(masMagnetics.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return masMagnetics[a].second > masMagnetics[b].second;
+    });
+    return order;
+}
+
+// Serialise adviser output into the {"data": [...]} envelope the adviser
+// bindings return, ranked best-first. Candidate scoring itself happens inside
+// MKF and is normalised across the whole candidate set, so it cannot be split
+// across threads here without changing the ranking; what we CAN spread is the
+// per-candidate to_json() of full Mas objects, which dominates this step for
+// large result sets. `conversionThreads` == 1 keeps everything on the calling
+// thread.
+template <typename AdvisedMagnetics, typename ScoringsPerFilter>
+static json build_advised_results(const AdvisedMagnetics& masMagnetics, const ScoringsPerFilter& scoringsPerFilter, int conversionThreads) {
+    std::vector<json> items(masMagnetics.size());
+    parallel_for(items.size(), resolve_thread_count(conversionThreads, items.size()), [&](size_t index) {
+        auto& [masMagnetic, scoring] = masMagnetics[index];
+        std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
+        json result;
+        json masJson;
+        to_json(masJson, masMagnetic);
+        result["mas"] = masJson;
+        result["scoring"] = scoring;
+        auto filterScorings = filter_scorings_json(scoringsPerFilter, name);
+        if (!filterScorings.is_null()) {
+            result["scoringPerFilter"] = filterScorings;
         }
+        items[index] = std::move(result);
+    });
 
-        OpenMagnetics::CoreAdviser coreAdviser;
-        coreAdviser.set_mode(coreMode);
-        auto masMagnetics = coreAdviser.get_advised_core(inputs, weights, maximumNumberResults);
+    json results = json();
+    results["data"] = json::array();
+    for (size_t index : ranked_order(masMagnetics)) {
+        results["data"].push_back(std::move(items[index]));
+    }
+    return results;
+}
 
-        auto scoringsPerFilter = coreAdviser.get_scorings();
+// Rows of coreDatabase that survive `prefilterJson` (see core_index.h), or
+// nullopt when no pre-filter was requested. Loads the core database first so
+// the index covers what the adviser would otherwise have loaded lazily.
+static std::optional<std::vector<size_t>> prefiltered_core_rows(const json& prefilterJson) {
+    if (prefilterJson.is_null()) {
+        return std::nullopt;
+    }
+    load_missing_databases(true);
+    return ensure_core_feature_index().range_scan(parse_core_index_ranges(prefilterJson));
+}
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
-                json filterScorings;
-                for (auto& [filter, filterScore] : scoringsPerFilter[name]) {
-                    filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
-                }
-                result["scoringPerFilter"] = filterScorings;
+// Cores handed to the adviser per step of a stepwise search. Small enough
+// that a step ends well inside an interactive budget, large enough that the
+// adviser's per-call setup is amortised.
+constexpr size_t defaultSearchBatchSize = 64;
+
+// First screening step of a search under a time budget: just enough cores to
+// measure what one costs, so that the later steps can be sized to the budget.
+constexpr size_t budgetProbeBatchSize = 8;
+
+static std::string advised_reference(const OpenMagnetics::Mas& masMagnetic) {
+    auto manufacturerInfo = masMagnetic.get_magnetic().get_manufacturer_info();
+    if (!manufacturerInfo || !manufacturerInfo->get_reference()) {
+        return "";
+    }
+    return manufacturerInfo->get_reference().value();
+}
+
+// The adviser only exposes a candidate's score once it has been wound and
+// evaluated, so there is no optimistic bound to prune on: every core of a
+// started step is designed and scored, and only the budget, the evaluation cap
+// and cancellation end the search early. The volume ordering is what lets a
+// truncated search still return compact designs.
+MagneticSearchResult stepwise_magnetic_search(const MagneticSearchOptions& options,
+                                              const std::function<AdvisedMagnetics(OpenMagnetics::MagneticAdviser&)>& advise) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed_ms = [&]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    load_missing_databases(true);
+    auto& index = ensure_core_feature_index();
+    const double* volumes = index.column(CoreIndexColumn::EFFECTIVE_VOLUME);
+    std::vector<size_t> order;
+    if (options.candidateRows) {
+        order = *options.candidateRows;
+    }
+    else {
+        order.resize(index.size());
+        std::iota(order.begin(), order.end(), 0);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        // NaN (unknown volume) sorts last.
+        return !std::isnan(volumes[a]) && (std::isnan(volumes[b]) || volumes[a] < volumes[b]);
+    });
+
+    MagneticSearchResult result;
+    result.totalCores = order.size();
+    const size_t maximumResults = static_cast<size_t>(std::max(options.maximumNumberResults, 0));
+    const size_t limit = options.maxEvaluations > 0 ? std::min(options.maxEvaluations, order.size()) : order.size();
+    size_t batchSize = options.batchSize > 0 ? options.batchSize : defaultSearchBatchSize;
+    if (options.maximumSteps > 0) {
+        batchSize = std::max(batchSize, (limit + options.maximumSteps - 1) / options.maximumSteps);
+    }
+    bool rankFinalists = options.rankFinalists;
+    if (rankFinalists) {
+        // Each step must keep fewer winners than it was given, or the
+        // ranking rounds would never shrink.
+        batchSize = std::max(batchSize, 4 * maximumResults);
+    }
+
+    auto better = [&](const auto& a, const auto& b) {
+        return options.lowerIsBetter ? a.second < b.second : a.second > b.second;
+    };
+    auto stop_requested = [&]() {
+        if (options.reporter && options.reporter->cancelled()) {
+            result.cancelled = true;
+            return true;
+        }
+        return options.timeBudgetMs > 0 && elapsed_ms() >= options.timeBudgetMs;
+    };
+    auto report = [&](const char* phase, size_t evaluated, size_t total, bool force) {
+        if (!options.reporter) {
+            return;
+        }
+        SearchProgress progress;
+        progress.phase = phase;
+        progress.evaluated = evaluated;
+        progress.total = total;
+        if (!result.best.empty()) {
+            progress.bestScore = result.best.front().second;
+        }
+        progress.elapsedMs = elapsed_ms();
+        options.reporter->report(progress, force);
+    };
+
+    // Under a time budget (and without a step bound) the first step is a
+    // probe and later steps are sized from the measured cost per core, so a
+    // step that would clearly run past the budget never starts.
+    auto screening_step_size = [&]() -> size_t {
+        if (options.timeBudgetMs <= 0 || options.maximumSteps > 0) {
+            return batchSize;
+        }
+        if (result.evaluatedCores == 0) {
+            return std::min(batchSize, budgetProbeBatchSize);
+        }
+        double perCoreMs = elapsed_ms() / static_cast<double>(result.evaluatedCores);
+        double remainingMs = options.timeBudgetMs - elapsed_ms();
+        if (perCoreMs <= 0) {
+            return batchSize;
+        }
+        return std::clamp<size_t>(static_cast<size_t>(remainingMs / perCoreMs), 1, batchSize);
+    };
+
+    // Winners are carried into the ranking rounds by their core's row.
+    std::map<std::string, size_t> rowsByCoreName;
+    bool finalistsResolved = true;
+    if (rankFinalists) {
+        for (size_t row : order) {
+            rowsByCoreName[index.name(row)] = row;
+        }
+    }
+
+    // One adviser call over `rows`. Its results replace earlier ones for the
+    // same design, so a finalist is never listed twice; returns the rows of
+    // the winning cores.
+    auto run_step = [&](const std::vector<size_t>& rows) {
+        PYMKF_PROFILE_SCOPE("MagneticAdviser::step");
+        PYMKF_PROFILE_COUNT("adviserCoresEvaluated", rows.size());
+        AdvisedMagnetics stepResults;
+        {
+            ScopedCoreDatabaseSubset coreSubset(rows);
+            OpenMagnetics::MagneticAdviser magneticAdviser;
+            stepResults = advise(magneticAdviser);
+            for (auto& [name, filterScorings] : magneticAdviser.get_scorings()) {
+                result.scorings[name] = filterScorings;
+            }
+        }
+        std::vector<size_t> winners;
+        for (auto& candidate : stepResults) {
+            auto coreName = candidate.first.get_magnetic().get_core().get_name();
+            auto row = coreName ? rowsByCoreName.find(*coreName) : rowsByCoreName.end();
+            if (row == rowsByCoreName.end()) {
+                finalistsResolved = false;
             }
-            results["data"].push_back(result);
+            else if (std::find(winners.begin(), winners.end(), row->second) == winners.end()) {
+                winners.push_back(row->second);
+            }
+            auto reference = advised_reference(candidate.first);
+            if (!reference.empty()) {
+                std::erase_if(result.best, [&](const auto& kept) { return advised_reference(kept.first) == reference; });
+            }
+            result.best.push_back(std::move(candidate));
+        }
+        std::stable_sort(result.best.begin(), result.best.end(), better);
+        if (result.best.size() > maximumResults) {
+            result.best.resize(maximumResults);
         }
+        return winners;
+    };
 
-        sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
-            return b1["scoring"] > b2["scoring"];
-        });
+    std::vector<size_t> finalists;
+    bool stopped = false;
+    size_t screeningSteps = 0;
+    while (result.evaluatedCores < limit) {
+        if (stop_requested()) {
+            stopped = true;
+            break;
+        }
+        size_t batchEnd = std::min(limit, result.evaluatedCores + screening_step_size());
+        std::vector<size_t> batch(order.begin() + result.evaluatedCores, order.begin() + batchEnd);
+        result.evaluatedCores = batchEnd;
+        auto winners = run_step(batch);
+        ++screeningSteps;
+        finalists.insert(finalists.end(), winners.begin(), winners.end());
+        report("screening", result.evaluatedCores, limit, false);
+    }
 
-        OpenMagnetics::settings.reset();
+    // A single screening step is already one exact ranking. Otherwise the
+    // step winners play off; once the budget is spent, whoever is still in
+    // the running is re-scored together in one last call, so the returned
+    // scores always come from a single normalisation. That call may run past
+    // the budget; a cancelled search returns what it has.
+    rankFinalists = rankFinalists && finalistsResolved && !result.cancelled && screeningSteps > 1;
+    while (rankFinalists && !finalists.empty()) {
+        if (stopped) {
+            if (!result.cancelled) {
+                result.best.clear();
+                run_step(finalists);
+                report("ranking", finalists.size(), finalists.size(), false);
+            }
+            break;
+        }
+        std::vector<size_t> pending = std::move(finalists);
+        finalists.clear();
+        bool finalRound = pending.size() <= batchSize;
+        for (size_t begin = 0; begin < pending.size(); begin += batchSize) {
+            if (stop_requested()) {
+                stopped = true;
+                finalists.insert(finalists.end(), pending.begin() + begin, pending.end());
+                break;
+            }
+            std::vector<size_t> chunk(pending.begin() + begin, pending.begin() + std::min(pending.size(), begin + batchSize));
+            if (finalRound) {
+                result.best.clear();
+            }
+            auto winners = run_step(chunk);
+            finalists.insert(finalists.end(), winners.begin(), winners.end());
+            report("ranking", std::min(pending.size(), begin + batchSize), pending.size(), false);
+        }
+        if (stopped) {
+            continue;
+        }
+        if (finalRound) {
+            break;
+        }
+        if (finalists.size() >= pending.size()) {
+            // No step dropped anyone: rank them all in one call.
+            result.best.clear();
+            run_step(finalists);
+            break;
+        }
+    }
 
-        return results;
+    result.truncated = result.evaluatedCores < result.totalCores;
+    result.elapsedMs = elapsed_ms();
+    report("done", result.evaluatedCores, limit, true);
+    return result;
+}
+
+void add_search_statistics(json& results, const MagneticSearchResult& search, const ProgressReporter* reporter) {
+    results["truncated"] = search.truncated;
+    results["cancelled"] = search.cancelled;
+    results["evaluatedCores"] = search.evaluatedCores;
+    results["totalCores"] = search.totalCores;
+    results["elapsedMs"] = search.elapsedMs;
+    if (reporter && !reporter->callback_error().empty()) {
+        results["progressCallbackError"] = reporter->callback_error();
     }
-    catch (const std::exception &exc) {
-        json exception;
-        exception["data"] = "Exception: " + std::string{exc.what()};
-        return exception;
+}
+
+bool start_single_search(ProgressReporter* reporter) {
+    if (!reporter) {
+        return true;
     }
+    if (reporter->cancelled()) {
+        return false;
+    }
+    SearchProgress progress;
+    progress.phase = "search";
+    reporter->report(progress, true);
+    return true;
 }
 
-json calculate_advised_magnetics(json inputsJson, int maximumNumberResults, json coreModeJson) {
-    try {
-        OpenMagnetics::Inputs inputs(inputsJson);
-        OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
-        from_json(coreModeJson, coreMode);
+void finish_single_search(ProgressReporter* reporter, bool started, size_t totalCores, std::optional<double> bestScore,
+                          double elapsedMs, json& results) {
+    if (!reporter || !reporter->active()) {
+        return;
+    }
+    if (started) {
+        SearchProgress progress;
+        progress.phase = "done";
+        progress.evaluated = totalCores;
+        progress.total = totalCores;
+        progress.bestScore = bestScore;
+        progress.elapsedMs = elapsedMs;
+        reporter->report(progress, true);
+    }
+    results["cancelled"] = !started;
+    if (!reporter->callback_error().empty()) {
+        results["progressCallbackError"] = reporter->callback_error();
+    }
+}
 
-        OpenMagnetics::MagneticAdviser magneticAdviser;
-        magneticAdviser.set_core_mode(coreMode);
-        auto masMagnetics = magneticAdviser.get_advised_magnetic(inputs, maximumNumberResults);
+// The fast adviser ranks by total losses (lower is better) and reports no
+// per-filter scorings.
+template <typename AdvisedMagnetics>
+static json build_fast_advised_results(const AdvisedMagnetics& masMagnetics) {
+    json results = json();
+    results["data"] = json::array();
+    for (auto& [masMagnetic, scoring] : masMagnetics) {
+        json result;
+        json masJson;
+        to_json(masJson, masMagnetic);
+        result["mas"] = masJson;
+        result["scoring"] = scoring;
+        results["data"].push_back(result);
+    }
+    return results;
+}
 
-        auto scoringsPerFilter = magneticAdviser.get_scorings();
+// ─── Adviser calls ──────────────────────────────────────────────────────────
+// Each advise_* function runs the adviser as the binding of the same name does
+// and returns what it produced, unconverted, so the bindings can hand it to
+// Python as JSON or as MasHandles. They throw on failure and are called
+// without the GIL.
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
-                json filterScorings;
-                for (auto& [filter, filterScore] : scoringsPerFilter[name]) {
-                    filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
-                }
-                result["scoringPerFilter"] = filterScorings;
-            }
-            results["data"].push_back(result);
-        }
+using AdvisedCores = std::remove_cvref_t<decltype(std::declval<OpenMagnetics::CoreAdviser&>().get_advised_core(
+    std::declval<OpenMagnetics::Inputs&>(), std::declval<std::map<OpenMagnetics::CoreAdviser::CoreAdviserFilters, double>&>(), 0))>;
+using CoreScorings = std::remove_cvref_t<decltype(std::declval<OpenMagnetics::CoreAdviser&>().get_scorings())>;
 
-        sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
-            return b1["scoring"] > b2["scoring"];
-        });
+// `fast` results are ordered by ascending losses and carry no per-filter
+// scorings; the others are ranked by descending scoring. `statistics` holds
+// the stepwise search fields if the search ran stepwise, or "cancelled" for
+// a plain search with a callback or token.
+template <typename Advised, typename Scorings>
+struct AdviserOutcome {
+    Advised masMagnetics;
+    Scorings scorings;
+    bool fast = false;
+    json statistics = json::object();
+};
 
-        return results;
+using CoreAdviserOutcome = AdviserOutcome<AdvisedCores, CoreScorings>;
+using MagneticAdviserOutcome = AdviserOutcome<AdvisedMagnetics, MagneticScorings>;
+
+// Runs `advise` as one plain adviser call (see start_single_search), filling
+// outcome.masMagnetics.
+template <typename Outcome, typename Advise>
+static void single_search(Outcome& outcome, ProgressReporter& reporter, Advise&& advise) {
+    auto start = std::chrono::steady_clock::now();
+    bool started = start_single_search(&reporter);
+    if (started) {
+        advise();
+    }
+    std::optional<double> bestScore;
+    if (!outcome.masMagnetics.empty()) {
+        bestScore = outcome.fast ? outcome.masMagnetics.front().second : outcome.masMagnetics[ranked_order(outcome.masMagnetics).front()].second;
+    }
+    finish_single_search(&reporter, started, OpenMagnetics::coreDatabase.size(), bestScore,
+                         std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(), outcome.statistics);
+}
+
+template <typename Outcome>
+static json outcome_json(const Outcome& outcome, int conversionThreads) {
+    json results = outcome.fast ? build_fast_advised_results(outcome.masMagnetics)
+                                : build_advised_results(outcome.masMagnetics, outcome.scorings, conversionThreads);
+    results.update(outcome.statistics);
+    return results;
+}
+
+// Same envelope as outcome_json, with a MasHandle per result. Needs the GIL.
+template <typename Outcome>
+static py::dict outcome_handles(Outcome&& outcome) {
+    std::vector<size_t> order(outcome.masMagnetics.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!outcome.fast) {
+        order = ranked_order(outcome.masMagnetics);
+    }
+    py::list data;
+    for (size_t index : order) {
+        auto& [masMagnetic, scoring] = outcome.masMagnetics[index];
+        json filterScorings = outcome.fast ? json() : filter_scorings_json(outcome.scorings, advised_reference(masMagnetic));
+        data.append(MasHandle(std::move(masMagnetic), scoring, std::move(filterScorings)));
+    }
+    py::dict results;
+    results["data"] = data;
+    for (auto& [key, value] : outcome.statistics.items()) {
+        results[py::str(key)] = py::cast(value);
+    }
+    return results;
+}
+
+template <typename Advise>
+static json advised_json(Advise&& advise, int conversionThreads) {
+    try {
+        return outcome_json(advise(), conversionThreads);
     }
     catch (const std::exception &exc) {
         json exception;
@@ -104,94 +448,263 @@ json calculate_advised_magnetics(json inputsJson, int maximumNumberResults, json
     }
 }
 
-json calculate_advised_magnetics_with_filters(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson) {
+// Runs `advise` with the GIL released and returns its outcome as handles, or
+// the same {"data": "Exception: ..."} as the JSON mode on failure.
+template <typename Advise>
+static py::object advised_handles(Advise&& advise) {
+    std::optional<decltype(advise())> outcome;
+    std::string error;
+    {
+        py::gil_scoped_release release;
+        try {
+            outcome.emplace(advise());
+        }
+        catch (const std::exception &exc) {
+            error = exc.what();
+        }
+    }
+    if (!outcome) {
+        return py::cast(json{{"data", "Exception: " + error}});
+    }
+    return outcome_handles(std::move(*outcome));
+}
+
+static CoreAdviserOutcome advise_cores(const json& inputsJson, const json& weightsJson, int maximumNumberResults, const json& coreModeJson, const json& prefilterJson,
+                                       const json& settingsJson) {
+    PYMKF_PROFILE_SCOPE("CoreAdviser");
+    StateWriteLock stateLock;
+    ScopedSettings settingsScope(settingsJson);
+    OpenMagnetics::Inputs inputs(inputsJson);
+    OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
+    from_json(coreModeJson, coreMode);
+    std::map<std::string, double> weightsKeysJson = weightsJson;
+    std::map<OpenMagnetics::CoreAdviser::CoreAdviserFilters, double> weights;
+
+    weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::COST] = 1;
+    weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::EFFICIENCY] = 1;
+    weights[OpenMagnetics::CoreAdviser::CoreAdviserFilters::DIMENSIONS] = 1;
+
+    for (auto const& [filterName, weight] : weightsKeysJson) {
+        OpenMagnetics::CoreAdviser::CoreAdviserFilters filter;
+        OpenMagnetics::from_json(filterName, filter);
+        weights[filter] = weight;
+    }
+
+    // An empty coreDatabase would make the adviser reload the full
+    // catalogue, so a pre-filter that rejects everything returns here.
+    CoreAdviserOutcome outcome;
+    auto rows = prefiltered_core_rows(prefilterJson);
+    if (rows && rows->empty()) {
+        return outcome;
+    }
+    std::optional<ScopedCoreDatabaseSubset> coreSubset;
+    if (rows) {
+        coreSubset.emplace(*rows);
+    }
+
+    OpenMagnetics::CoreAdviser coreAdviser;
+    coreAdviser.set_mode(coreMode);
+    outcome.masMagnetics = coreAdviser.get_advised_core(inputs, weights, maximumNumberResults);
+    outcome.scorings = coreAdviser.get_scorings();
+    return outcome;
+}
+
+static MagneticAdviserOutcome advise_magnetics(const json& inputsJson, int maximumNumberResults, const json& coreModeJson, const json& prefilterJson,
+                                               const json& settingsJson, bool interruptible, ProgressReporter& reporter) {
+    PYMKF_PROFILE_SCOPE("MagneticAdviser");
+    StateWriteLock stateLock;
+    ScopedSettings settingsScope(settingsJson);
+    OpenMagnetics::Inputs inputs(inputsJson);
+    OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
+    from_json(coreModeJson, coreMode);
+
+    MagneticAdviserOutcome outcome;
+    auto rows = prefiltered_core_rows(prefilterJson);
+    if (rows && rows->empty()) {
+        return outcome;
+    }
+
+    if (interruptible) {
+        MagneticSearchOptions options;
+        options.maximumNumberResults = maximumNumberResults;
+        options.rankFinalists = true;
+        options.candidateRows = rows;
+        options.reporter = &reporter;
+        auto search = stepwise_magnetic_search(options, [&](OpenMagnetics::MagneticAdviser& magneticAdviser) {
+            magneticAdviser.set_core_mode(coreMode);
+            return magneticAdviser.get_advised_magnetic(inputs, maximumNumberResults);
+        });
+        add_search_statistics(outcome.statistics, search, &reporter);
+        outcome.masMagnetics = std::move(search.best);
+        outcome.scorings = std::move(search.scorings);
+        return outcome;
+    }
+
+    std::optional<ScopedCoreDatabaseSubset> coreSubset;
+    if (rows) {
+        coreSubset.emplace(*rows);
+    }
+
+    single_search(outcome, reporter, [&] {
+        OpenMagnetics::MagneticAdviser magneticAdviser;
+        magneticAdviser.set_core_mode(coreMode);
+        outcome.masMagnetics = magneticAdviser.get_advised_magnetic(inputs, maximumNumberResults);
+        outcome.scorings = magneticAdviser.get_scorings();
+    });
+    return outcome;
+}
+
+static MagneticAdviserOutcome advise_magnetics_with_filters(const json& inputsJson, const json& filterFlowJson, int maximumNumberResults, const json& coreModeJson,
+                                                            double timeBudgetMs, size_t maxEvaluations, const json& settingsJson, bool interruptible,
+                                                            ProgressReporter& reporter) {
     // FAST custom design driven by a CALLER-SUPPLIED filter flow: strictlyRequired
     // filters (e.g. DC/EFFECTIVE_CURRENT_DENSITY, which the default custom flow
     // omits) DROP any wound candidate that fails them, so designed windings are
     // current-density gated while the fast path's loss ranking + core search are
     // preserved. Exposes MagneticAdviser::get_advised_magnetic_fast(inputs, flow, n).
-    try {
-        OpenMagnetics::Inputs inputs(inputsJson);
-        OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
-        from_json(coreModeJson, coreMode);
+    PYMKF_PROFILE_SCOPE("MagneticAdviser::fast");
+    StateWriteLock stateLock;
+    ScopedSettings settingsScope(settingsJson);
+    OpenMagnetics::Inputs inputs(inputsJson);
+    OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
+    from_json(coreModeJson, coreMode);
 
-        std::vector<OpenMagnetics::MagneticFilterOperation> filterFlow;
-        for (auto filterJson : filterFlowJson) {
-            OpenMagnetics::MagneticFilterOperation filter(filterJson);
-            filterFlow.push_back(filter);
-        }
+    std::vector<OpenMagnetics::MagneticFilterOperation> filterFlow;
+    for (auto filterJson : filterFlowJson) {
+        OpenMagnetics::MagneticFilterOperation filter(filterJson);
+        filterFlow.push_back(filter);
+    }
 
+    MagneticAdviserOutcome outcome;
+    if (timeBudgetMs > 0 || maxEvaluations > 0 || interruptible) {
+        MagneticSearchOptions options;
+        options.maximumNumberResults = maximumNumberResults;
+        options.timeBudgetMs = timeBudgetMs;
+        options.maxEvaluations = maxEvaluations;
+        // The filter flow normalises its scores within each call.
+        options.rankFinalists = true;
+        options.reporter = &reporter;
+        auto search = stepwise_magnetic_search(options, [&](OpenMagnetics::MagneticAdviser& magneticAdviser) {
+            magneticAdviser.set_core_mode(coreMode);
+            return magneticAdviser.get_advised_magnetic_fast(inputs, filterFlow, maximumNumberResults);
+        });
+        add_search_statistics(outcome.statistics, search, &reporter);
+        outcome.masMagnetics = std::move(search.best);
+        outcome.scorings = std::move(search.scorings);
+        return outcome;
+    }
+
+    single_search(outcome, reporter, [&] {
         OpenMagnetics::MagneticAdviser magneticAdviser;
         magneticAdviser.set_core_mode(coreMode);
-        auto masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, filterFlow, maximumNumberResults);
-
-        auto scoringsPerFilter = magneticAdviser.get_scorings();
+        outcome.masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, filterFlow, maximumNumberResults);
+        outcome.scorings = magneticAdviser.get_scorings();
+    });
+    return outcome;
+}
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
-                json filterScorings;
-                for (auto& [filter, filterScore] : scoringsPerFilter[name]) {
-                    filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
-                }
-                result["scoringPerFilter"] = filterScorings;
-            }
-            results["data"].push_back(result);
-        }
+static MagneticAdviserOutcome advise_magnetics_fast(const json& inputsJson, int maximumNumberResults, const json& coreModeJson,
+                                                    double timeBudgetMs, size_t maxEvaluations, const json& settingsJson, bool interruptible,
+                                                    ProgressReporter& reporter) {
+    PYMKF_PROFILE_SCOPE("MagneticAdviser::fast");
+    StateWriteLock stateLock;
+    ScopedSettings settingsScope(settingsJson);
+    OpenMagnetics::Inputs inputs(inputsJson);
+    OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
+    from_json(coreModeJson, coreMode);
 
-        sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
-            return b1["scoring"] > b2["scoring"];
+    MagneticAdviserOutcome outcome;
+    outcome.fast = true;
+    if (timeBudgetMs > 0 || maxEvaluations > 0 || interruptible) {
+        MagneticSearchOptions options;
+        options.maximumNumberResults = maximumNumberResults;
+        options.timeBudgetMs = timeBudgetMs;
+        options.maxEvaluations = maxEvaluations;
+        options.lowerIsBetter = true;
+        options.reporter = &reporter;
+        auto search = stepwise_magnetic_search(options, [&](OpenMagnetics::MagneticAdviser& magneticAdviser) {
+            magneticAdviser.set_core_mode(coreMode);
+            return magneticAdviser.get_advised_magnetic_fast(inputs, maximumNumberResults);
         });
-
-        return results;
-    }
-    catch (const std::exception &exc) {
-        json exception;
-        exception["data"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        add_search_statistics(outcome.statistics, search, &reporter);
+        outcome.masMagnetics = std::move(search.best);
+        return outcome;
     }
-}
-
-json calculate_advised_magnetics_fast(json inputsJson, int maximumNumberResults, json coreModeJson) {
-    try {
-        OpenMagnetics::Inputs inputs(inputsJson);
-        OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
-        from_json(coreModeJson, coreMode);
 
+    single_search(outcome, reporter, [&] {
         OpenMagnetics::MagneticAdviser magneticAdviser;
         magneticAdviser.set_core_mode(coreMode);
-        auto masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, maximumNumberResults);
+        outcome.masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, maximumNumberResults);
+    });
+    return outcome;
+}
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            results["data"].push_back(result);
-        }
+json calculate_advised_cores(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson, int conversionThreads, json prefilterJson, json settingsJson) {
+    return advised_json([&] { return advise_cores(inputsJson, weightsJson, maximumNumberResults, coreModeJson, prefilterJson, settingsJson); }, conversionThreads);
+}
 
-        return results;
-    }
-    catch (const std::exception &exc) {
-        json exception;
-        exception["data"] = "Exception: " + std::string{exc.what()};
-        return exception;
-    }
+json calculate_advised_magnetics(json inputsJson, int maximumNumberResults, json coreModeJson, int conversionThreads, json prefilterJson,
+                                 py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                 bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    py::gil_scoped_release release;
+    return advised_json([&] { return advise_magnetics(inputsJson, maximumNumberResults, coreModeJson, prefilterJson, settingsJson, interruptible, reporter); }, conversionThreads);
+}
+
+json calculate_advised_magnetics_with_filters(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+                                              py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                              bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    py::gil_scoped_release release;
+    return advised_json([&] {
+        return advise_magnetics_with_filters(inputsJson, filterFlowJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations, settingsJson, interruptible, reporter);
+    }, 1);
+}
+
+json calculate_advised_magnetics_fast(json inputsJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+                                      py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                      bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    py::gil_scoped_release release;
+    return advised_json([&] {
+        return advise_magnetics_fast(inputsJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations, settingsJson, interruptible, reporter);
+    }, 1);
+}
+
+py::object calculate_advised_cores_handles(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson, json prefilterJson, json settingsJson) {
+    return advised_handles([&] { return advise_cores(inputsJson, weightsJson, maximumNumberResults, coreModeJson, prefilterJson, settingsJson); });
+}
+
+py::object calculate_advised_magnetics_handles(json inputsJson, int maximumNumberResults, json coreModeJson, json prefilterJson,
+                                               py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                               bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    return advised_handles([&] { return advise_magnetics(inputsJson, maximumNumberResults, coreModeJson, prefilterJson, settingsJson, interruptible, reporter); });
+}
+
+py::object calculate_advised_magnetics_with_filters_handles(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+                                                            py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                                            bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    return advised_handles([&] {
+        return advise_magnetics_with_filters(inputsJson, filterFlowJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations, settingsJson, interruptible, reporter);
+    });
+}
+
+py::object calculate_advised_magnetics_fast_handles(json inputsJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+                                                    py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, json settingsJson,
+                                                    bool interruptible) {
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    return advised_handles([&] {
+        return advise_magnetics_fast(inputsJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations, settingsJson, interruptible, reporter);
+    });
 }
 
 json calculate_advised_magnetics_from_catalog(json inputsJson, json catalogJson, int maximumNumberResults) {
+    PYMKF_PROFILE_SCOPE("MagneticAdviser::catalog");
     try {
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
         OpenMagnetics::settings.set_coil_delimit_and_compact(true);
         OpenMagnetics::Inputs inputs(inputsJson);
         std::map<OpenMagnetics::MagneticFilters, double> weights;
@@ -208,30 +721,7 @@ json calculate_advised_magnetics_from_catalog(json inputsJson, json catalogJson,
 
         auto scoringsPerFilter = magneticAdviser.get_scorings();
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
-                json filterScorings;
-                for (auto& [filter, filterScore] : scoringsPerFilter[name]) {
-                    filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
-                }
-                result["scoringPerFilter"] = filterScorings;
-            }
-            results["data"].push_back(result);
-        }
-
-        sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
-            return b1["scoring"] > b2["scoring"];
-        });
-
-        return results;
+        return build_advised_results(masMagnetics, scoringsPerFilter, 1);
     }
     catch (const std::exception &exc) {
         std::cout << inputsJson << std::endl;
@@ -242,7 +732,10 @@ json calculate_advised_magnetics_from_catalog(json inputsJson, json catalogJson,
 }
 
 json calculate_advised_magnetics_from_cache(json inputsJson, json filterFlowJson, int maximumNumberResults) {
+    PYMKF_PROFILE_SCOPE("MagneticAdviser::catalog");
     try {
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
         OpenMagnetics::settings.set_coil_delimit_and_compact(true);
         OpenMagnetics::Inputs inputs(inputsJson);
 
@@ -261,30 +754,7 @@ json calculate_advised_magnetics_from_cache(json inputsJson, json filterFlowJson
 
         auto scoringsPerFilter = magneticAdviser.get_scorings();
 
-        json results = json();
-        results["data"] = json::array();
-        for (auto& [masMagnetic, scoring] : masMagnetics) {
-            std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
-            json result;
-            json masJson;
-            to_json(masJson, masMagnetic);
-            result["mas"] = masJson;
-            result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
-                json filterScorings;
-                for (auto& [filter, filterScore] : scoringsPerFilter[name]) {
-                    filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
-                }
-                result["scoringPerFilter"] = filterScorings;
-            }
-            results["data"].push_back(result);
-        }
-
-        sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
-            return b1["scoring"] > b2["scoring"];
-        });
-
-        return results;
+        return build_advised_results(masMagnetics, scoringsPerFilter, 1);
     }
     catch (const std::exception &exc) {
         return "Exception: " + std::string{exc.what()};
@@ -293,6 +763,8 @@ json calculate_advised_magnetics_from_cache(json inputsJson, json filterFlowJson
 
 json calculate_advised_sections(json masJson, json patternJson, int repetitions) {
     try {
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
         OpenMagnetics::Mas mas(masJson);
         std::vector<size_t> pattern;
         for (auto& elem : patternJson) {
@@ -325,6 +797,8 @@ json calculate_advised_sections(json masJson, json patternJson, int repetitions)
 
 json calculate_advised_coil(json masJson) {
     try {
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
         OpenMagnetics::Settings::GetInstance().set_coil_delimit_and_compact(true);
         OpenMagnetics::Mas mas(masJson);
         for (size_t windingIndex = 0; windingIndex < mas.get_magnetic().get_coil().get_functional_description().size(); ++windingIndex) {
@@ -350,41 +824,97 @@ json calculate_advised_coil(json masJson) {
     }
 }
 
+// Wire advice for one winding section. Callers hold a StateWriteLock and a
+// ScopedSettings with coil delimiting and compacting enabled.
+static json advise_wires_unlocked(const json& windingJson, const json& sectionJson, const json& currentJson,
+                                  const json& solidInsulationRequirementsJson, double temperature, uint8_t numberSections,
+                                  size_t maximumNumberResults, bool usePlanarWires) {
+    OpenMagnetics::Winding winding(windingJson);
+    OpenMagnetics::WireSolidInsulationRequirements wireSolidInsulationRequirements(solidInsulationRequirementsJson);
+    Section section(sectionJson);
+    SignalDescriptor current(currentJson);
+    OpenMagnetics::WireAdviser wireAdviser;
+    wireAdviser.set_wire_solid_insulation_requirements(wireSolidInsulationRequirements);
+    std::vector<std::pair<OpenMagnetics::Winding, double>> windingsWithScoring;
+    if (usePlanarWires) {
+        windingsWithScoring = wireAdviser.get_advised_planar_wire(winding, section, current, temperature, numberSections, maximumNumberResults);
+    }
+    else {
+        windingsWithScoring = wireAdviser.get_advised_wire(winding, section, current, temperature, numberSections, maximumNumberResults);
+    }
+    json results;
+    results["data"] = json::array();
+    for (auto& [w, scoring] : windingsWithScoring) {
+        json result;
+        json windingJson;
+        to_json(windingJson, w);
+        result["winding"] = windingJson;
+        result["scoring"] = scoring;
+        results["data"].push_back(result);
+    }
+    return results;
+}
+
 json calculate_advised_wires(json windingJson, json sectionJson, json currentJson, json solidInsulationRequirementsJson, double temperature, uint8_t numberSections, size_t maximumNumberResults, bool usePlanarWires) {
     try {
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
         OpenMagnetics::Settings::GetInstance().set_coil_delimit_and_compact(true);
-        OpenMagnetics::Winding winding(windingJson);
-        OpenMagnetics::WireSolidInsulationRequirements wireSolidInsulationRequirements(solidInsulationRequirementsJson);
-        Section section(sectionJson);
-        SignalDescriptor current(currentJson);
-        OpenMagnetics::WireAdviser wireAdviser;
-        wireAdviser.set_wire_solid_insulation_requirements(wireSolidInsulationRequirements);
-        std::vector<std::pair<OpenMagnetics::Winding, double>> windingsWithScoring;
-        if (usePlanarWires) {
-            windingsWithScoring = wireAdviser.get_advised_planar_wire(winding, section, current, temperature, numberSections, maximumNumberResults);
-        }
-        else {
-            windingsWithScoring = wireAdviser.get_advised_wire(winding, section, current, temperature, numberSections, maximumNumberResults);
+        return advise_wires_unlocked(windingJson, sectionJson, currentJson, solidInsulationRequirementsJson, temperature,
+                                     numberSections, maximumNumberResults, usePlanarWires);
+    }
+    catch (const std::exception& exc) {
+        return json{{"error", std::string("calculate_advised_wires: ") + exc.what()}};
+    }
+}
+
+json calculate_advised_wires_batch(json requestsJson, size_t maximumNumberResults, bool usePlanarWires) {
+    try {
+        // One exclusive section, one settings scope and one database load for
+        // the whole batch. The requests run one after another: WireAdviser
+        // works on the shared wire database and settings and is not safe to
+        // run concurrently.
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
+        OpenMagnetics::Settings::GetInstance().set_coil_delimit_and_compact(true);
+        load_missing_databases();
+
+        std::vector<json> items(requestsJson.size());
+        for (size_t index = 0; index < items.size(); ++index) {
+            try {
+                const json& request = requestsJson.at(index);
+                items[index] = advise_wires_unlocked(request.at("winding"), request.at("section"), request.at("current"),
+                                                     request.at("solidInsulationRequirements"), request.at("temperature").get<double>(),
+                                                     request.value("numberSections", 1), maximumNumberResults, usePlanarWires);
+            }
+            catch (const std::exception& exc) {
+                items[index] = json{{"error", std::string("calculate_advised_wires: ") + exc.what()}};
+            }
         }
+
         json results;
-        results["data"] = json::array();
-        for (auto& [w, scoring] : windingsWithScoring) {
-            json result;
-            json windingJson;
-            to_json(windingJson, w);
-            result["winding"] = windingJson;
-            result["scoring"] = scoring;
-            results["data"].push_back(result);
-        }
+        results["data"] = std::move(items);
         return results;
     }
     catch (const std::exception& exc) {
-        return json{{"error", std::string("calculate_advised_wires: ") + exc.what()}};
+        return json{{"error", std::string("calculate_advised_wires_batch: ") + exc.what()}};
     }
 }
 
 void register_adviser_bindings(py::module& m) {
-    m.def("calculate_advised_cores", &calculate_advised_cores,
+    m.def("calculate_advised_cores",
+        [](json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson, int conversionThreads, json prefilterJson, bool returnHandles,
+           json settingsJson) -> py::object {
+            if (returnHandles) {
+                return calculate_advised_cores_handles(inputsJson, weightsJson, maximumNumberResults, coreModeJson, prefilterJson, settingsJson);
+            }
+            json results;
+            {
+                py::gil_scoped_release release;
+                results = calculate_advised_cores(inputsJson, weightsJson, maximumNumberResults, coreModeJson, conversionThreads, prefilterJson, settingsJson);
+            }
+            return py::cast(results);
+        },
         R"pbdoc(
         Get recommended cores for given design requirements.
         
@@ -398,6 +928,20 @@ void register_adviser_bindings(py::module& m) {
                          "COST", "EFFICIENCY", "DIMENSIONS" with float values 0-1.
             max_results: Maximum number of core recommendations to return.
             core_mode_json: Core selection mode - "AVAILABLE_CORES" or "STANDARD_CORES".
+            conversion_threads: Threads converting the results to dicts
+                     (1 = serial, 0 = one per hardware thread). Only the
+                     conversion is split: MKF scores the candidates in one
+                     pass, so the search time and the ranking are the same
+                     for every value.
+            prefilter_json: Optional {column: [minimum, maximum]} ranges over
+                            the core feature index (see query_core_index()).
+                            Only cores inside every range reach the adviser;
+                            cores missing a feature are kept.
+            return_handles: Return a MasHandle per result instead of the
+                            dict below; see MasHandle.
+            settings: Optional settings dict (as set_settings() takes)
+                      applied for this call only; the global settings are
+                      restored afterwards.
         
         Returns:
             JSON object with "data" array containing ranked results.
@@ -415,9 +959,22 @@ void register_adviser_bindings(py::module& m) {
             ...     print(f"Score: {item['scoring']}, Per filter: {item['scoringPerFilter']}")
         )pbdoc",
         py::arg("inputs_json"), py::arg("weights_json"), 
-        py::arg("max_results"), py::arg("core_mode_json"));
+        py::arg("max_results"), py::arg("core_mode_json"), py::arg("conversion_threads") = 1,
+        py::arg("prefilter_json") = nullptr, py::arg("return_handles") = false, py::arg("settings") = nullptr);
     
-    m.def("calculate_advised_magnetics", &calculate_advised_magnetics,
+    // No call_guard on the advisers: handles are built and the progress
+    // callback is converted with the GIL held; they release it themselves.
+    m.def("calculate_advised_magnetics",
+        [](json inputsJson, int maximumNumberResults, json coreModeJson, int conversionThreads, json prefilterJson,
+           py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, bool returnHandles, json settingsJson,
+           bool interruptible) -> py::object {
+            if (returnHandles) {
+                return calculate_advised_magnetics_handles(inputsJson, maximumNumberResults, coreModeJson, prefilterJson,
+                                                           std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible);
+            }
+            return py::cast(calculate_advised_magnetics(inputsJson, maximumNumberResults, coreModeJson, conversionThreads, prefilterJson,
+                                                        std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible));
+        },
         R"pbdoc(
         Get recommended complete magnetic designs for given requirements.
         
@@ -430,6 +987,48 @@ void register_adviser_bindings(py::module& m) {
                          Should be processed using process_inputs() first.
             max_results: Maximum number of magnetic recommendations to return.
             core_mode_json: Core selection mode - "AVAILABLE_CORES" or "STANDARD_CORES".
+            conversion_threads: Threads converting the results to dicts
+                     (1 = serial, 0 = one per hardware thread). Only the
+                     conversion is split: MKF scores the candidates in one
+                     pass, so the search time and the ranking are the same
+                     for every value.
+            prefilter_json: Optional {column: [minimum, maximum]} ranges over
+                            the core feature index (see query_core_index()).
+                            Only cores inside every range reach the adviser;
+                            cores missing a feature are kept.
+            progress_callback: Optional callable, invoked on the calling
+                               thread at most every 100 ms with {"phase",
+                               "evaluated", "total", "bestScore", "elapsedMs"}.
+                               Returning False stops an interruptible search
+                               (see below).
+            cancellation_token: Optional CancellationToken; cancel() from
+                                another thread stops an interruptible search
+                                (see below).
+            return_handles: Return a MasHandle per result instead of the
+                            dict below. Reading the scoring and a few names
+                            off a handle converts nothing, which for many
+                            results is most of the cost of this call.
+            settings: Optional settings dict (as set_settings() takes)
+                      applied for this call only; the global settings are
+                      restored afterwards.
+            interruptible: Screen the cores in steps of increasing effective
+                           volume ("screening" phase) and rank the winners
+                           of each step against each other ("ranking"
+                           phase), so the search can stop between any two
+                           steps. This changes the ranking: the merged
+                           result can differ from the single adviser call.
+
+        A cancellation token or a callback returning False does nothing to a
+        search that is already running unless interruptible=True. Without it
+        the search is the single adviser call MKF runs, which cannot be
+        interrupted: the callback sees a "search" report before it and a
+        "done" report after it, and a token only prevents the call when it
+        is cancelled before the search starts.
+
+        The advisers change settings and narrow the core database while they
+        search, so they hold the library exclusively: concurrent adviser
+        calls run one after another. Other Python threads keep running
+        meanwhile; the GIL is released for the whole search.
         
         Returns:
             JSON object with "data" array containing ranked results.
@@ -438,16 +1037,36 @@ void register_adviser_bindings(py::module& m) {
             - "scoring": Overall float score
             - "scoringPerFilter": Object with individual scores per filter
               (e.g., {"COST": 0.8, "LOSSES": 0.9, "DIMENSIONS": 0.7})
+            With interruptible, also "cancelled", "truncated",
+            "evaluatedCores", "totalCores" and "elapsedMs"; with only a
+            callback or a token, "cancelled".
         
         Example:
             >>> inputs = PyMKF.process_inputs(raw_inputs)
             >>> result = PyMKF.calculate_advised_magnetics(inputs, 5, "AVAILABLE_CORES")
             >>> for item in result["data"]:
             ...     print(f"Score: {item['scoring']}, Per filter: {item['scoringPerFilter']}")
+            >>> token = PyMKF.CancellationToken()
+            >>> result = PyMKF.calculate_advised_magnetics(
+            ...     inputs, 5, "standard cores", progress_callback=print, cancellation_token=token,
+            ...     interruptible=True)
         )pbdoc",
-        py::arg("inputs_json"), py::arg("max_results"), py::arg("core_mode_json"));
+        py::arg("inputs_json"), py::arg("max_results"), py::arg("core_mode_json"), py::arg("conversion_threads") = 1,
+        py::arg("prefilter_json") = nullptr,
+        py::arg("progress_callback") = py::none(), py::arg("cancellation_token") = nullptr,
+        py::arg("return_handles") = false, py::arg("settings") = nullptr, py::arg("interruptible") = false);
 
-    m.def("calculate_advised_magnetics_with_filters", &calculate_advised_magnetics_with_filters,
+    m.def("calculate_advised_magnetics_with_filters",
+        [](json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+           py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, bool returnHandles, json settingsJson,
+           bool interruptible) -> py::object {
+            if (returnHandles) {
+                return calculate_advised_magnetics_with_filters_handles(inputsJson, filterFlowJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations,
+                                                                        std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible);
+            }
+            return py::cast(calculate_advised_magnetics_with_filters(inputsJson, filterFlowJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations,
+                                                                     std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible));
+        },
         R"pbdoc(
         Fast custom magnetic design with a CALLER-SUPPLIED filter flow.
 
@@ -457,10 +1076,30 @@ void register_adviser_bindings(py::module& m) {
         current-density gated. Each filter op is
         {"filter": <TitleCaseName>, "invert": bool, "log": bool,
          "strictlyRequired": bool, "weight": float}.
+
+        time_budget_ms, max_evaluations, progress_callback,
+        cancellation_token, return_handles, settings and interruptible work as in
+        calculate_advised_magnetics_fast(). The filter flow normalises its
+        scores within one adviser call, so the winners of the batches are
+        re-scored together before they are returned; when the budget runs
+        out that takes one more call over them.
         )pbdoc",
-        py::arg("inputs_json"), py::arg("filter_flow_json"), py::arg("max_results"), py::arg("core_mode_json"));
+        py::arg("inputs_json"), py::arg("filter_flow_json"), py::arg("max_results"), py::arg("core_mode_json"),
+        py::arg("time_budget_ms") = 0, py::arg("max_evaluations") = 0,
+        py::arg("progress_callback") = py::none(), py::arg("cancellation_token") = nullptr,
+        py::arg("return_handles") = false, py::arg("settings") = nullptr, py::arg("interruptible") = false);
 
-    m.def("calculate_advised_magnetics_fast", &calculate_advised_magnetics_fast,
+    m.def("calculate_advised_magnetics_fast",
+        [](json inputsJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs, size_t maxEvaluations,
+           py::object progressCallback, std::shared_ptr<CancellationToken> cancellationToken, bool returnHandles, json settingsJson,
+           bool interruptible) -> py::object {
+            if (returnHandles) {
+                return calculate_advised_magnetics_fast_handles(inputsJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations,
+                                                                std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible);
+            }
+            return py::cast(calculate_advised_magnetics_fast(inputsJson, maximumNumberResults, coreModeJson, timeBudgetMs, maxEvaluations,
+                                                             std::move(progressCallback), std::move(cancellationToken), settingsJson, interruptible));
+        },
         R"pbdoc(
         Get recommended complete magnetic designs using fast analytical mode.
 
@@ -477,20 +1116,50 @@ void register_adviser_bindings(py::module& m) {
                          Should be processed using process_inputs() first.
             max_results: Maximum number of magnetic recommendations to return.
             core_mode_json: Core selection mode - "AVAILABLE_CORES" or "STANDARD_CORES".
+            time_budget_ms: Wall-clock budget in milliseconds; 0 (default) for none.
+            max_evaluations: Maximum number of cores to evaluate; 0 (default) for all.
+            progress_callback: Optional callable receiving a progress dict
+                               (see calculate_advised_magnetics()).
+            cancellation_token: Optional CancellationToken.
+            return_handles: Return a MasHandle per result instead of the
+                            dict below (see calculate_advised_magnetics()).
+            settings: Optional per-call settings dict
+                      (see calculate_advised_magnetics()).
+            interruptible: Search in batches even without a budget, so a
+                           callback or token can stop it between two.
+
+        With a budget or interruptible, cores are evaluated in batches of
+        increasing effective volume and the best results so far are kept;
+        no new batch starts once the budget is spent or the search is
+        cancelled. Under a time budget the first batch is small and the
+        later ones are sized from its measured cost per core. Candidates
+        are not pruned by an optimistic score bound: MKF only scores a core
+        once it has designed it, so every core in a started batch is
+        evaluated. Otherwise the search is one adviser call, reported and
+        cancellable as in calculate_advised_magnetics().
 
         Returns:
             JSON object with "data" array containing results sorted by total losses.
             Each result has:
             - "mas": Mas object with magnetic, inputs, and outputs (losses data)
             - "scoring": Total losses value in watts (lower is better)
+            With a budget, also "truncated" (True when cores were left
+            unevaluated), "cancelled", "evaluatedCores", "totalCores" and
+            "elapsedMs".
 
         Example:
             >>> inputs = PyMKF.process_inputs(raw_inputs)
             >>> result = PyMKF.calculate_advised_magnetics_fast(inputs, 5, "STANDARD_CORES")
             >>> for item in result["data"]:
             ...     print(f"Total losses: {item['scoring']} W")
+            >>> # Best 5 within 2 seconds
+            >>> result = PyMKF.calculate_advised_magnetics_fast(inputs, 5, "standard cores", 2000)
+            >>> result["truncated"]
         )pbdoc",
-        py::arg("inputs_json"), py::arg("max_results"), py::arg("core_mode_json"));
+        py::arg("inputs_json"), py::arg("max_results"), py::arg("core_mode_json"),
+        py::arg("time_budget_ms") = 0, py::arg("max_evaluations") = 0,
+        py::arg("progress_callback") = py::none(), py::arg("cancellation_token") = nullptr,
+        py::arg("return_handles") = false, py::arg("settings") = nullptr, py::arg("interruptible") = false);
 
     m.def("calculate_advised_magnetics_from_catalog", &calculate_advised_magnetics_from_catalog,
         R"pbdoc(
@@ -518,7 +1187,8 @@ void register_adviser_bindings(py::module& m) {
             >>> for item in result["data"]:
             ...     print(f"Score: {item['scoring']}, Per filter: {item['scoringPerFilter']}")
         )pbdoc",
-        py::arg("inputs_json"), py::arg("catalog_json"), py::arg("max_results"));
+        py::arg("inputs_json"), py::arg("catalog_json"), py::arg("max_results"),
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_advised_magnetics_from_cache", &calculate_advised_magnetics_from_cache,
         R"pbdoc(
@@ -545,21 +1215,49 @@ void register_adviser_bindings(py::module& m) {
             Cache must be populated before calling this function.
             Returns "Exception: No magnetics found in cache" if cache is empty.
         )pbdoc",
-        py::arg("inputs_json"), py::arg("filter_flow_json"), py::arg("max_results"));
+        py::arg("inputs_json"), py::arg("filter_flow_json"), py::arg("max_results"),
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_advised_sections", &calculate_advised_sections,
         "Get advised coil sections.",
-        py::arg("mas"), py::arg("pattern"), py::arg("repetitions"));
+        py::arg("mas"), py::arg("pattern"), py::arg("repetitions"),
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_advised_coil", &calculate_advised_coil,
         "Get full coil design advice.",
-        py::arg("mas"));
+        py::arg("mas"),
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_advised_wires", &calculate_advised_wires,
         "Get wire selection advice.",
         py::arg("winding"), py::arg("section"), py::arg("current"),
         py::arg("solid_insulation_requirements"), py::arg("temperature"), py::arg("number_sections"),
-        py::arg("max_results"), py::arg("use_planar_wires") = false);
+        py::arg("max_results"), py::arg("use_planar_wires") = false,
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("calculate_advised_wires_batch", &calculate_advised_wires_batch,
+        R"pbdoc(
+        Wire selection advice for many winding sections in one call.
+
+        Each request is what calculate_advised_wires takes, e.g. one per
+        winding and section of a coil. The requests share one state lock,
+        one settings scope and one database load, and are advised one
+        after another.
+
+        Args:
+            requests: JSON array of objects with "winding", "section",
+                "current", "solidInsulationRequirements", "temperature" and
+                optionally "numberSections" (default 1).
+            max_results: Maximum number of wires per request.
+            use_planar_wires: Advise planar wires instead.
+
+        Returns:
+            {"data": [...]} with one entry per request, in request order:
+            the {"data": [{"winding", "scoring"}, ...]} calculate_advised_wires
+            returns, or {"error": ...}.
+        )pbdoc",
+        py::arg("requests"), py::arg("max_results"), py::arg("use_planar_wires") = false,
+        py::call_guard<py::gil_scoped_release>());
 }
 
 } // namespace PyMKF
@@ -1,19 +1,108 @@
 #pragma once
 
 #include "common.h"
+#include "progress.h"
+
+#include <functional>
 
 namespace PyMKF {
 
 // Core adviser
-json calculate_advised_cores(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson);
+json calculate_advised_cores(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson, int conversionThreads = 1, json prefilterJson = nullptr,
+                             json settingsJson = nullptr);
+
+// `settingsJson`, when not null, is a set_settings() dict applied for the
+// call only (see ScopedSettings).
 
-// Magnetic adviser
-json calculate_advised_magnetics(json inputsJson, int maximumNumberResults, json coreModeJson);
-json calculate_advised_magnetics_with_filters(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson);
-json calculate_advised_magnetics_fast(json inputsJson, int maximumNumberResults, json coreModeJson);
+// Magnetic adviser. The overloads taking a progress callback / cancellation
+// token must be called with the GIL held; they release it themselves. The
+// search runs stepwise (see below) only when `interruptible` is set or, for
+// the fast advisers, under a budget; otherwise it is the one adviser call it
+// always was, and a token can only stop it before it starts.
+json calculate_advised_magnetics(json inputsJson, int maximumNumberResults, json coreModeJson, int conversionThreads = 1, json prefilterJson = nullptr,
+                                 py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                 bool interruptible = false);
+json calculate_advised_magnetics_with_filters(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs = 0, size_t maxEvaluations = 0,
+                                              py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                              bool interruptible = false);
+json calculate_advised_magnetics_fast(json inputsJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs = 0, size_t maxEvaluations = 0,
+                                      py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                      bool interruptible = false);
+// return_handles=True variants: the same envelope with a MasHandle per
+// result (see result_handles.h). Call with the GIL held.
+py::object calculate_advised_cores_handles(json inputsJson, json weightsJson, int maximumNumberResults, json coreModeJson, json prefilterJson = nullptr,
+                                           json settingsJson = nullptr);
+py::object calculate_advised_magnetics_handles(json inputsJson, int maximumNumberResults, json coreModeJson, json prefilterJson = nullptr,
+                                               py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                               bool interruptible = false);
+py::object calculate_advised_magnetics_with_filters_handles(json inputsJson, json filterFlowJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs = 0, size_t maxEvaluations = 0,
+                                                            py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                                            bool interruptible = false);
+py::object calculate_advised_magnetics_fast_handles(json inputsJson, int maximumNumberResults, json coreModeJson, double timeBudgetMs = 0, size_t maxEvaluations = 0,
+                                                    py::object progressCallback = py::none(), std::shared_ptr<CancellationToken> cancellationToken = nullptr, json settingsJson = nullptr,
+                                                    bool interruptible = false);
 json calculate_advised_magnetics_from_catalog(json inputsJson, json catalogJson, int maximumNumberResults);
 json calculate_advised_magnetics_from_cache(json inputsJson, json filterFlowJson, int maximumNumberResults);
 
+// ─── Stepwise magnetic search ───────────────────────────────────────────────
+// Runs a MagneticAdviser call over coreDatabase in steps of a few dozen cores,
+// smallest effective volume first, so a search can honour a time budget, an
+// evaluation cap, progress reporting and cancellation between steps. MKF's
+// adviser loops themselves cannot be interrupted, so a step is the latency of
+// all four. Shared by the adviser bindings and design_magnetics_from_converter.
+using AdvisedMagnetics = std::vector<std::pair<OpenMagnetics::Mas, double>>;
+using MagneticScorings = std::remove_cvref_t<decltype(std::declval<OpenMagnetics::MagneticAdviser&>().get_scorings())>;
+
+struct MagneticSearchOptions {
+    int maximumNumberResults = 1;
+    double timeBudgetMs = 0;    // 0: no budget
+    size_t maxEvaluations = 0;  // 0: every candidate
+    bool lowerIsBetter = false;
+    // The adviser normalises its scores within one call, so merged steps are
+    // only approximately ranked. With rankFinalists the winners of each step
+    // play off in further steps until a single call ranks them all; if the
+    // budget runs out first, the remaining ones are re-scored in one call.
+    bool rankFinalists = false;
+    // Cores per step (0: default), and an upper bound on the number of
+    // screening steps for advisers with a high per-call cost (0: none).
+    // Without such a bound, steps under a time budget are sized from the
+    // measured cost per core, up to batchSize.
+    size_t batchSize = 0;
+    size_t maximumSteps = 0;
+    // coreDatabase rows to search instead of all of them (e.g. a prefilter).
+    std::optional<std::vector<size_t>> candidateRows;
+    ProgressReporter* reporter = nullptr;
+};
+
+struct MagneticSearchResult {
+    AdvisedMagnetics best;
+    MagneticScorings scorings;
+    bool truncated = false;
+    bool cancelled = false;
+    size_t evaluatedCores = 0;
+    size_t totalCores = 0;
+    double elapsedMs = 0;
+};
+
+// Requires a StateWriteLock (the steps narrow coreDatabase).
+MagneticSearchResult stepwise_magnetic_search(const MagneticSearchOptions& options,
+                                              const std::function<AdvisedMagnetics(OpenMagnetics::MagneticAdviser&)>& advise);
+
+// Adds "truncated", "cancelled", "evaluatedCores", "totalCores" and
+// "elapsedMs" (plus "progressCallbackError" when the callback raised).
+void add_search_statistics(json& results, const MagneticSearchResult& search, const ProgressReporter* reporter = nullptr);
+
+// Progress for a search that is one plain adviser call, which MKF cannot
+// interrupt. start_single_search returns false, and the call must be
+// skipped, when the reporter was cancelled before it began; otherwise it
+// reports the "search" phase. finish_single_search reports "done" with the
+// `totalCores` the call searched and, when there is a callback or token,
+// adds "cancelled" (plus "progressCallbackError") to `results`. Both accept
+// a null reporter.
+bool start_single_search(ProgressReporter* reporter);
+void finish_single_search(ProgressReporter* reporter, bool started, size_t totalCores, std::optional<double> bestScore,
+                          double elapsedMs, json& results);
+
 void register_adviser_bindings(py::module& m);
 
 } // namespace PyMKF
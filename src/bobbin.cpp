@@ -1,4 +1,6 @@
 #include "bobbin.h"
+#include "concurrency.h"
+#include "name_index.h"
 
 namespace PyMKF {
 
@@ -14,19 +16,25 @@ json get_bobbins() {
 }
 
 json get_bobbin_names() {
-    auto bobbinNames = OpenMagnetics::get_bobbin_names();
-    json result = json::array();
-    for (auto elem : bobbinNames) {
-        result.push_back(elem);
-    }
-    return result;
+    return names_indexed(NameList::BOBBINS, [] {
+        StateReadLockWithDatabases stateLock;
+        auto bobbinNames = OpenMagnetics::get_bobbin_names();
+        json result = json::array();
+        for (auto elem : bobbinNames) {
+            result.push_back(elem);
+        }
+        return result;
+    });
 }
 
 json find_bobbin_by_name(json bobbinName) {
-    auto bobbinData = OpenMagnetics::find_bobbin_by_name(bobbinName);
-    json result;
-    to_json(result, bobbinData);
-    return result;
+    return find_by_name_indexed(NameIndexDatabase::BOBBINS, bobbinName.dump(), [&] {
+        StateReadLockWithDatabases stateLock;
+        auto bobbinData = OpenMagnetics::find_bobbin_by_name(bobbinName);
+        json result;
+        to_json(result, bobbinData);
+        return result;
+    });
 }
 
 json create_basic_bobbin(json coreDataJson, bool nullDimensions) {
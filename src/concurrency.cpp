@@ -0,0 +1,157 @@
+#include "concurrency.h"
+#include "settings.h"
+
+namespace PyMKF {
+
+namespace {
+
+// Depth of the guards held by the current thread; lets nested bindings reuse
+// the outermost lock instead of self-deadlocking on the non-recursive mutex.
+thread_local int readDepth = 0;
+thread_local int writeDepth = 0;
+
+bool databases_loaded() {
+    return OpenMagnetics::coreMaterialDatabase.size() > 0 &&
+           OpenMagnetics::coreShapeDatabase.size() > 0 &&
+           OpenMagnetics::wireDatabase.size() > 0 &&
+           OpenMagnetics::bobbinDatabase.size() > 0 &&
+           OpenMagnetics::insulationMaterialDatabase.size() > 0 &&
+           OpenMagnetics::wireMaterialDatabase.size() > 0;
+}
+
+// Takes the state mutex with `lock`, first trying without blocking. When that
+// fails and the calling thread holds the GIL, it waits with the GIL released:
+// the lock holder may need the GIL (a progress callback, on_result) before it
+// lets go, so waiting while holding it would deadlock.
+template <typename TryLock, typename Lock>
+void lock_releasing_gil(TryLock&& tryLock, Lock&& lock) {
+    if (tryLock()) {
+        return;
+    }
+    if (Py_IsInitialized() && PyGILState_Check()) {
+        py::gil_scoped_release release;
+        lock();
+    }
+    else {
+        lock();
+    }
+}
+
+void lock_shared_state() {
+    auto& mutex = mkf_state_mutex();
+    lock_releasing_gil([&] { return mutex.try_lock_shared(); }, [&] { mutex.lock_shared(); });
+}
+
+void lock_exclusive_state() {
+    auto& mutex = mkf_state_mutex();
+    lock_releasing_gil([&] { return mutex.try_lock(); }, [&] { mutex.lock(); });
+}
+
+bool ensure_databases_loaded() {
+    if (writeDepth > 0) {
+        load_missing_databases();
+        return true;
+    }
+    if (readDepth > 0) {
+        // Already inside a shared section; the outer guard did the check.
+        return true;
+    }
+    {
+        lock_shared_state();
+        std::shared_lock<std::shared_mutex> lock(mkf_state_mutex(), std::adopt_lock);
+        if (databases_loaded()) {
+            return true;
+        }
+    }
+    lock_exclusive_state();
+    std::unique_lock<std::shared_mutex> lock(mkf_state_mutex(), std::adopt_lock);
+    load_missing_databases();
+    return true;
+}
+
+} // namespace
+
+void load_missing_databases(bool includeCores) {
+    if (OpenMagnetics::coreMaterialDatabase.size() == 0) {
+        OpenMagnetics::load_core_materials();
+    }
+    if (OpenMagnetics::coreShapeDatabase.size() == 0) {
+        OpenMagnetics::load_core_shapes();
+    }
+    if (OpenMagnetics::wireDatabase.size() == 0) {
+        OpenMagnetics::load_wires();
+    }
+    if (OpenMagnetics::bobbinDatabase.size() == 0) {
+        OpenMagnetics::load_bobbins();
+    }
+    if (OpenMagnetics::insulationMaterialDatabase.size() == 0) {
+        OpenMagnetics::load_insulation_materials();
+    }
+    if (OpenMagnetics::wireMaterialDatabase.size() == 0) {
+        OpenMagnetics::load_wire_materials();
+    }
+    if (includeCores && OpenMagnetics::coreDatabase.size() == 0) {
+        OpenMagnetics::load_cores();
+    }
+}
+
+std::shared_mutex& mkf_state_mutex() {
+    static std::shared_mutex mutex;
+    return mutex;
+}
+
+StateReadLock::StateReadLock() {
+    if (readDepth == 0 && writeDepth == 0) {
+        lock_shared_state();
+        _owns = true;
+    }
+    ++readDepth;
+}
+
+StateReadLock::~StateReadLock() {
+    --readDepth;
+    if (_owns) {
+        mkf_state_mutex().unlock_shared();
+    }
+}
+
+StateWriteLock::StateWriteLock() {
+    if (writeDepth == 0) {
+        if (readDepth > 0) {
+            throw std::logic_error("StateWriteLock requested while holding a StateReadLock");
+        }
+        lock_exclusive_state();
+        _owns = true;
+    }
+    ++writeDepth;
+}
+
+StateWriteLock::~StateWriteLock() {
+    --writeDepth;
+    if (_owns) {
+        mkf_state_mutex().unlock();
+    }
+}
+
+StateReadLockWithDatabases::StateReadLockWithDatabases()
+    : _ready(ensure_databases_loaded()) {}
+
+ScopedSettings::ScopedSettings(const json& overrides)
+    : _snapshot(get_settings()) {
+    if (!overrides.is_null()) {
+        set_settings(overrides);
+    }
+}
+
+ScopedSettings::~ScopedSettings() {
+    try {
+        OpenMagnetics::settings.reset();
+        set_settings(_snapshot);
+    }
+    catch (...) {
+        // Never throw from a destructor; reset() above already left the
+        // settings in a consistent (default) state.
+    }
+}
+
+} // namespace PyMKF
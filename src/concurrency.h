@@ -0,0 +1,101 @@
+#pragma once
+
+#include "common.h"
+#include <shared_mutex>
+
+namespace PyMKF {
+
+// ─── Shared-state guards ────────────────────────────────────────────────────
+// Long-running bindings (advisers, simulate, sweeps, design_magnetics_from_
+// converter) run with the GIL released, so several Python threads can be
+// inside MKF at once. MKF keeps its state in process globals —
+// OpenMagnetics::settings, the core/shape/wire/material databases,
+// OpenMagnetics::magneticsCache — plus our own masDatabase, none of which are
+// internally synchronised. Every binding that touches that state takes one of
+// the two guards below on entry:
+//
+//   * StateReadLock  — pure computations that only READ settings and the
+//                      databases (simulate, sweeps, losses). Any number of
+//                      these run in parallel.
+//   * StateWriteLock — anything that MUTATES global state: set/reset
+//                      settings, load/clear databases or caches, and the
+//                      advisers (which flip settings while they search and
+//                      lazily load the core database), and everything that
+//                      drives ngspice (process_converter, the converter
+//                      simulate_* bindings), which is not reentrant.
+//
+// Guards are re-entrant per thread: a binding that calls another binding
+// (e.g. process_flyback -> process_converter) reuses the outer lock. A read
+// guard held by the thread cannot be upgraded; nesting a write guard inside a
+// read guard throws std::logic_error instead of deadlocking.
+//
+// A guard that has to wait does so with the GIL released. The holder may
+// need the GIL before it lets go (a progress callback, an on_result
+// consumer), so a binding without call_guard<gil_scoped_release> that blocked
+// here with the GIL held would deadlock against it.
+std::shared_mutex& mkf_state_mutex();
+
+class StateReadLock {
+  public:
+    StateReadLock();
+    ~StateReadLock();
+    StateReadLock(const StateReadLock&) = delete;
+    StateReadLock& operator=(const StateReadLock&) = delete;
+
+  private:
+    bool _owns = false;
+};
+
+class StateWriteLock {
+  public:
+    StateWriteLock();
+    ~StateWriteLock();
+    StateWriteLock(const StateWriteLock&) = delete;
+    StateWriteLock& operator=(const StateWriteLock&) = delete;
+
+  private:
+    bool _owns = false;
+};
+
+// Read guard that first makes sure the lazily-loaded databases are populated.
+// MKF loads core materials / shapes / wires on first lookup, which is a write;
+// doing it up front under the exclusive lock keeps the subsequent shared
+// section read-only.
+class StateReadLockWithDatabases {
+  public:
+    StateReadLockWithDatabases();
+
+  private:
+    // Declaration order matters: the databases are ensured before the shared
+    // lock is taken.
+    bool _ready;
+    StateReadLock _lock;
+};
+
+// Populate whichever of the lazily-loaded databases are still empty (core
+// materials, shapes, wires, bobbins, insulation and wire materials), plus the
+// core database when `includeCores` is set (the advisers search it). Call
+// under a StateWriteLock before fanning work out to native threads.
+void load_missing_databases(bool includeCores = false);
+
+// ─── Per-call settings context ──────────────────────────────────────────────
+// Captures the complete settings (get_settings()) on construction and restores
+// them on destruction. Replaces the old `OpenMagnetics::settings.reset()` at the
+// end of the advisers, which silently discarded whatever the caller had
+// configured with set_settings() — and, with threads, whatever another caller
+// had configured in the meantime. Non-null `overrides` (the partial dict
+// set_settings() accepts) are applied for the lifetime of the scope, which is
+// how the advisers take per-call settings. Must be used under a
+// StateWriteLock.
+class ScopedSettings {
+  public:
+    explicit ScopedSettings(const json& overrides = nullptr);
+    ~ScopedSettings();
+    ScopedSettings(const ScopedSettings&) = delete;
+    ScopedSettings& operator=(const ScopedSettings&) = delete;
+
+  private:
+    json _snapshot;
+};
+
+} // namespace PyMKF
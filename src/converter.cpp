@@ -1,4 +1,10 @@
 #include "converter.h"
+#include "advisers.h"
+#include "concurrency.h"
+#include "profiling.h"
+#include "thread_pool.h"
+#include "spice_batch.h"
+#include "utils.h"
 
 // Include all converter model headers
 #include "converter_models/Flyback.h"
@@ -33,6 +39,14 @@
 #include <set>
 #include <unordered_map>
 #include <cmath>
+#include <complex>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <thread>
 
 namespace PyMKF {
 
@@ -214,6 +228,65 @@ OpenMagnetics::Inputs process_base_spec_vector_L(const json& converterJson, bool
     }
 }
 
+// ─────────────────────────────────────────────────────────────────────
+// Parallel input-voltage split (analytical base-spec path)
+//
+// A base spec's operating points are produced per input voltage (nominal,
+// minimum, maximum, in that order) and per operating point, and once the
+// design requirements are fixed each input voltage is independent of the
+// others. The design requirements — the turns ratios and inductance derived
+// from the WHOLE spec — are therefore computed once and pinned; each input
+// voltage is then processed on its own copy of the converter, holding only
+// that voltage in its original slot so the operating-point names match the
+// sequential run, and the parts are concatenated in slot order.
+// ─────────────────────────────────────────────────────────────────────
+static std::vector<json> split_input_voltages(const json& converterJson) {
+    std::vector<json> parts;
+    if (!converterJson.contains("inputVoltage") || !converterJson["inputVoltage"].is_object()) {
+        return parts;
+    }
+    for (const std::string slot : {"nominal", "minimum", "maximum"}) {
+        const auto& inputVoltage = converterJson["inputVoltage"];
+        if (!inputVoltage.contains(slot) || inputVoltage[slot].is_null()) {
+            continue;
+        }
+        json part = converterJson;
+        part["inputVoltage"] = json{{slot, inputVoltage[slot]}};
+        parts.push_back(std::move(part));
+    }
+    return parts;
+}
+
+template <typename BaseConverter>
+OpenMagnetics::Inputs process_base_spec_split(const json& converterJson, MAS::Topology topology, int threads) {
+    BaseConverter converter(converterJson);
+    converter._assertErrors = true;
+    auto designReqs = converter.process_design_requirements();
+    std::vector<double> turnsRatios;
+    for (const auto& tr : designReqs.get_turns_ratios()) {
+        turnsRatios.push_back(OpenMagnetics::resolve_dimensional_values(tr));
+    }
+    double inductance = OpenMagnetics::resolve_dimensional_values(designReqs.get_magnetizing_inductance());
+
+    auto parts = split_input_voltages(converterJson);
+    std::vector<std::vector<OperatingPoint>> partOperatingPoints(parts.size());
+    parallel_for(parts.size(), resolve_thread_count(threads, parts.size()), [&](size_t index) {
+        BaseConverter part(parts[index]);
+        part._assertErrors = true;
+        partOperatingPoints[index] = part.process_operating_points(turnsRatios, inductance);
+    });
+
+    std::vector<OperatingPoint> operatingPoints;
+    for (auto& part : partOperatingPoints) {
+        operatingPoints.insert(operatingPoints.end(), std::make_move_iterator(part.begin()), std::make_move_iterator(part.end()));
+    }
+    OpenMagnetics::Inputs result;
+    result.set_design_requirements(designReqs);
+    result.set_operating_points(operatingPoints);
+    result.get_mutable_design_requirements().set_topology(topology);
+    return result;
+}
+
 OpenMagnetics::Inputs process_flyback_internal(const json& converterJson, bool useNgspice) {
     if (!converterJson.contains("desiredInductance")) {
         return process_base_spec_vector_L<OpenMagnetics::Flyback>(converterJson, useNgspice, MAS::Topology::FLYBACK_CONVERTER);
@@ -897,9 +970,35 @@ OpenMagnetics::Inputs dispatch_converter(const std::string& topologyName, const
     }
 }
 
-json process_converter_internal(const std::string& topologyName, const json& converterJson, bool useNgspice) {
+// Base-spec topologies whose input voltages process_base_spec_split() runs in
+// parallel. Only those a serial-vs-split equality test covers
+// (test_process_converter_threads_match_sequential) are listed; add a
+// topology here together with its test case. Everything else stays
+// sequential: the other base specs until they are tested, resonant and
+// bridge models because they derive their tank / phase parameters inside the
+// operating-point pass, Advanced specs (desiredInductance), and ngspice runs,
+// since the simulator is not reentrant.
+static std::optional<OpenMagnetics::Inputs> dispatch_converter_split(const std::string& topologyName, const json& converterJson, int threads) {
+    using Splitter = OpenMagnetics::Inputs (*)(const json&, MAS::Topology, int);
+    static const std::unordered_map<std::string, std::pair<Splitter, MAS::Topology>> splitters = {
+        {"flyback",                {&process_base_spec_split<OpenMagnetics::Flyback>, MAS::Topology::FLYBACK_CONVERTER}},
+        {"buck",                   {&process_base_spec_split<OpenMagnetics::Buck>, MAS::Topology::BUCK_CONVERTER}},
+        {"boost",                  {&process_base_spec_split<OpenMagnetics::Boost>, MAS::Topology::BOOST_CONVERTER}},
+    };
+    auto it = splitters.find(topologyName);
+    if (it == splitters.end() || converterJson.contains("desiredInductance") || split_input_voltages(converterJson).size() < 2) {
+        return std::nullopt;
+    }
+    return it->second.first(converterJson, it->second.second, threads);
+}
+
+json process_converter_internal(const std::string& topologyName, const json& converterJson, bool useNgspice, int threads = 1) {
     try {
-        OpenMagnetics::Inputs inputs = dispatch_converter(topologyName, converterJson, useNgspice);
+        std::optional<OpenMagnetics::Inputs> splitInputs;
+        if (threads != 1 && !useNgspice) {
+            splitInputs = dispatch_converter_split(topologyName, converterJson, threads);
+        }
+        OpenMagnetics::Inputs inputs = splitInputs ? std::move(*splitInputs) : dispatch_converter(topologyName, converterJson, useNgspice);
         json result;
         to_json(result, inputs);
         return result;
@@ -911,14 +1010,18 @@ json process_converter_internal(const std::string& topologyName, const json& con
     }
 }
 
-json process_converter(const std::string& topologyName, json converterJson, bool useNgspice) {
+json process_converter(const std::string& topologyName, json converterJson, bool useNgspice, int threads) {
+    PYMKF_PROFILE_SCOPE("process_converter");
     // Normalize topology name (accept MAS 1.0 camelCase, pre-1.0 Title Case,
     // and the internal short form) and migrate any pre-1.0 enum strings
     // embedded in the converter JSON (e.g. flyback "mode": "Continuous
     // Conduction Mode" -> "continuousConductionMode") in-place.
     std::string normalized = normalize_topology_name(topologyName);
     OpenMagnetics::compat::migrate_pre_1_0(converterJson);
-    return process_converter_internal(normalized, converterJson, useNgspice);
+    // ngspice keeps process-global state, so converter processing is
+    // serialised against every other MKF-state user.
+    StateWriteLock stateLock;
+    return process_converter_internal(normalized, converterJson, useNgspice, threads);
 }
 
 // Build candidate magnetics from a converter object via the MKF template
@@ -955,21 +1058,221 @@ static std::vector<std::pair<OpenMagnetics::Mas, double>> advise_inductor_family
         : advise_from_converter_spec<Base>(converterJson, fast, weights, maxResults, adviser);
 }
 
-// Simplified design_magnetics_from_converter using MKF template method
-json design_magnetics_from_converter(
-    const std::string& topologyNameRaw,
-    json converterJson,
+// process_converter_internal's {"error": ...} reply, carried out of the
+// adviser lambda and returned as-is.
+struct ConverterInputsError {
+    json error;
+};
+
+// One adviser run for a converter spec: the topology's converter model
+// through get_advised_magnetic_from_converter, or, for topologies without
+// one, the processed inputs through get_advised_magnetic. Takes a normalised
+// topology name and migrated converter JSON; the caller holds the
+// StateWriteLock and sets the adviser's core mode.
+static AdvisedMagnetics advise_magnetics_from_converter(OpenMagnetics::MagneticAdviser& magneticAdviser, const std::string& topologyName,
+                                                        const json& converterJson, bool useNgspice,
+                                                        const std::map<OpenMagnetics::MagneticFilters, double>& weights, int maxResults, bool fast) {
+    std::vector<std::pair<OpenMagnetics::Mas, double>> masMagnetics;
+
+    // Build candidate magnetics from the converter spec via the MKF
+    // template method. Two independent axes (4 behaviours total):
+    //
+    //   * Base vs Advanced* model — chosen PER TOPOLOGY:
+    //       - Single-inductor family (Buck/Boost/Cuk/Sepic/Zeta/
+    //         FourSwitchBuckBoost): advise_inductor_family() picks
+    //         Advanced* when desiredInductance is present (honoured as the
+    //         nominal L target), Base otherwise (L derived from the ripple
+    //         budget). This is ABT #11 — the slow path used to force
+    //         Advanced for Buck/Boost and throw on a base spec.
+    //       - Transformer/resonant families: always Base. Their Advanced*
+    //         from_json requires desiredTurnsRatios (Flyback also
+    //         desiredDutyCycle) — design outputs a converter spec lacks —
+    //         so only Base is constructible; it derives turns + L itself.
+    //   * fast flag — fast core-only adviser vs full winding+sim adviser,
+    //     threaded into get_advised_magnetic_from_converter for every
+    //     topology.
+    if (topologyName == "flyback" || topologyName == "advanced_flyback") {
+        OpenMagnetics::Flyback converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "buck" || topologyName == "advanced_buck") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::Buck, OpenMagnetics::AdvancedBuck>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "boost" || topologyName == "advanced_boost") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::Boost, OpenMagnetics::AdvancedBoost>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "single_switch_forward") {
+        OpenMagnetics::SingleSwitchForward converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "two_switch_forward") {
+        OpenMagnetics::TwoSwitchForward converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "active_clamp_forward") {
+        OpenMagnetics::ActiveClampForward converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "push_pull") {
+        OpenMagnetics::PushPull converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "isolated_buck") {
+        OpenMagnetics::IsolatedBuck converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "isolated_buck_boost") {
+        OpenMagnetics::IsolatedBuckBoost converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "llc" || topologyName == "advanced_llc") {
+        OpenMagnetics::Llc converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "cuk" || topologyName == "advanced_cuk") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::Cuk, OpenMagnetics::AdvancedCuk>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "sepic" || topologyName == "advanced_sepic") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::Sepic, OpenMagnetics::AdvancedSepic>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "zeta" || topologyName == "advanced_zeta") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::Zeta, OpenMagnetics::AdvancedZeta>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "four_switch_buck_boost" || topologyName == "advanced_four_switch_buck_boost") {
+        masMagnetics = advise_inductor_family<OpenMagnetics::FourSwitchBuckBoost, OpenMagnetics::AdvancedFourSwitchBuckBoost>(
+            converterJson, fast, weights, maxResults, magneticAdviser);
+    }
+    else if (topologyName == "asymmetric_half_bridge" || topologyName == "advanced_asymmetric_half_bridge") {
+        OpenMagnetics::AsymmetricHalfBridge converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "phase_shifted_full_bridge" || topologyName == "psfb" ||
+             topologyName == "advanced_phase_shifted_full_bridge" || topologyName == "advanced_psfb") {
+        // Use the basic Psfb converter (mirrors the AHB / LLC branches):
+        // its process_design_requirements() derives turns ratios and
+        // magnetizing inductance from the converter spec. Falling through
+        // to the generic else branch would dispatch to AdvancedPsfb, whose
+        // from_json requires desiredTurnsRatios / desiredMagnetizingInductance
+        // (the design *outputs*), which a plain converter spec does not carry.
+        OpenMagnetics::Psfb converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "weinberg" || topologyName == "advanced_weinberg") {
+        OpenMagnetics::Weinberg converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "vienna" || topologyName == "advanced_vienna") {
+        OpenMagnetics::Vienna converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "clllc" || topologyName == "advanced_clllc") {
+        OpenMagnetics::Clllc converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "src" || topologyName == "advanced_src") {
+        OpenMagnetics::Src converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else if (topologyName == "dab" || topologyName == "advanced_dab" ||
+             topologyName == "dual_active_bridge") {
+        // Use the base Dab model (mirrors llc / src / clllc above): it
+        // derives turns ratios + magnetizing inductance itself from the
+        // V1/V2 windows, so it does not require the AdvancedDab
+        // desiredTurnsRatios / desiredMagnetizingInductance inputs.
+        OpenMagnetics::Dab converter(converterJson);
+        converter._assertErrors = true;
+        masMagnetics = weights.empty()
+            ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
+            : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+    }
+    else {
+        // Fall back for topologies without a converter-model adviser path
+        // (e.g. PFC, current transformer). dispatch_converter / the
+        // process_*_internal it calls already pick Base vs Advanced on the
+        // presence of desiredInductance (ABT #11), so the Base/Advanced
+        // behaviour is preserved here too; only the adviser stage differs.
+        // The caller's StateWriteLock also serialises ngspice.
+        json inputsJson = process_converter_internal(topologyName, converterJson, useNgspice);
+        if (inputsJson.contains("error")) throw ConverterInputsError{inputsJson};
+
+        OpenMagnetics::Inputs inputs(inputsJson);
+        if (fast) {
+            masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, maxResults);
+        } else if (weights.empty()) {
+            masMagnetics = magneticAdviser.get_advised_magnetic(inputs, maxResults);
+        } else {
+            masMagnetics = magneticAdviser.get_advised_magnetic(inputs, weights, maxResults);
+        }
+    }
+    return masMagnetics;
+}
+
+// Body of design_magnetics_from_converter, shared with the batch variant.
+// Expects an already-normalised topology name and migrated converter JSON,
+// and assumes the caller holds the StateWriteLock (see concurrency.h). With
+// `interruptible` the cores are searched stepwise, which narrows
+// coreDatabase and so must not run on several threads at once. `threads`
+// only spreads the conversion of the results to JSON.
+static json design_magnetics_from_converter_unlocked(
+    const std::string& topologyName,
+    const json& converterJson,
     int maxResults,
-    json coreModeJson,
+    const json& coreModeJson,
     bool useNgspice,
-    json weightsJson,
-    bool fast) {
-
-
-    // Accept MAS 1.0 camelCase, pre-1.0 Title Case, or internal short form.
-    const std::string topologyName = normalize_topology_name(topologyNameRaw);
-    OpenMagnetics::compat::migrate_pre_1_0(converterJson);
+    const json& weightsJson,
+    bool fast,
+    ProgressReporter* reporter = nullptr,
+    bool interruptible = false,
+    int threads = 1) {
 
+    PYMKF_PROFILE_SCOPE("design_magnetics_from_converter");
     try {
         OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
         from_json(coreModeJson, coreMode);
@@ -983,194 +1286,53 @@ json design_magnetics_from_converter(
             }
         }
         
-        OpenMagnetics::MagneticAdviser magneticAdviser;
-        magneticAdviser.set_core_mode(coreMode);
-        
+        // One adviser run over whatever cores coreDatabase holds; called once
+        // for a plain design, once per step for an interruptible one.
+        auto advise = [&](OpenMagnetics::MagneticAdviser& magneticAdviser) {
+            magneticAdviser.set_core_mode(coreMode);
+            return advise_magnetics_from_converter(magneticAdviser, topologyName, converterJson, useNgspice, weights, maxResults, fast);
+        };
+
         std::vector<std::pair<OpenMagnetics::Mas, double>> masMagnetics;
-        
-        // Build candidate magnetics from the converter spec via the MKF
-        // template method. Two independent axes (4 behaviours total):
-        //
-        //   * Base vs Advanced* model — chosen PER TOPOLOGY:
-        //       - Single-inductor family (Buck/Boost/Cuk/Sepic/Zeta/
-        //         FourSwitchBuckBoost): advise_inductor_family() picks
-        //         Advanced* when desiredInductance is present (honoured as the
-        //         nominal L target), Base otherwise (L derived from the ripple
-        //         budget). This is ABT #11 — the slow path used to force
-        //         Advanced for Buck/Boost and throw on a base spec.
-        //       - Transformer/resonant families: always Base. Their Advanced*
-        //         from_json requires desiredTurnsRatios (Flyback also
-        //         desiredDutyCycle) — design outputs a converter spec lacks —
-        //         so only Base is constructible; it derives turns + L itself.
-        //   * fast flag — fast core-only adviser vs full winding+sim adviser,
-        //     threaded into get_advised_magnetic_from_converter for every
-        //     topology.
-        if (topologyName == "flyback" || topologyName == "advanced_flyback") {
-            OpenMagnetics::Flyback converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "buck" || topologyName == "advanced_buck") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::Buck, OpenMagnetics::AdvancedBuck>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "boost" || topologyName == "advanced_boost") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::Boost, OpenMagnetics::AdvancedBoost>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "single_switch_forward") {
-            OpenMagnetics::SingleSwitchForward converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "two_switch_forward") {
-            OpenMagnetics::TwoSwitchForward converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "active_clamp_forward") {
-            OpenMagnetics::ActiveClampForward converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "push_pull") {
-            OpenMagnetics::PushPull converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "isolated_buck") {
-            OpenMagnetics::IsolatedBuck converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "isolated_buck_boost") {
-            OpenMagnetics::IsolatedBuckBoost converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "llc" || topologyName == "advanced_llc") {
-            OpenMagnetics::Llc converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "cuk" || topologyName == "advanced_cuk") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::Cuk, OpenMagnetics::AdvancedCuk>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "sepic" || topologyName == "advanced_sepic") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::Sepic, OpenMagnetics::AdvancedSepic>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "zeta" || topologyName == "advanced_zeta") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::Zeta, OpenMagnetics::AdvancedZeta>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "four_switch_buck_boost" || topologyName == "advanced_four_switch_buck_boost") {
-            masMagnetics = advise_inductor_family<OpenMagnetics::FourSwitchBuckBoost, OpenMagnetics::AdvancedFourSwitchBuckBoost>(
-                converterJson, fast, weights, maxResults, magneticAdviser);
-        }
-        else if (topologyName == "asymmetric_half_bridge" || topologyName == "advanced_asymmetric_half_bridge") {
-            OpenMagnetics::AsymmetricHalfBridge converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "phase_shifted_full_bridge" || topologyName == "psfb" ||
-                 topologyName == "advanced_phase_shifted_full_bridge" || topologyName == "advanced_psfb") {
-            // Use the basic Psfb converter (mirrors the AHB / LLC branches):
-            // its process_design_requirements() derives turns ratios and
-            // magnetizing inductance from the converter spec. Falling through
-            // to the generic else branch would dispatch to AdvancedPsfb, whose
-            // from_json requires desiredTurnsRatios / desiredMagnetizingInductance
-            // (the design *outputs*), which a plain converter spec does not carry.
-            OpenMagnetics::Psfb converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "weinberg" || topologyName == "advanced_weinberg") {
-            OpenMagnetics::Weinberg converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "vienna" || topologyName == "advanced_vienna") {
-            OpenMagnetics::Vienna converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "clllc" || topologyName == "advanced_clllc") {
-            OpenMagnetics::Clllc converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "src" || topologyName == "advanced_src") {
-            OpenMagnetics::Src converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
-        }
-        else if (topologyName == "dab" || topologyName == "advanced_dab" ||
-                 topologyName == "dual_active_bridge") {
-            // Use the base Dab model (mirrors llc / src / clllc above): it
-            // derives turns ratios + magnetizing inductance itself from the
-            // V1/V2 windows, so it does not require the AdvancedDab
-            // desiredTurnsRatios / desiredMagnetizingInductance inputs.
-            OpenMagnetics::Dab converter(converterJson);
-            converter._assertErrors = true;
-            masMagnetics = weights.empty()
-                ? magneticAdviser.get_advised_magnetic_from_converter(converter, maxResults, fast)
-                : magneticAdviser.get_advised_magnetic_from_converter(converter, weights, maxResults, fast);
+        MagneticScorings scoringsPerFilter;
+        std::optional<MagneticSearchResult> search;
+        json singleSearchStatistics = json::object();
+        if (interruptible) {
+            // Every step re-processes the converter spec, so the steps are
+            // capped rather than fixed in size.
+            MagneticSearchOptions options;
+            options.maximumNumberResults = maxResults;
+            options.lowerIsBetter = fast;
+            options.rankFinalists = !fast;
+            options.maximumSteps = 16;
+            options.reporter = reporter;
+            search = stepwise_magnetic_search(options, advise);
+            masMagnetics = search->best;
+            scoringsPerFilter = search->scorings;
         }
         else {
-            // Fall back for topologies without a converter-model adviser path
-            // (e.g. PFC, current transformer). dispatch_converter / the
-            // process_*_internal it calls already pick Base vs Advanced on the
-            // presence of desiredInductance (ABT #11), so the Base/Advanced
-            // behaviour is preserved here too; only the adviser stage differs.
-            json inputsJson = process_converter_internal(topologyName, converterJson, useNgspice);
-            if (inputsJson.contains("error")) return inputsJson;
-
-            OpenMagnetics::Inputs inputs(inputsJson);
-            if (fast) {
-                masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, maxResults);
-            } else if (weights.empty()) {
-                masMagnetics = magneticAdviser.get_advised_magnetic(inputs, maxResults);
-            } else {
-                masMagnetics = magneticAdviser.get_advised_magnetic(inputs, weights, maxResults);
+            auto start = std::chrono::steady_clock::now();
+            bool started = start_single_search(reporter);
+            if (started) {
+                OpenMagnetics::MagneticAdviser magneticAdviser;
+                masMagnetics = advise(magneticAdviser);
+                scoringsPerFilter = magneticAdviser.get_scorings();
             }
+            std::optional<double> bestScore;
+            for (auto& [masMagnetic, scoring] : masMagnetics) {
+                if (!bestScore || (fast ? scoring < *bestScore : scoring > *bestScore)) {
+                    bestScore = scoring;
+                }
+            }
+            finish_single_search(reporter, started, OpenMagnetics::coreDatabase.size(), bestScore,
+                                 std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(),
+                                 singleSearchStatistics);
         }
-        
-        // Build results (same as before)
-        auto scoringsPerFilter = magneticAdviser.get_scorings();
-        
-        json results = json();
-        results["data"] = json::array();
-        for (size_t i = 0; i < masMagnetics.size(); ++i) {
+
+        // Converting the Mas objects only reads them, so it is the one part
+        // of the design that can be spread over `threads`.
+        std::vector<json> items(masMagnetics.size());
+        parallel_for(masMagnetics.size(), resolve_thread_count(threads, masMagnetics.size()), [&](size_t i) {
             auto& masMagnetic = masMagnetics[i].first;
             double scoring = masMagnetics[i].second;
             std::string name = masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
@@ -1179,25 +1341,72 @@ json design_magnetics_from_converter(
             to_json(masJson, masMagnetic);
             result["mas"] = masJson;
             result["scoring"] = scoring;
-            if (scoringsPerFilter.count(name)) {
+            auto filterScoringsIt = scoringsPerFilter.find(name);
+            if (filterScoringsIt != scoringsPerFilter.end()) {
                 json filterScorings;
-                for (auto& filterPair : scoringsPerFilter[name]) {
+                for (auto& filterPair : filterScoringsIt->second) {
                     auto filter = filterPair.first;
                     double filterScore = filterPair.second;
                     filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
                 }
                 result["scoringPerFilter"] = filterScorings;
             }
-            results["data"].push_back(result);
+            items[i] = std::move(result);
+        });
+        json results = json();
+        results["data"] = json::array();
+        for (auto& item : items) {
+            results["data"].push_back(std::move(item));
         }
         
         sort(results["data"].begin(), results["data"].end(), [](json& b1, json& b2) {
             return b1["scoring"] > b2["scoring"];
         });
+        if (search) {
+            add_search_statistics(results, *search, reporter);
+        }
+        results.update(singleSearchStatistics);
         
-        OpenMagnetics::settings.reset();
         return results;
     }
+    catch (const ConverterInputsError& e) {
+        return e.error;
+    }
+    catch (const std::exception& e) {
+        json error;
+        error["error"] = "Exception: " + std::string(e.what());
+        return error;
+    }
+}
+
+json design_magnetics_from_converter(
+    const std::string& topologyNameRaw,
+    json converterJson,
+    int maxResults,
+    json coreModeJson,
+    bool useNgspice,
+    json weightsJson,
+    bool fast,
+    py::object progressCallback,
+    std::shared_ptr<CancellationToken> cancellationToken,
+    json settingsJson,
+    bool interruptible) {
+
+    // Accept MAS 1.0 camelCase, pre-1.0 Title Case, or internal short form.
+    const std::string topologyName = normalize_topology_name(topologyNameRaw);
+    OpenMagnetics::compat::migrate_pre_1_0(converterJson);
+
+    ProgressReporter reporter(std::move(progressCallback), std::move(cancellationToken));
+    py::gil_scoped_release release;
+    try {
+        // Exclusive: the adviser flips settings while it searches and ngspice
+        // is not reentrant. ScopedSettings hands the caller's settings back
+        // on exit instead of the process-wide reset() this used to do.
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope(settingsJson);
+        return design_magnetics_from_converter_unlocked(
+            topologyName, converterJson, maxResults, coreModeJson, useNgspice, weightsJson, fast, &reporter, interruptible);
+    }
     catch (const std::exception& e) {
         json error;
         error["error"] = "Exception: " + std::string(e.what());
@@ -1205,6 +1414,109 @@ json design_magnetics_from_converter(
     }
 }
 
+json design_magnetics_from_converter_batch(
+    const std::vector<std::pair<std::string, json>>& specs,
+    int maxResults,
+    json coreModeJson,
+    bool useNgspice,
+    json weightsJson,
+    bool fast,
+    int threads,
+    py::object onResult,
+    std::shared_ptr<CancellationToken> cancellationToken,
+    json settingsJson) {
+
+    // Normalise + migrate up front, while the specs are still ours alone.
+    std::vector<std::pair<std::string, json>> work;
+    work.reserve(specs.size());
+    for (auto [topologyName, converterJson] : specs) {
+        OpenMagnetics::compat::migrate_pre_1_0(converterJson);
+        work.emplace_back(normalize_topology_name(topologyName), std::move(converterJson));
+    }
+
+    json results = json::array();
+    std::mutex completedMutex;
+    std::condition_variable completedCondition;
+    std::deque<json> completed;
+    std::string callbackError;
+
+    {
+        py::gil_scoped_release release;
+
+        // One exclusive section for the whole batch: every item sees the
+        // caller's settings, nothing else mutates MKF state meanwhile, and the
+        // settings come back once at the end.
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope(settingsJson);
+        load_missing_databases(true);
+
+        // The advisers work on MKF's global settings and databases, so the
+        // specs run one after another on the runner thread; only each
+        // result's conversion to JSON is spread over `threads`. Every index
+        // pushes exactly one item (errors included), so the consumer loop
+        // below always terminates.
+        std::thread runner([&]() {
+            for (size_t index = 0; index < work.size(); ++index) {
+                json item;
+                try {
+                    // Specs not yet started when the token is cancelled are
+                    // skipped; the running one finishes.
+                    if (cancellationToken && cancellationToken->cancelled()) {
+                        item = json::object();
+                        item["error"] = "Cancelled";
+                        item["cancelled"] = true;
+                    }
+                    else {
+                        item = design_magnetics_from_converter_unlocked(
+                            work[index].first, work[index].second, maxResults, coreModeJson, useNgspice, weightsJson, fast,
+                            nullptr, false, threads);
+                    }
+                }
+                catch (const std::exception& e) {
+                    item = json::object();
+                    item["error"] = "Exception: " + std::string(e.what());
+                }
+                item["index"] = index;
+                item["topologyName"] = specs[index].first;
+                {
+                    std::lock_guard<std::mutex> lock(completedMutex);
+                    completed.push_back(std::move(item));
+                }
+                completedCondition.notify_one();
+            }
+        });
+
+        // Hand results back as the runner finishes them, which is spec order;
+        // on_result runs on the calling thread with the GIL held only for the
+        // duration of the callback.
+        for (size_t received = 0; received < work.size(); ++received) {
+            json item;
+            {
+                std::unique_lock<std::mutex> lock(completedMutex);
+                completedCondition.wait(lock, [&]() { return !completed.empty(); });
+                item = std::move(completed.front());
+                completed.pop_front();
+            }
+            if (!onResult.is_none() && callbackError.empty()) {
+                py::gil_scoped_acquire acquire;
+                try {
+                    onResult(item);
+                }
+                catch (py::error_already_set& e) {
+                    callbackError = e.what();
+                }
+            }
+            results.push_back(std::move(item));
+        }
+        runner.join();
+    }
+
+    if (!callbackError.empty()) {
+        throw std::runtime_error("Exception: on_result callback raised: " + callbackError);
+    }
+    return results;
+}
+
 
 json process_flyback(json flybackJson) {
     return process_converter("flyback", flybackJson, true);
@@ -1635,6 +1947,58 @@ json generate_ngspice_circuit(const std::string& topologyName,
     }
 }
 
+// Batch of decks (typically generate_ngspice_circuit(...)["netlist"]) run in
+// separate ngspice processes; see spice_batch.h. Each entry carries the
+// vectors of its first plot as NumPy arrays (complex128 for AC plots).
+py::list run_ngspice_batch_numpy(const std::vector<std::string>& decks, int threads, const std::string& ngspicePath, bool keepFiles) {
+    std::vector<SpiceRunResult> runs;
+    {
+        py::gil_scoped_release release;
+        auto executable = resolve_ngspice_executable(ngspicePath);
+        runs = run_ngspice_batch(decks, threads, executable, keepFiles);
+    }
+
+    auto plot_vectors = [](SpicePlot& plot) {
+        py::dict vectors;
+        for (size_t variable = 0; variable < plot.names.size(); ++variable) {
+            auto& values = plot.values[variable];
+            if (plot.complex) {
+                py::array_t<std::complex<double>> array(values.size() / 2);
+                std::memcpy(array.mutable_data(), values.data(), values.size() * sizeof(double));
+                vectors[py::str(plot.names[variable])] = array;
+            }
+            else {
+                vectors[py::str(plot.names[variable])] = vector_to_numpy(std::move(values));
+            }
+        }
+        return vectors;
+    };
+
+    py::list results;
+    for (size_t index = 0; index < runs.size(); ++index) {
+        auto& run = runs[index];
+        py::dict item;
+        item["index"] = index;
+        item["ok"] = run.ok;
+        if (!run.ok) {
+            item["error"] = run.error;
+            item["log"] = run.log;
+        }
+        py::list plots;
+        for (auto& plot : run.plots) {
+            py::dict plotItem;
+            plotItem["title"] = plot.title;
+            plotItem["plotName"] = plot.plotName;
+            plotItem["vectors"] = plot_vectors(plot);
+            plots.append(plotItem);
+        }
+        item["vectors"] = plots.empty() ? py::dict() : py::dict(plots[0]["vectors"]);
+        item["plots"] = plots;
+        results.append(item);
+    }
+    return results;
+}
+
 json get_extra_components_inputs(const std::string& topologyName,
                                  json converterJson,
                                  const std::string& modeStr,
@@ -1829,6 +2193,7 @@ std::string generate_cmc_ngspice_circuit(json cmcInputsJson) {
 
 json simulate_cmc_lisn_waveforms(json cmcInputsJson, double inductance) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::CommonModeChoke cmc(cmcInputsJson);
         auto designRequirements = cmc.process_design_requirements();
 
@@ -1882,6 +2247,7 @@ json simulate_cmc_lisn_waveforms(json cmcInputsJson, double inductance) {
 
 json simulate_cmc_ideal_waveforms(json cmcInputsJson, double inductance, double parasiticCap_pF, double dvdt_V_ns) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::CommonModeChoke cmc(cmcInputsJson);
         auto designRequirements = cmc.process_design_requirements();
 
@@ -1974,6 +2340,7 @@ json propose_dmc_design(json dmcInputsJson) {
 
 json simulate_dmc_waveforms(json dmcInputsJson, double inductance) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::DifferentialModeChoke dmc(dmcInputsJson);
 
         std::vector<double> frequencies;
@@ -2059,6 +2426,7 @@ std::string generate_dmc_ngspice_circuit(json dmcInputsJson) {
 // ------ Flyback (isolated, transformer-based) ------
 json simulate_flyback_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
 
         OpenMagnetics::DesignRequirements designRequirements;
@@ -2169,6 +2537,7 @@ json simulate_flyback_ideal_waveforms(json inputsJson) {
 
 json simulate_flyback_with_magnetic(json inputsJson, json magneticJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::AdvancedFlyback converter(inputsJson);
 
         double magnetizingInductance = converter.get_desired_inductance();
@@ -2211,6 +2580,7 @@ json simulate_flyback_with_magnetic(json inputsJson, json magneticJson) {
     DIAG_FLAT, DIAG_PEROP) \
 json func_name(json inputsJson) { \
     try { \
+        StateWriteLock stateLock; \
         bool isAdvanced = inputsJson.contains("desiredInductance"); \
         OpenMagnetics::DesignRequirements designRequirements; \
         double inductance; \
@@ -2360,6 +2730,7 @@ DEFINE_SIMULATE_NON_ISOLATED(simulate_boost_ideal_waveforms, OpenMagnetics::Boos
 // Sepic: sizedCs, sizedCo
 json simulate_sepic_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
         OpenMagnetics::DesignRequirements designRequirements;
         double inductanceL1;
@@ -2426,6 +2797,7 @@ json simulate_sepic_ideal_waveforms(json inputsJson) {
 // Cuk: sizedCa, sizedCb, sizedCo, rhpZeroFrequency
 json simulate_cuk_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
         OpenMagnetics::DesignRequirements designRequirements;
         double inductanceL1;
@@ -2498,6 +2870,7 @@ json simulate_cuk_ideal_waveforms(json inputsJson) {
 // Zeta: sizedCc, sizedCo, outputVoltageRipple, inputCurrentRipple
 json simulate_zeta_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
         OpenMagnetics::DesignRequirements designRequirements;
         double inductanceL1;
@@ -2573,6 +2946,7 @@ json simulate_zeta_ideal_waveforms(json inputsJson) {
 // ------ FourSwitchBuckBoost (single inductance, FSBB diagnostics) ------
 json simulate_four_switch_buck_boost_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
         OpenMagnetics::DesignRequirements designRequirements;
         double inductance;
@@ -2644,6 +3018,7 @@ json simulate_four_switch_buck_boost_ideal_waveforms(json inputsJson) {
     SIM_WAVEFORM_CALL, SIM_OP_CALL, DIAG_BLOCK) \
 json func_name(json inputsJson) { \
     try { \
+        StateWriteLock stateLock; \
         bool isAdvanced = inputsJson.contains("desiredInductance"); \
         size_t numberOfPeriods = inputsJson.value("numberOfPeriods", 2); \
         size_t numberOfSteadyStatePeriods = inputsJson.value("numberOfSteadyStatePeriods", 5); \
@@ -2884,6 +3259,7 @@ DEFINE_SIMULATE_ISOLATED(simulate_isolated_buck_boost_ideal_waveforms, OpenMagne
 // ------ Weinberg (scalar turnsRatio + magnetizingInductance) ------
 json simulate_weinberg_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredInductance");
         size_t numberOfPeriods = inputsJson.value("numberOfPeriods", 2);
         size_t numberOfSteadyStatePeriods = inputsJson.value("numberOfSteadyStatePeriods", 5);
@@ -2987,6 +3363,7 @@ json simulate_weinberg_ideal_waveforms(json inputsJson) {
 // ------ LLC (special: not Advanced, just Llc with optional user overrides) ------
 json simulate_llc_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::Llc llcInputs(inputsJson);
         if (inputsJson.contains("desiredResonantInductance") && inputsJson["desiredResonantInductance"].is_number())
             llcInputs.set_user_resonant_inductance(inputsJson["desiredResonantInductance"].get<double>());
@@ -3056,6 +3433,7 @@ json simulate_llc_ideal_waveforms(json inputsJson) {
 // ------ CLLC ------
 json simulate_cllc_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::CllcConverter cllc(inputsJson);
         auto designRequirements = cllc.process_design_requirements();
         std::vector<double> turnsRatios;
@@ -3131,6 +3509,7 @@ json simulate_cllc_ideal_waveforms(json inputsJson) {
 // ------ CLLLC ------
 json simulate_clllc_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::Clllc model(inputsJson);
         auto designRequirements = model.process_design_requirements();
         std::vector<double> turnsRatios;
@@ -3230,6 +3609,7 @@ json simulate_clllc_ideal_waveforms(json inputsJson) {
 // ------ SRC ------
 json simulate_src_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredTurnsRatios") ||
                           inputsJson.contains("desiredResonantInductance") ||
                           inputsJson.contains("desiredResonantCapacitance");
@@ -3298,6 +3678,7 @@ json simulate_src_ideal_waveforms(json inputsJson) {
 // ------ DAB (always AdvancedDab) ------
 json simulate_dab_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::AdvancedDab dabInputs(inputsJson);
         auto inputs = dabInputs.process();
         auto designRequirements = inputs.get_design_requirements();
@@ -3361,6 +3742,7 @@ json simulate_dab_ideal_waveforms(json inputsJson) {
 #define DEFINE_SIMULATE_PHASE_SHIFTED(func_name, AdvancedType, diagKey) \
 json func_name(json inputsJson) { \
     try { \
+        StateWriteLock stateLock; \
         AdvancedType model(inputsJson); \
         auto inputs = model.process(); \
         auto designRequirements = inputs.get_design_requirements(); \
@@ -3432,6 +3814,7 @@ DEFINE_SIMULATE_PHASE_SHIFTED(simulate_pshb_ideal_waveforms, OpenMagnetics::Adva
 // ------ AHB (always AdvancedAsymmetricHalfBridge) ------
 json simulate_ahb_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::AdvancedAsymmetricHalfBridge ahbInputs(inputsJson);
         auto inputs = ahbInputs.process();
         auto designRequirements = inputs.get_design_requirements();
@@ -3525,6 +3908,7 @@ json simulate_ahb_ideal_waveforms(json inputsJson) {
 // ------ Vienna ------
 json simulate_vienna_ideal_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         bool isAdvanced = inputsJson.contains("desiredBoostInductance");
         std::unique_ptr<OpenMagnetics::Vienna> model;
         if (isAdvanced) model = std::make_unique<OpenMagnetics::AdvancedVienna>(inputsJson);
@@ -3569,6 +3953,7 @@ json simulate_vienna_ideal_waveforms(json inputsJson) {
 // ------ PFC ------
 json simulate_pfc_waveforms(json inputsJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::PowerFactorCorrection pfcInputs(inputsJson);
         double inductance;
         if (inputsJson.contains("inductance")) {
@@ -4098,15 +4483,83 @@ std::string generate_pfc_ngspice_circuit(json inputsJson, double dcResistance, d
 
 void register_converter_bindings(py::module& m) {
     m.def("process_converter", &process_converter,
-        "Process a converter topology specification to Inputs.",
-        py::arg("topology_name"), py::arg("converter_json"), py::arg("use_ngspice") = true);
+        "Process a converter topology specification to Inputs. With threads "
+        "other than 1, the input voltages of an analytical (use_ngspice=False) "
+        "flyback, buck or boost base spec are processed in parallel; ngspice "
+        "runs and every other spec are always processed sequentially.",
+        py::arg("topology_name"), py::arg("converter_json"), py::arg("use_ngspice") = true,
+        py::arg("threads") = 1,
+        py::call_guard<py::gil_scoped_release>());
     
+    // No call_guard: progress_callback is converted with the GIL held; the
+    // function releases it for the search.
     m.def("design_magnetics_from_converter", &design_magnetics_from_converter,
-        "Design magnetic components from a converter specification.",
+        "Design magnetic components from a converter specification. Runs with "
+        "the GIL released; the caller's settings are restored on return. "
+        "progress_callback, cancellation_token and interruptible behave as in "
+        "calculate_advised_magnetics(); with interruptible=True the cores are "
+        "searched in at most 16 steps and the call can stop between two of "
+        "them. "
+        "settings is an optional set_settings() dict applied for this call "
+        "only.",
         py::arg("topology_name"), py::arg("converter_json"),
         py::arg("max_results") = 1, py::arg("core_mode_json") = "available cores",
         py::arg("use_ngspice") = true, py::arg("weights_json") = nullptr,
-        py::arg("fast") = false);
+        py::arg("fast") = false,
+        py::arg("progress_callback") = py::none(), py::arg("cancellation_token") = nullptr,
+        py::arg("settings") = nullptr, py::arg("interruptible") = false);
+
+    // No call_guard here: the spec list and on_result need the GIL for
+    // conversion; the function releases it itself around the fan-out.
+    m.def("design_magnetics_from_converter_batch", &design_magnetics_from_converter_batch,
+        R"pbdoc(
+        Design magnetics for many converter specifications in one call.
+
+        Each spec is processed exactly as design_magnetics_from_converter()
+        would. The advisers work on MKF's global settings and databases, so
+        the specs run one after another on a native thread while the
+        calling thread hands finished items to on_result; only the
+        conversion of each item's designs to dicts uses several threads.
+        The batch holds the MKF state lock for its whole run: every item
+        sees the caller's settings, and they are restored once at the end.
+
+        Args:
+            specs: List of (topology_name, converter_json) tuples.
+            max_results: Designs to return per spec.
+            core_mode_json: "available cores" or "standard cores".
+            use_ngspice: Forwarded to topologies processed via process_converter.
+            weights_json: Optional per-filter weights, shared by all specs.
+            fast: Fast core-only adviser instead of the full winding+simulation one.
+            threads: Threads converting each item's designs to dicts; 0
+                     uses one per hardware thread. The specs themselves
+                     always run one after another.
+            on_result: Optional callable, invoked on the calling thread with each
+                       item as soon as it completes.
+            cancellation_token: Optional CancellationToken. Once cancelled,
+                                specs that have not started are skipped;
+                                the running one finishes.
+            settings: Optional settings dict (as set_settings() takes)
+                      applied to every spec; the global settings are
+                      restored at the end.
+
+        Returns:
+            List in spec order, which is also the order on_result sees.
+            Each item carries "index" (position in specs) and
+            "topologyName", plus either "data" (same as the single-spec
+            call) or "error". One failing spec does not abort the rest.
+            Skipped specs have "cancelled": True.
+
+        Example:
+            >>> specs = [("buck", buck_spec), ("llc", llc_spec)]
+            >>> for item in PyMKF.design_magnetics_from_converter_batch(specs, 3, "standard cores"):
+            ...     print(item["index"], "error" in item)
+        )pbdoc",
+        py::arg("specs"),
+        py::arg("max_results") = 1, py::arg("core_mode_json") = "available cores",
+        py::arg("use_ngspice") = true, py::arg("weights_json") = nullptr,
+        py::arg("fast") = false, py::arg("threads") = 0,
+        py::arg("on_result") = py::none(), py::arg("cancellation_token") = nullptr,
+        py::arg("settings") = nullptr);
     
     m.def("process_flyback", &process_flyback, "Process Flyback converter.", py::arg("flyback"));
     m.def("process_buck", &process_buck, "Process Buck converter.", py::arg("buck"));
@@ -4146,6 +4599,46 @@ void register_converter_bindings(py::module& m) {
         py::arg("bridge_simulation_mode") = std::string(""),
         py::arg("spice_config") = nlohmann::json::object());
 
+    m.def("run_ngspice_batch", &run_ngspice_batch_numpy,
+        R"pbdoc(
+        Run many ngspice decks concurrently in separate ngspice processes.
+
+        ngspice is not reentrant, so in-process simulations are serialised.
+        This runs each deck with `ngspice -b` in a process of its own, up to
+        `threads` at a time, and reads back the binary rawfile instead of
+        parsing printed text. Decks must use analysis cards (.tran, .ac, ...);
+        vectors written by a .control block are not collected.
+
+        Needs a standalone ngspice executable on PATH or at ngspice_path. The
+        wheel only bundles the ngspice shared library used by the
+        in-process paths, so install ngspice separately (e.g. apt install
+        ngspice, brew install ngspice, or the Windows binaries from the
+        ngspice site).
+
+        Args:
+            decks: SPICE decks, e.g. generate_ngspice_circuit(...)["netlist"].
+            threads: Concurrent ngspice processes; 0 (default) uses one per
+                hardware thread.
+            ngspice_path: ngspice executable name (looked up on PATH) or path.
+            keep_files: Keep the scratch directory with decks, rawfiles and logs.
+
+        Returns:
+            One dict per deck, in order: "index", "ok", "vectors" (name ->
+            NumPy array of the first plot), "plots" (every plot with "title",
+            "plotName" and "vectors") and, on failure, "error" and "log".
+
+        Raises:
+            RuntimeError: The ngspice executable cannot be found.
+
+        Example:
+            >>> decks = [PyMKF.generate_ngspice_circuit("flyback", spec, [n], lm)["netlist"]
+            ...          for spec in specs]
+            >>> runs = PyMKF.run_ngspice_batch(decks, threads=8)
+            >>> runs[0]["vectors"]["time"]
+        )pbdoc",
+        py::arg("decks"), py::arg("threads") = 0, py::arg("ngspice_path") = std::string("ngspice"),
+        py::arg("keep_files") = false);
+
     m.def("get_extra_components_inputs", &get_extra_components_inputs,
         "Return the design requirements for extra components a topology brings "
         "alongside its main magnetic — resonant tank Lr/Cr for LLC, snubber "
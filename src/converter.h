@@ -1,13 +1,18 @@
 #pragma once
 
 #include "common.h"
+#include "progress.h"
 
 namespace PyMKF {
 
-// Main generic converter processor
-json process_converter(const std::string& topologyName, json converterJson, bool useNgspice = true);
+// Main generic converter processor. threads != 1 processes the input
+// voltages of an analytical base spec in parallel (0: one per hardware
+// thread); the result is the same as the sequential run.
+json process_converter(const std::string& topologyName, json converterJson, bool useNgspice = true, int threads = 1);
 
-// Combined endpoint: converter -> magnetic designs
+// Combined endpoint: converter -> magnetic designs. Call with the GIL held;
+// it is released for the search. `settingsJson`, when not null, is applied
+// for the call only (see ScopedSettings).
 json design_magnetics_from_converter(
     const std::string& topologyName,
     json converterJson,
@@ -15,7 +20,26 @@ json design_magnetics_from_converter(
     json coreModeJson,
     bool useNgspice = true,
     json weightsJson = nullptr,
-    bool fast = false);
+    bool fast = false,
+    py::object progressCallback = py::none(),
+    std::shared_ptr<CancellationToken> cancellationToken = nullptr,
+    json settingsJson = nullptr,
+    bool interruptible = false);
+
+// Batch variant: many (topologyName, converterJson) specs designed one after
+// another on a native thread and streamed to `onResult` as they finish;
+// `threads` spreads the conversion of each item's results.
+json design_magnetics_from_converter_batch(
+    const std::vector<std::pair<std::string, json>>& specs,
+    int maxResults,
+    json coreModeJson,
+    bool useNgspice = true,
+    json weightsJson = nullptr,
+    bool fast = false,
+    int threads = 0,
+    py::object onResult = py::none(),
+    std::shared_ptr<CancellationToken> cancellationToken = nullptr,
+    json settingsJson = nullptr);
 
 // Per-topology thin wrappers (from .pyi stubs)
 json process_flyback(json flybackJson);
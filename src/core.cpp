@@ -1,4 +1,7 @@
 #include "core.h"
+#include "concurrency.h"
+#include "name_index.h"
+#include "snapshot.h"
 #include "physical_models/ComplexPermeability.h"
 #include <filesystem>
 
@@ -72,12 +75,15 @@ json get_core_shape_families() {
 }
 
 json get_core_material_names() {
-    auto materialNames = OpenMagnetics::get_core_material_names(std::nullopt);
-    json result = json::array();
-    for (auto elem : materialNames) {
-        result.push_back(elem);
-    }
-    return result;
+    return names_indexed(NameList::CORE_MATERIALS, [] {
+        StateReadLockWithDatabases stateLock;
+        auto materialNames = OpenMagnetics::get_core_material_names(std::nullopt);
+        json result = json::array();
+        for (auto elem : materialNames) {
+            result.push_back(elem);
+        }
+        return result;
+    });
 }
 
 json get_core_material_names_by_manufacturer(std::string manufacturerName) {
@@ -90,27 +96,60 @@ json get_core_material_names_by_manufacturer(std::string manufacturerName) {
 }
 
 json get_core_shape_names(bool includeToroidal) {
-    OpenMagnetics::settings.set_use_toroidal_cores(includeToroidal);
-    auto shapeNames = OpenMagnetics::get_core_shape_names();
-    json result = json::array();
-    for (auto elem : shapeNames) {
-        result.push_back(elem);
+    // The toroid flag is still written to the settings, as before, but only
+    // when it changes, so repeated lookups stay on the shared lock.
+    bool flagSet;
+    {
+        StateReadLock stateLock;
+        flagSet = OpenMagnetics::settings.get_use_toroidal_cores() == includeToroidal;
     }
-    return result;
+    if (!flagSet) {
+        StateWriteLock stateLock;
+        OpenMagnetics::settings.set_use_toroidal_cores(includeToroidal);
+    }
+    return names_indexed(includeToroidal ? NameList::CORE_SHAPES : NameList::CORE_SHAPES_WITHOUT_TOROIDS, [includeToroidal] {
+        // The list depends on the flag, so a miss sets it and builds under
+        // one exclusive section.
+        StateWriteLock stateLock;
+        load_missing_databases();
+        OpenMagnetics::settings.set_use_toroidal_cores(includeToroidal);
+        auto shapeNames = OpenMagnetics::get_core_shape_names();
+        json result = json::array();
+        for (auto elem : shapeNames) {
+            result.push_back(elem);
+        }
+        return result;
+    });
 }
 
 json find_core_material_by_name(json materialName) {
-    auto materialData = OpenMagnetics::find_core_material_by_name(materialName);
-    json result;
-    to_json(result, materialData);
-    return result;
+    if (materialName.is_string()) {
+        if (auto shared = find_in_shared_state(SnapshotSection::CORE_MATERIALS, materialName.get<std::string>())) {
+            return *shared;
+        }
+    }
+    return find_by_name_indexed(NameIndexDatabase::CORE_MATERIALS, materialName.dump(), [&] {
+        StateReadLockWithDatabases stateLock;
+        auto materialData = OpenMagnetics::find_core_material_by_name(materialName);
+        json result;
+        to_json(result, materialData);
+        return result;
+    });
 }
 
 json find_core_shape_by_name(json shapeName) {
-    auto shapeData = OpenMagnetics::find_core_shape_by_name(shapeName);
-    json result;
-    to_json(result, shapeData);
-    return result;
+    if (shapeName.is_string()) {
+        if (auto shared = find_in_shared_state(SnapshotSection::CORE_SHAPES, shapeName.get<std::string>())) {
+            return *shared;
+        }
+    }
+    return find_by_name_indexed(NameIndexDatabase::CORE_SHAPES, shapeName.dump(), [&] {
+        StateReadLockWithDatabases stateLock;
+        auto shapeData = OpenMagnetics::find_core_shape_by_name(shapeName);
+        json result;
+        to_json(result, shapeData);
+        return result;
+    });
 }
 
 json calculate_core_processed_description(json coreDataJson) {
@@ -748,7 +787,8 @@ void register_core_bindings(py::module& m) {
         Returns:
             JSON array of shape name strings (e.g., "E 42/21/15", "ETD 49").
         )pbdoc",
-        py::arg("include_toroidal"));
+        py::arg("include_toroidal"),
+        py::call_guard<py::gil_scoped_release>());
 
     // Lookup functions
     m.def("find_core_material_by_name", &find_core_material_by_name,
@@ -761,7 +801,8 @@ void register_core_bindings(py::module& m) {
         Returns:
             JSON CoreMaterial object with full specification, or error.
         )pbdoc",
-        py::arg("name"));
+        py::arg("name"),
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("find_core_shape_by_name", &find_core_shape_by_name,
         R"pbdoc(
@@ -773,7 +814,8 @@ void register_core_bindings(py::module& m) {
         Returns:
             JSON CoreShape object with full dimensional data, or error.
         )pbdoc",
-        py::arg("name"));
+        py::arg("name"),
+        py::call_guard<py::gil_scoped_release>());
 
     // Core calculations
     m.def("calculate_core_data", &calculate_core_data,
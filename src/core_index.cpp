@@ -0,0 +1,345 @@
+#include "core_index.h"
+#include "concurrency.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+
+namespace PyMKF {
+
+namespace {
+
+constexpr char coreIndexMagic[8] = {'P', 'Y', 'O', 'M', 'C', 'I', 'D', 'X'};
+
+// Saturation is read at 100 °C: the hot end of a ferrite's datasheet and the
+// conservative side for a pre-filter that must never drop a valid candidate.
+constexpr double saturationReferenceTemperature = 100;
+
+struct CoreIndexHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t columnCount;
+    uint64_t count;
+    uint64_t fingerprint;
+    uint64_t namesBytes;
+};
+static_assert(sizeof(CoreIndexHeader) == 40, "columns must start 8-byte aligned");
+
+std::optional<CoreFeatureIndex> coreFeatureIndex;
+
+uint64_t fnv1a(uint64_t hash, std::string_view text) {
+    for (unsigned char character : text) {
+        hash ^= character;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string core_name(const OpenMagnetics::Core& core) {
+    return core.get_name().value_or("");
+}
+
+constexpr uint64_t fnv1aOffset = 14695981039346656037ull;
+
+// Hash of everything the features are computed from: each core's name,
+// functional and processed description and, for a material referenced by
+// name, the material as the database holds it, so a Steinmetz refit or a
+// reloaded catalogue invalidates the index even when the names stay the
+// same. Cores are hashed on the pool; the per-row hashes are combined in
+// database order.
+uint64_t core_database_fingerprint() {
+    const size_t count = OpenMagnetics::coreDatabase.size();
+    std::vector<uint64_t> rowHashes(count);
+    std::vector<std::string> materialNames(count);
+    parallel_for(count, resolve_thread_count(0, count), [&](size_t row) {
+        auto& core = OpenMagnetics::coreDatabase[row];
+        uint64_t hash = fnv1a(fnv1aOffset, core_name(core));
+        json functionalDescription;
+        to_json(functionalDescription, core.get_functional_description());
+        hash = fnv1a(hash, functionalDescription.dump());
+        if (core.get_processed_description()) {
+            json processed;
+            to_json(processed, core.get_processed_description().value());
+            hash = fnv1a(hash, processed.dump());
+        }
+        if (functionalDescription.contains("material") && functionalDescription["material"].is_string()) {
+            materialNames[row] = functionalDescription["material"].get<std::string>();
+        }
+        rowHashes[row] = hash;
+    });
+
+    std::map<std::string, uint64_t> materialHashes;
+    uint64_t hash = fnv1aOffset;
+    for (size_t row = 0; row < count; ++row) {
+        hash = fnv1a(hash, std::string_view(reinterpret_cast<const char*>(&rowHashes[row]), sizeof(uint64_t)));
+        if (materialNames[row].empty()) {
+            continue;
+        }
+        auto [materialHash, inserted] = materialHashes.try_emplace(materialNames[row], fnv1aOffset);
+        if (inserted) {
+            auto material = OpenMagnetics::coreMaterialDatabase.find(materialNames[row]);
+            if (material != OpenMagnetics::coreMaterialDatabase.end()) {
+                json materialJson;
+                to_json(materialJson, material->second);
+                materialHash->second = fnv1a(fnv1aOffset, materialJson.dump());
+            }
+        }
+        hash = fnv1a(hash, std::string_view(reinterpret_cast<const char*>(&materialHash->second), sizeof(uint64_t)));
+    }
+    return hash;
+}
+
+double json_number_or_nan(const json& node) {
+    return node.is_number() ? node.get<double>() : std::numeric_limits<double>::quiet_NaN();
+}
+
+std::array<double, coreIndexColumnCount> extract_core_features(OpenMagnetics::Core core) {
+    std::array<double, coreIndexColumnCount> row;
+    row.fill(std::numeric_limits<double>::quiet_NaN());
+    auto set = [&](CoreIndexColumn column, double value) { row[static_cast<size_t>(column)] = value; };
+
+    if (core.get_processed_description()) {
+        json processed;
+        to_json(processed, core.get_processed_description().value());
+        if (processed.contains("effectiveParameters")) {
+            set(CoreIndexColumn::EFFECTIVE_AREA, json_number_or_nan(processed["effectiveParameters"].value("effectiveArea", json())));
+            set(CoreIndexColumn::EFFECTIVE_VOLUME, json_number_or_nan(processed["effectiveParameters"].value("effectiveVolume", json())));
+        }
+        if (processed.contains("windingWindows") && processed["windingWindows"].is_array()) {
+            double windowArea = 0;
+            for (auto& windingWindow : processed["windingWindows"]) {
+                windowArea += windingWindow.value("area", 0.0);
+            }
+            if (windowArea > 0) {
+                set(CoreIndexColumn::WINDING_WINDOW_AREA, windowArea);
+            }
+        }
+        double width = json_number_or_nan(processed.value("width", json()));
+        double height = json_number_or_nan(processed.value("height", json()));
+        double depth = json_number_or_nan(processed.value("depth", json()));
+        set(CoreIndexColumn::VOLUME, width * height * depth);
+    }
+
+    try {
+        set(CoreIndexColumn::MAGNETIC_FLUX_DENSITY_SATURATION,
+            core.get_magnetic_flux_density_saturation(saturationReferenceTemperature, false));
+    }
+    catch (const std::exception&) {}
+
+    try {
+        json functionalDescription;
+        to_json(functionalDescription, core.get_functional_description());
+        auto steinmetz = OpenMagnetics::CoreLossesModel::get_steinmetz_coefficients(
+            functionalDescription["material"], OpenMagnetics::defaults.coreAdviserFrequencyReference);
+        json steinmetzJson;
+        to_json(steinmetzJson, steinmetz);
+        set(CoreIndexColumn::STEINMETZ_K, json_number_or_nan(steinmetzJson.value("k", json())));
+        set(CoreIndexColumn::STEINMETZ_ALPHA, json_number_or_nan(steinmetzJson.value("alpha", json())));
+        set(CoreIndexColumn::STEINMETZ_BETA, json_number_or_nan(steinmetzJson.value("beta", json())));
+    }
+    catch (const std::exception&) {}
+
+    return row;
+}
+
+} // namespace
+
+const std::array<std::string, coreIndexColumnCount>& core_index_column_names() {
+    static const std::array<std::string, coreIndexColumnCount> names = {
+        "effectiveArea",
+        "effectiveVolume",
+        "windingWindowArea",
+        "magneticFluxDensitySaturation",
+        "volume",
+        "steinmetzK",
+        "steinmetzAlpha",
+        "steinmetzBeta",
+    };
+    return names;
+}
+
+CoreFeatureIndex CoreFeatureIndex::build(int threads) {
+    // The features look up materials and shapes; loading them here keeps
+    // the workers below from triggering MKF's lazy loads concurrently.
+    load_missing_databases();
+    CoreFeatureIndex index;
+    index._count = OpenMagnetics::coreDatabase.size();
+    index._fingerprint = core_database_fingerprint();
+    index._ownedColumns.assign(index._count * coreIndexColumnCount, std::numeric_limits<double>::quiet_NaN());
+    index._names.reserve(index._count);
+    for (auto& core : OpenMagnetics::coreDatabase) {
+        index._names.push_back(core_name(core));
+    }
+
+    // Features are independent per core and each row writes only its own
+    // cells, so rows are computed on the shared pool.
+    const size_t count = index._count;
+    double* columns = index._ownedColumns.data();
+    parallel_for(count, resolve_thread_count(threads, count), [&](size_t row) {
+        auto features = extract_core_features(OpenMagnetics::coreDatabase[row]);
+        for (size_t column = 0; column < coreIndexColumnCount; ++column) {
+            columns[column * count + row] = features[column];
+        }
+    });
+
+    index._columns = index._ownedColumns.data();
+    return index;
+}
+
+std::optional<CoreFeatureIndex> CoreFeatureIndex::open(const std::filesystem::path& path) {
+    if (!std::filesystem::exists(path)) {
+        return std::nullopt;
+    }
+    CoreFeatureIndex index;
+    index._file = MappedFile(path);
+
+    CoreIndexHeader header;
+    if (index._file.size() < sizeof(header)) {
+        return std::nullopt;
+    }
+    std::memcpy(&header, index._file.data(), sizeof(header));
+    if (std::memcmp(header.magic, coreIndexMagic, sizeof(coreIndexMagic)) != 0 ||
+        header.version != FORMAT_VERSION || header.columnCount != coreIndexColumnCount) {
+        return std::nullopt;
+    }
+    const size_t columnsBytes = header.count * coreIndexColumnCount * sizeof(double);
+    if (index._file.size() != sizeof(header) + columnsBytes + header.namesBytes) {
+        return std::nullopt;
+    }
+
+    index._count = header.count;
+    index._fingerprint = header.fingerprint;
+    index._columns = reinterpret_cast<const double*>(index._file.data() + sizeof(header));
+
+    std::string_view names(index._file.data() + sizeof(header) + columnsBytes, header.namesBytes);
+    index._names.reserve(index._count);
+    while (!names.empty()) {
+        size_t end = names.find('\n');
+        index._names.emplace_back(names.substr(0, end));
+        names.remove_prefix(end == std::string_view::npos ? names.size() : end + 1);
+    }
+    if (index._names.size() != index._count) {
+        return std::nullopt;
+    }
+    return index;
+}
+
+void CoreFeatureIndex::save(const std::filesystem::path& path) const {
+    std::string names;
+    for (auto& name : _names) {
+        names += name;
+        names += '\n';
+    }
+
+    CoreIndexHeader header;
+    std::memcpy(header.magic, coreIndexMagic, sizeof(coreIndexMagic));
+    header.version = FORMAT_VERSION;
+    header.columnCount = coreIndexColumnCount;
+    header.count = _count;
+    header.fingerprint = _fingerprint;
+    header.namesBytes = names.size();
+
+    // Write-then-rename so a worker starting concurrently never maps a
+    // half-written file.
+    auto temporaryPath = path;
+    temporaryPath += ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("Cannot write core index to " + temporaryPath.string());
+        }
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(_columns), static_cast<std::streamsize>(_count * coreIndexColumnCount * sizeof(double)));
+        out.write(names.data(), static_cast<std::streamsize>(names.size()));
+    }
+    std::filesystem::rename(temporaryPath, path);
+}
+
+bool CoreFeatureIndex::matches_core_database() const {
+    return _count == OpenMagnetics::coreDatabase.size() && _fingerprint == core_database_fingerprint();
+}
+
+std::vector<size_t> CoreFeatureIndex::range_scan(const std::vector<CoreIndexRange>& ranges) const {
+    // Branch-free masks so each pass over a column vectorises; NaN compares
+    // false both ways and therefore survives every range.
+    std::vector<uint8_t> keep(_count, 1);
+    for (auto& range : ranges) {
+        const double* values = column(range.column);
+        const double minimum = range.minimum;
+        const double maximum = range.maximum;
+        for (size_t row = 0; row < _count; ++row) {
+            keep[row] &= static_cast<uint8_t>(!(values[row] < minimum) & !(values[row] > maximum));
+        }
+    }
+
+    std::vector<size_t> rows;
+    for (size_t row = 0; row < _count; ++row) {
+        if (keep[row]) {
+            rows.push_back(row);
+        }
+    }
+    return rows;
+}
+
+std::vector<CoreIndexRange> parse_core_index_ranges(const json& rangesJson) {
+    std::vector<CoreIndexRange> ranges;
+    if (rangesJson.is_null()) {
+        return ranges;
+    }
+    auto& names = core_index_column_names();
+    for (auto& [key, bounds] : rangesJson.items()) {
+        auto it = std::find(names.begin(), names.end(), key);
+        if (it == names.end()) {
+            throw std::invalid_argument("Unknown core index column: " + key);
+        }
+        if (!bounds.is_array() || bounds.size() != 2) {
+            throw std::invalid_argument("Range for " + key + " must be [minimum, maximum]");
+        }
+        CoreIndexRange range;
+        range.column = static_cast<CoreIndexColumn>(std::distance(names.begin(), it));
+        range.minimum = bounds[0].is_null() ? -std::numeric_limits<double>::infinity() : bounds[0].get<double>();
+        range.maximum = bounds[1].is_null() ? std::numeric_limits<double>::infinity() : bounds[1].get<double>();
+        ranges.push_back(range);
+    }
+    return ranges;
+}
+
+const CoreFeatureIndex* get_core_feature_index() {
+    return coreFeatureIndex ? &coreFeatureIndex.value() : nullptr;
+}
+
+void set_core_feature_index(std::optional<CoreFeatureIndex> index) {
+    coreFeatureIndex = std::move(index);
+}
+
+void invalidate_core_feature_index() {
+    coreFeatureIndex.reset();
+}
+
+const CoreFeatureIndex& ensure_core_feature_index() {
+    // The fingerprint covers the referenced materials, so they must be
+    // loaded for it to compare equal to the one build() records.
+    load_missing_databases();
+    if (!coreFeatureIndex || !coreFeatureIndex->matches_core_database()) {
+        coreFeatureIndex = CoreFeatureIndex::build();
+    }
+    return coreFeatureIndex.value();
+}
+
+ScopedCoreDatabaseSubset::ScopedCoreDatabaseSubset(const std::vector<size_t>& rows)
+    : _fullDatabase(std::move(OpenMagnetics::coreDatabase)) {
+    OpenMagnetics::coreDatabase.clear();
+    for (size_t row : rows) {
+        OpenMagnetics::coreDatabase.push_back(_fullDatabase[row]);
+    }
+}
+
+ScopedCoreDatabaseSubset::~ScopedCoreDatabaseSubset() {
+    OpenMagnetics::coreDatabase = std::move(_fullDatabase);
+}
+
+} // namespace PyMKF
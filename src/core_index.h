@@ -0,0 +1,118 @@
+#pragma once
+
+#include "common.h"
+#include "mapped_file.h"
+
+#include <array>
+#include <optional>
+
+namespace PyMKF {
+
+// ─── Columnar core-candidate index ──────────────────────────────────────────
+// One row per entry of OpenMagnetics::coreDatabase, one contiguous column per
+// scalar feature (SoA), so the adviser pre-filter is a handful of tight range
+// scans over doubles instead of a walk over fully-built Core objects.
+//
+// Built by load_cores(..., index_path) and written next to the caller's data;
+// on a warm restart the same call mmaps the file instead of recomputing. The
+// file is tied to the database it was built from by a fingerprint of the
+// cores' serialised descriptions in load order and of the materials they
+// name, so a stale index (different stock filter, toroids toggled, new
+// catalogue, refitted material) is rebuilt rather than trusted.
+//
+// Missing features (no Steinmetz data, unprocessed shape, ...) are stored as
+// NaN and never excluded by a range: the pre-filter only drops cores it can
+// prove are out of range.
+enum class CoreIndexColumn : size_t {
+    EFFECTIVE_AREA,
+    EFFECTIVE_VOLUME,
+    WINDING_WINDOW_AREA,
+    MAGNETIC_FLUX_DENSITY_SATURATION,
+    VOLUME,
+    STEINMETZ_K,
+    STEINMETZ_ALPHA,
+    STEINMETZ_BETA,
+    COUNT
+};
+
+constexpr size_t coreIndexColumnCount = static_cast<size_t>(CoreIndexColumn::COUNT);
+
+// JSON key of each column, as accepted by query_core_index / prefilter_json.
+const std::array<std::string, coreIndexColumnCount>& core_index_column_names();
+
+struct CoreIndexRange {
+    CoreIndexColumn column;
+    double minimum;
+    double maximum;
+};
+
+class CoreFeatureIndex {
+  public:
+    static constexpr uint32_t FORMAT_VERSION = 2;
+
+    // Computes every feature for the cores currently in coreDatabase, loading
+    // any missing material or shape database first. Must be called under a
+    // StateWriteLock.
+    static CoreFeatureIndex build(int threads = 0);
+
+    // Maps an index previously written by save(). Returns nullopt when the
+    // file is missing, truncated or from another format version.
+    static std::optional<CoreFeatureIndex> open(const std::filesystem::path& path);
+
+    void save(const std::filesystem::path& path) const;
+
+    size_t size() const { return _count; }
+    bool is_mapped() const { return _file.is_open(); }
+    uint64_t fingerprint() const { return _fingerprint; }
+    const std::string& name(size_t row) const { return _names[row]; }
+    const double* column(CoreIndexColumn column) const {
+        return _columns + static_cast<size_t>(column) * _count;
+    }
+
+    // True when this index was built from the cores now in coreDatabase and
+    // the materials they reference. Serialises every core, so it costs about
+    // as much as one pass of to_json over the database.
+    bool matches_core_database() const;
+
+    // Rows (coreDatabase positions) whose features lie inside every range.
+    std::vector<size_t> range_scan(const std::vector<CoreIndexRange>& ranges) const;
+
+  private:
+    std::vector<double> _ownedColumns;
+    MappedFile _file;
+    const double* _columns = nullptr;
+    size_t _count = 0;
+    uint64_t _fingerprint = 0;
+    std::vector<std::string> _names;
+};
+
+// Parses {"effectiveArea": [min, max], "volume": [null, 1e-5], ...}; a null
+// bound is open. Throws std::invalid_argument on unknown keys.
+std::vector<CoreIndexRange> parse_core_index_ranges(const json& rangesJson);
+
+// Process-wide index over coreDatabase. All three must be called under the
+// state lock (read for get, write for the others).
+const CoreFeatureIndex* get_core_feature_index();
+void set_core_feature_index(std::optional<CoreFeatureIndex> index);
+void invalidate_core_feature_index();
+
+// Builds the index in memory if there is none (or it is stale) and returns it.
+// Requires a StateWriteLock.
+const CoreFeatureIndex& ensure_core_feature_index();
+
+// Temporarily narrows coreDatabase to `rows` (positions from range_scan) for
+// the lifetime of the object, restoring the full database on destruction, so
+// the MKF advisers only ever construct and score the surviving candidates.
+// Requires a StateWriteLock for its whole lifetime.
+class ScopedCoreDatabaseSubset {
+  public:
+    explicit ScopedCoreDatabaseSubset(const std::vector<size_t>& rows);
+    ~ScopedCoreDatabaseSubset();
+    ScopedCoreDatabaseSubset(const ScopedCoreDatabaseSubset&) = delete;
+    ScopedCoreDatabaseSubset& operator=(const ScopedCoreDatabaseSubset&) = delete;
+
+  private:
+    decltype(OpenMagnetics::coreDatabase) _fullDatabase;
+};
+
+} // namespace PyMKF
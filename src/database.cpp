@@ -1,78 +1,108 @@
 #include "database.h"
-#include <sstream>
+#include "concurrency.h"
+#include "core_index.h"
+#include "logging.h"
+#include "losses.h"
+#include "name_index.h"
+#include "ndjson.h"
+#include "simulation.h"
+#include "thread_pool.h"
+#include "wire_index.h"
 
 namespace PyMKF {
 
 // Definition of the masDatabase variable (declared as extern in common.h)
 std::map<std::string, OpenMagnetics::Mas> masDatabase;
 
+void invalidate_database_views() {
+    clear_simulation_cache();
+    clear_field_solution_cache();
+    invalidate_name_indexes();
+    invalidate_core_feature_index();
+    invalidate_wire_index();
+}
+
 void load_databases(json databasesJson) {
+    StateWriteLock stateLock;
+    invalidate_database_views();
     OpenMagnetics::load_databases(databasesJson, true);
 }
 
 std::string read_databases(std::string path, bool addInternalData) {
     try {
-        auto masPath = std::filesystem::path{path};
+        StateWriteLock stateLock;
+        invalidate_database_views();
+        const std::filesystem::path masPath{path};
+        const std::vector<std::pair<std::string, std::string>> databaseFiles = {
+            {"coreMaterials", "core_materials.ndjson"},
+            {"coreShapes", "core_shapes.ndjson"},
+            {"wires", "wires.ndjson"},
+            {"bobbins", "bobbins.ndjson"},
+            {"insulationMaterials", "insulation_materials.ndjson"},
+            {"wireMaterials", "wire_materials.ndjson"},
+        };
         json data;
-        std::string line;
-        {
-            data["coreMaterials"] = json();
-            std::ifstream coreMaterials(masPath.append("core_materials.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["coreMaterials"][jf["name"]] = jf;
-            }
-        }
-        {
-            data["coreShapes"] = json();
-            std::ifstream coreMaterials(masPath.append("core_shapes.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["coreShapes"][jf["name"]] = jf;
+        for (auto& [databaseName, fileName] : databaseFiles) {
+            data[databaseName] = json();
+            for (auto& record : parse_ndjson_file(masPath / fileName)) {
+                std::string name = record["name"];
+                data[databaseName][name] = std::move(record);
             }
         }
-        {
-            data["wires"] = json();
-            std::ifstream coreMaterials(masPath.append("wires.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["wires"][jf["name"]] = jf;
+        OpenMagnetics::load_databases(data, true, addInternalData);
+        return "0";
+    }
+    catch (const std::exception &exc) {
+        return std::string{exc.what()};
+    }
+}
+
+// Builds Magnetic objects from parsed NDJSON records on the native pool and
+// loads them into magneticsCache in file order. By default the first record
+// that fails to build stops the load with "record <n>: <reason>", leaving the
+// records before it loaded as the serial loop did; with skipInvalid it is
+// skipped and logged as a warning instead. Must be called under a
+// StateWriteLock.
+static size_t load_magnetics_into_cache(const std::vector<json>& records, bool expand, bool skipInvalid) {
+    // Everything MKF would otherwise load lazily while building or
+    // autocompleting a record is in place before the workers start, so they
+    // only read the databases.
+    load_missing_databases();
+    std::vector<std::optional<OpenMagnetics::Magnetic>> magnetics(records.size());
+    std::vector<std::string> errors(records.size());
+    parallel_for(records.size(), resolve_thread_count(0, records.size()), [&](size_t index) {
+        try {
+            OpenMagnetics::Magnetic magnetic(records[index]);
+            if (expand) {
+                magnetic = OpenMagnetics::magnetic_autocomplete(magnetic);
             }
-        }
-        {
-            data["bobbins"] = json();
-            std::ifstream coreMaterials(masPath.append("bobbins.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["bobbins"][jf["name"]] = jf;
+            if (!magnetic.get_manufacturer_info() || !magnetic.get_manufacturer_info()->get_reference()) {
+                throw std::runtime_error("magnetic has no manufacturerInfo.reference");
             }
+            magnetics[index] = std::move(magnetic);
         }
-        {
-            data["insulationMaterials"] = json();
-            std::ifstream coreMaterials(masPath.append("insulation_materials.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["insulationMaterials"][jf["name"]] = jf;
-            }
+        catch (const std::exception& exc) {
+            errors[index] = exc.what();
         }
-        {
-            data["wireMaterials"] = json();
-            std::ifstream coreMaterials(masPath.append("wire_materials.ndjson"));
-            while (getline (coreMaterials, line)) {
-                json jf = json::parse(line);
-                data["wireMaterials"][jf["name"]] = jf;
+    });
+
+    for (size_t index = 0; index < magnetics.size(); ++index) {
+        if (!magnetics[index]) {
+            if (!skipInvalid) {
+                throw std::runtime_error("record " + std::to_string(index + 1) + ": " + errors[index]);
             }
+            log_message("WARNING", "record " + std::to_string(index + 1) + " skipped: " + errors[index], "load_magnetics");
+            continue;
         }
-        OpenMagnetics::load_databases(data, true, addInternalData);
-        return "0";
-    }
-    catch (const std::exception &exc) {
-        return std::string{exc.what()};
+        std::string key = magnetics[index]->get_manufacturer_info()->get_reference().value();
+        OpenMagnetics::magneticsCache.load(key, *magnetics[index]);
     }
+    return OpenMagnetics::magneticsCache.size();
 }
 
 std::string load_mas(std::string key, json masJson, bool expand) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::Mas mas(masJson);
         if (expand) {
             mas.set_magnetic(OpenMagnetics::magnetic_autocomplete(mas.get_mutable_magnetic()));
@@ -88,6 +118,7 @@ std::string load_mas(std::string key, json masJson, bool expand) {
 
 std::string load_magnetic(std::string key, json magneticJson, bool expand) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         if (expand) {
             magnetic = OpenMagnetics::magnetic_autocomplete(magnetic);
@@ -104,6 +135,7 @@ std::string load_magnetic(std::string key, json magneticJson, bool expand) {
 
 std::string load_magnetics(std::string keys, json magneticJsons, bool expand) {
     try {
+        StateWriteLock stateLock;
         json keysJson = json::parse(keys);
         for (size_t magneticIndex = 0; magneticIndex < magneticJsons.size(); magneticIndex++) {
             OpenMagnetics::Magnetic magnetic(magneticJsons[magneticIndex]);
@@ -122,12 +154,18 @@ std::string load_magnetics(std::string keys, json magneticJsons, bool expand) {
 }
 
 json read_mas(std::string key) {
+    // find() rather than operator[]: this runs under the shared lock and must
+    // not insert. An unknown key still yields an empty Mas, as before.
+    StateReadLock stateLock;
     json result;
-    to_json(result, masDatabase[key]);
+    auto it = masDatabase.find(key);
+    to_json(result, it != masDatabase.end() ? it->second : OpenMagnetics::Mas());
     return result;
 }
 
 size_t load_core_materials(std::string fileToLoad) {
+    StateWriteLock stateLock;
+    invalidate_database_views();
     if (fileToLoad != "") {
         OpenMagnetics::load_core_materials(fileToLoad);
     }
@@ -138,6 +176,8 @@ size_t load_core_materials(std::string fileToLoad) {
 }
 
 size_t load_core_shapes(std::string fileToLoad) {
+    StateWriteLock stateLock;
+    invalidate_database_views();
     if (fileToLoad != "") {
         OpenMagnetics::load_core_shapes(true, fileToLoad);
     }
@@ -148,6 +188,8 @@ size_t load_core_shapes(std::string fileToLoad) {
 }
 
 size_t load_wires(std::string fileToLoad) {
+    StateWriteLock stateLock;
+    invalidate_database_views();
     if (fileToLoad != "") {
         OpenMagnetics::load_wires(fileToLoad);
     }
@@ -158,37 +200,30 @@ size_t load_wires(std::string fileToLoad) {
 }
 
 void clear_databases() {
+    StateWriteLock stateLock;
     OpenMagnetics::clear_databases();
+    invalidate_database_views();
 }
 
 bool is_core_material_database_empty() {
+    StateReadLock stateLock;
     return OpenMagnetics::coreMaterialDatabase.size() == 0;
 }
 
 bool is_core_shape_database_empty() {
+    StateReadLock stateLock;
     return OpenMagnetics::coreShapeDatabase.size() == 0;
 }
 
 bool is_wire_database_empty() {
+    StateReadLock stateLock;
     return OpenMagnetics::wireDatabase.size() == 0;
 }
 
-std::string load_magnetics_from_file(std::string path, bool expand) {
+std::string load_magnetics_from_file(std::string path, bool expand, bool skipInvalid) {
     try {
-        std::ifstream in(path);
-        if (in) {
-            std::string line;
-            while (getline(in, line)) {
-                json jf = json::parse(line);
-                OpenMagnetics::Magnetic magnetic(jf);
-                if (expand) {
-                    magnetic = OpenMagnetics::magnetic_autocomplete(magnetic);
-                }
-                std::string key = magnetic.get_manufacturer_info()->get_reference().value();
-                OpenMagnetics::magneticsCache.load(key, magnetic);
-            }
-        }
-        return std::to_string(OpenMagnetics::magneticsCache.size());
+        StateWriteLock stateLock;
+        return std::to_string(load_magnetics_into_cache(parse_ndjson_file(path), expand, skipInvalid));
     }
     catch (const std::exception &exc) {
         return std::string{exc.what()};
@@ -197,6 +232,7 @@ std::string load_magnetics_from_file(std::string path, bool expand) {
 
 std::string clear_magnetic_cache() {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::magneticsCache.clear();
         return std::to_string(OpenMagnetics::magneticsCache.size());
     }
@@ -205,8 +241,9 @@ std::string clear_magnetic_cache() {
     }
 }
 
-json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInStock) {
+json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInStock, json indexPathJson) {
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::settings.set_use_toroidal_cores(includeToroids);
         OpenMagnetics::settings.set_use_only_cores_in_stock(useOnlyCoresInStock);
 
@@ -220,6 +257,24 @@ json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInSto
 
         json result;
         result["count"] = OpenMagnetics::coreDatabase.size();
+
+        // Feature index for the adviser pre-filter: map it if the file on
+        // disk was built from exactly these cores, otherwise build and write.
+        invalidate_database_views();
+        if (!indexPathJson.is_null() && indexPathJson.is_string()) {
+            std::filesystem::path indexPath = indexPathJson.get<std::string>();
+            load_missing_databases();
+            auto index = CoreFeatureIndex::open(indexPath);
+            if (index && index->matches_core_database()) {
+                result["index"] = "mapped";
+            }
+            else {
+                index = CoreFeatureIndex::build();
+                index->save(indexPath);
+                result["index"] = "built";
+            }
+            set_core_feature_index(std::move(index));
+        }
         return result;
     }
     catch (const std::exception &exc) {
@@ -230,22 +285,36 @@ json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInSto
 }
 
 void clear_loaded_cores() {
+    StateWriteLock stateLock;
     OpenMagnetics::clear_loaded_cores();
+    invalidate_database_views();
 }
 
-std::string load_magnetics_from_string(std::string jsonText) {
+json query_core_index(json rangesJson) {
     try {
-        std::istringstream in(jsonText);
-        std::string line;
-        while (getline(in, line)) {
-            if (line.empty()) continue;
-            json jf = json::parse(line);
-            OpenMagnetics::Magnetic magnetic(jf);
-            magnetic = OpenMagnetics::magnetic_autocomplete(magnetic);
-            std::string key = magnetic.get_manufacturer_info()->get_reference().value();
-            OpenMagnetics::magneticsCache.load(key, magnetic);
+        StateWriteLock stateLock;
+        auto ranges = parse_core_index_ranges(rangesJson);
+        auto& index = ensure_core_feature_index();
+        json result;
+        result["names"] = json::array();
+        for (size_t row : index.range_scan(ranges)) {
+            result["names"].push_back(index.name(row));
         }
-        return std::to_string(OpenMagnetics::magneticsCache.size());
+        result["count"] = result["names"].size();
+        result["total"] = index.size();
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+std::string load_magnetics_from_string(std::string jsonText, bool skipInvalid) {
+    try {
+        StateWriteLock stateLock;
+        return std::to_string(load_magnetics_into_cache(parse_ndjson(jsonText, "magnetics"), true, skipInvalid));
     }
     catch (const std::exception &exc) {
         return std::string{exc.what()};
@@ -253,8 +322,10 @@ std::string load_magnetics_from_string(std::string jsonText) {
 }
 
 void register_database_bindings(py::module& m) {
-    m.def("load_databases", &load_databases, "Load all databases from JSON");
-    m.def("read_databases", &read_databases, "Read databases from file path");
+    m.def("load_databases", &load_databases, "Load all databases from JSON",
+        py::call_guard<py::gil_scoped_release>());
+    m.def("read_databases", &read_databases, "Read databases from file path",
+        py::call_guard<py::gil_scoped_release>());
     m.def("load_mas", &load_mas, "Load a MAS (Magnetic Agnostic Structure) object");
     m.def("load_magnetic", &load_magnetic, "Load a magnetic component");
     m.def("load_magnetics", &load_magnetics, "Load multiple magnetic components");
@@ -266,8 +337,11 @@ void register_database_bindings(py::module& m) {
     m.def("is_core_material_database_empty", &is_core_material_database_empty, "Check if core material database is empty");
     m.def("is_core_shape_database_empty", &is_core_shape_database_empty, "Check if core shape database is empty");
     m.def("is_wire_database_empty", &is_wire_database_empty, "Check if wire database is empty");
-    m.def("load_magnetics_from_file", &load_magnetics_from_file, "Load magnetic components from file");
+    m.def("load_magnetics_from_file", &load_magnetics_from_file, "Load magnetic components from file",
+        py::arg("path"), py::arg("expand"), py::arg("skip_invalid") = false,
+        py::call_guard<py::gil_scoped_release>());
     m.def("clear_magnetic_cache", &clear_magnetic_cache, "Clear cached magnetic calculations");
+    m.def("clear_simulation_cache", &clear_simulation_cache, "Clear cached simulate() results; counters are kept");
 
     m.def("load_cores", &load_cores,
         R"pbdoc(
@@ -277,11 +351,39 @@ void register_database_bindings(py::module& m) {
             file_to_load_json: JSON string with file path, or null for defaults.
             include_toroids: Whether to include toroidal cores.
             use_only_cores_in_stock: Whether to limit to in-stock cores.
+            index_path: Optional path of the core feature index used by the
+                        adviser pre-filter. If the file was built from the same
+                        cores it is memory-mapped, otherwise it is rebuilt and
+                        written there.
+
+        Returns:
+            JSON object with count of loaded cores, plus "index": "mapped" or
+            "built" when index_path is given.
+        )pbdoc",
+        py::arg("file_to_load_json"), py::arg("include_toroids"), py::arg("use_only_cores_in_stock"),
+        py::arg("index_path") = nullptr,
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("query_core_index", &query_core_index,
+        R"pbdoc(
+        Range-scan the core feature index.
+
+        Builds the index in memory first if load_cores() was not given an
+        index_path. Cores with a missing feature are never excluded.
+
+        Args:
+            ranges_json: {column: [minimum, maximum]}; null bounds are open.
+                         Columns: effectiveArea, effectiveVolume,
+                         windingWindowArea, magneticFluxDensitySaturation
+                         (at 100 C), volume (bounding box), steinmetzK,
+                         steinmetzAlpha, steinmetzBeta (at the adviser
+                         reference frequency). SI units.
 
         Returns:
-            JSON object with count of loaded cores.
+            JSON object with "names" of matching cores, "count" and "total".
         )pbdoc",
-        py::arg("file_to_load_json"), py::arg("include_toroids"), py::arg("use_only_cores_in_stock"));
+        py::arg("ranges_json"),
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("clear_loaded_cores", &clear_loaded_cores,
         R"pbdoc(
@@ -294,11 +396,15 @@ void register_database_bindings(py::module& m) {
 
         Args:
             json_text: NDJSON string with one magnetic per line.
+            skip_invalid: Skip records that cannot be built, logging each as a
+                          warning, instead of stopping at the first one.
 
         Returns:
-            String with count of loaded magnetics.
+            String with count of loaded magnetics, or "record <n>: <reason>"
+            for the first record that cannot be built.
         )pbdoc",
-        py::arg("json_text"));
+        py::arg("json_text"), py::arg("skip_invalid") = false,
+        py::call_guard<py::gil_scoped_release>());
 
 }
 
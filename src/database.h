@@ -15,17 +15,24 @@ size_t load_core_materials(std::string fileToLoad);
 size_t load_core_shapes(std::string fileToLoad);
 size_t load_wires(std::string fileToLoad);
 void clear_databases();
+
+// Drops everything derived from the databases: the name indexes, the core
+// feature index, the wire index and the simulate() / field solution caches.
+// Every write to a database (loads, clears, snapshot restores, write-backs)
+// calls it under its StateWriteLock.
+void invalidate_database_views();
 bool is_core_material_database_empty();
 bool is_core_shape_database_empty();
 bool is_wire_database_empty();
 
-std::string load_magnetics_from_file(std::string path, bool expand);
+std::string load_magnetics_from_file(std::string path, bool expand, bool skipInvalid = false);
 std::string clear_magnetic_cache();
 
 // Additional database functions
-json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInStock);
+json load_cores(json fileToLoadJson, bool includeToroids, bool useOnlyCoresInStock, json indexPathJson = nullptr);
+json query_core_index(json rangesJson);
 void clear_loaded_cores();
-std::string load_magnetics_from_string(std::string jsonText);
+std::string load_magnetics_from_string(std::string jsonText, bool skipInvalid = false);
 
 void register_database_bindings(py::module& m);
 
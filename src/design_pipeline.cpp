@@ -0,0 +1,347 @@
+#include "design_pipeline.h"
+#include "concurrency.h"
+#include "converter.h"
+#include "profiling.h"
+#include "result_cache.h"
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+
+namespace PyMKF {
+
+namespace {
+
+// process_converter's {"error": ...} reply, returned as-is by the stage
+// methods instead of being wrapped a second time.
+struct InputsStageError {
+    json error;
+};
+
+std::map<OpenMagnetics::MagneticFilters, double> parse_weights(const json& weightsJson) {
+    std::map<OpenMagnetics::MagneticFilters, double> weights;
+    if (!weightsJson.is_null()) {
+        for (auto& [key, value] : weightsJson.items()) {
+            OpenMagnetics::MagneticFilters filter;
+            OpenMagnetics::from_json(key, filter);
+            weights[filter] = value;
+        }
+    }
+    return weights;
+}
+
+std::string design_reference(const OpenMagnetics::Mas& masMagnetic) {
+    return masMagnetic.get_magnetic().get_manufacturer_info().value().get_reference().value();
+}
+
+// The {"data": [...]} envelope of design_magnetics_from_converter for the
+// candidates at `order`, best (highest scoring) first.
+json advised_results_json(const AdvisedMagnetics& masMagnetics, const std::vector<double>& scorings,
+                          const MagneticScorings& scoringsPerFilter, std::vector<size_t> order) {
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return scorings[a] > scorings[b]; });
+    json results;
+    results["data"] = json::array();
+    for (size_t index : order) {
+        auto& masMagnetic = masMagnetics[index].first;
+        std::string name = design_reference(masMagnetic);
+        json result;
+        json masJson;
+        to_json(masJson, masMagnetic);
+        result["mas"] = masJson;
+        result["scoring"] = scorings[index];
+        auto filterScoringsIt = scoringsPerFilter.find(name);
+        if (filterScoringsIt != scoringsPerFilter.end()) {
+            json filterScorings;
+            for (auto& [filter, filterScore] : filterScoringsIt->second) {
+                filterScorings[std::string(magic_enum::enum_name(filter))] = filterScore;
+            }
+            result["scoringPerFilter"] = filterScorings;
+        }
+        results["data"].push_back(result);
+    }
+    return results;
+}
+
+json error_json(const std::exception& exc) {
+    json error;
+    error["error"] = "Exception: " + std::string{exc.what()};
+    return error;
+}
+
+} // namespace
+
+DesignPipeline::DesignPipeline(std::string topologyName, json converterJson, bool useNgspice, size_t maxDesigns)
+    : _topologyName(std::move(topologyName)), _converterJson(std::move(converterJson)), _useNgspice(useNgspice),
+      _maxDesigns(maxDesigns) {
+    if (_maxDesigns < 1) {
+        throw std::invalid_argument("max_designs must be at least 1");
+    }
+}
+
+const OpenMagnetics::Inputs& DesignPipeline::ensure_inputs() {
+    auto key = canonical_cache_key("process_converter", json::array({_topologyName, _converterJson, _useNgspice}));
+    if (_inputs && key == _inputsKey) {
+        ++_hits;
+        return *_inputs;
+    }
+    ++_misses;
+    _inputs.reset();
+
+    json inputsJson = process_converter(_topologyName, _converterJson, _useNgspice);
+    if (inputsJson.contains("error")) {
+        throw InputsStageError{inputsJson};
+    }
+    _inputs = OpenMagnetics::Inputs(inputsJson);
+    _inputsKey = std::move(key);
+    return *_inputs;
+}
+
+const DesignPipeline::AdvisedStage& DesignPipeline::ensure_design(int maxResults, const json& coreModeJson, const json& weightsJson, bool fast) {
+    if (maxResults < 1) {
+        throw std::invalid_argument("max_results must be at least 1");
+    }
+    // The settings are part of the key, so a settings change misses.
+    auto key = canonical_cache_key("design", json::array({maxResults, coreModeJson, weightsJson, fast}));
+    auto it = _designs.find(key);
+    if (it != _designs.end()) {
+        ++_hits;
+        _designsByUse.splice(_designsByUse.begin(), _designsByUse, it->second.use);
+        if (!fast) {
+            _lastFullDesignKey = key;
+        }
+        return it->second;
+    }
+    ++_misses;
+
+    PYMKF_PROFILE_SCOPE("DesignPipeline::design");
+    OpenMagnetics::CoreAdviser::CoreAdviserModes coreMode;
+    from_json(coreModeJson, coreMode);
+    auto weights = parse_weights(weightsJson);
+
+    // The adviser runs on the processed converter, so a new design() only
+    // processes the converter again when the spec's key changed.
+    OpenMagnetics::Inputs inputs = ensure_inputs();
+    OpenMagnetics::MagneticAdviser magneticAdviser;
+    magneticAdviser.set_core_mode(coreMode);
+    AdvisedStage stage;
+    if (fast) {
+        stage.masMagnetics = magneticAdviser.get_advised_magnetic_fast(inputs, maxResults);
+    } else if (weights.empty()) {
+        stage.masMagnetics = magneticAdviser.get_advised_magnetic(inputs, maxResults);
+    } else {
+        stage.masMagnetics = magneticAdviser.get_advised_magnetic(inputs, weights, maxResults);
+    }
+    stage.scorings = magneticAdviser.get_scorings();
+
+    // Make room by dropping the least recently used run, keeping the one
+    // rerank() works on unless it is the only one left.
+    while (_designs.size() >= _maxDesigns) {
+        auto victim = std::prev(_designsByUse.end());
+        if (*victim == _lastFullDesignKey && _designsByUse.size() > 1) {
+            victim = std::prev(victim);
+        }
+        if (*victim == _lastFullDesignKey) {
+            _lastFullDesignKey.clear();
+        }
+        _designs.erase(*victim);
+        _designsByUse.erase(victim);
+    }
+    _designsByUse.push_front(key);
+    stage.use = _designsByUse.begin();
+    if (!fast) {
+        _lastFullDesignKey = key;
+    }
+    return _designs[key] = std::move(stage);
+}
+
+json DesignPipeline::inputs() {
+    try {
+        StateWriteLock stateLock;
+        std::lock_guard<std::mutex> lock(_mutex);
+        json result;
+        to_json(result, ensure_inputs());
+        return result;
+    }
+    catch (const InputsStageError& e) {
+        return e.error;
+    }
+    catch (const std::exception& exc) {
+        return error_json(exc);
+    }
+}
+
+json DesignPipeline::design(int maxResults, json coreModeJson, json weightsJson, bool fast) {
+    try {
+        // The adviser flips settings while it searches; see
+        // design_magnetics_from_converter.
+        StateWriteLock stateLock;
+        ScopedSettings settingsScope;
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& stage = ensure_design(maxResults, coreModeJson, weightsJson, fast);
+
+        std::vector<size_t> order(stage.masMagnetics.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::vector<double> scorings;
+        for (auto& [masMagnetic, scoring] : stage.masMagnetics) {
+            scorings.push_back(scoring);
+        }
+        return advised_results_json(stage.masMagnetics, scorings, stage.scorings, std::move(order));
+    }
+    catch (const InputsStageError& e) {
+        return e.error;
+    }
+    catch (const std::exception& exc) {
+        return error_json(exc);
+    }
+}
+
+json DesignPipeline::rerank(json weightsJson, int maxResults) {
+    try {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _designs.find(_lastFullDesignKey);
+        if (it == _designs.end()) {
+            throw std::runtime_error("rerank needs a design() with fast=False first");
+        }
+        auto& stage = it->second;
+        auto weights = parse_weights(weightsJson);
+
+        // Weighted sum of each candidate's per-filter scorings; filters
+        // missing from `weights` count with weight 1.
+        std::vector<double> scorings;
+        for (auto& [masMagnetic, scoring] : stage.masMagnetics) {
+            double weighted = 0;
+            auto filterScoringsIt = stage.scorings.find(design_reference(masMagnetic));
+            if (filterScoringsIt != stage.scorings.end()) {
+                for (auto& [filter, filterScore] : filterScoringsIt->second) {
+                    auto weightIt = weights.find(filter);
+                    weighted += (weightIt == weights.end() ? 1.0 : weightIt->second) * filterScore;
+                }
+            }
+            scorings.push_back(weighted);
+        }
+        std::vector<size_t> order(stage.masMagnetics.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return scorings[a] > scorings[b]; });
+        if (maxResults >= 0 && order.size() > static_cast<size_t>(maxResults)) {
+            order.resize(maxResults);
+        }
+        return advised_results_json(stage.masMagnetics, scorings, stage.scorings, std::move(order));
+    }
+    catch (const std::exception& exc) {
+        return error_json(exc);
+    }
+}
+
+void DesignPipeline::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inputs.reset();
+    _inputsKey.clear();
+    _designs.clear();
+    _designsByUse.clear();
+    _lastFullDesignKey.clear();
+}
+
+json DesignPipeline::info() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    json result;
+    result["inputsCached"] = _inputs.has_value();
+    result["designs"] = _designs.size();
+    result["maxDesigns"] = _maxDesigns;
+    result["hits"] = _hits;
+    result["misses"] = _misses;
+    return result;
+}
+
+void register_design_pipeline_bindings(py::module& m) {
+    py::class_<DesignPipeline>(m, "DesignPipeline",
+        R"pbdoc(
+        A converter specification designed in stages, each kept for reuse.
+
+        The processed inputs (as process_converter) and each adviser run on
+        those inputs are cached by what they depend on. A design() repeating
+        the max_results, core mode, weights and fast of a cached run, or
+        re-ranking it, runs nothing; any other design() runs the adviser on
+        the cached inputs, processing the converter only if they are not
+        cached yet. At most max_designs runs are kept, the least recently
+        used dropped first. A settings change misses both stages; call
+        clear() after changing the databases.
+
+        Example:
+            >>> pipeline = PyMKF.DesignPipeline("flyback", flyback_spec, False)
+            >>> designs = pipeline.design(10, "standard cores")
+            >>> again = pipeline.design(10, "standard cores")    # from the cache
+            >>> by_cost = pipeline.rerank({"COST": 3.0}, 3)      # no new search
+        )pbdoc")
+        .def(py::init<std::string, json, bool, size_t>(),
+            R"pbdoc(
+            Create the pipeline; nothing is computed until the first call.
+
+            Args:
+                topology_name: Any name process_converter() accepts.
+                converter_json: The converter specification.
+                use_ngspice: Process the converter with ngspice (default) or
+                    analytically.
+                max_designs: Adviser runs to keep (default 16).
+
+            Raises:
+                ValueError: If max_designs is less than 1.
+            )pbdoc",
+            py::arg("topology_name"), py::arg("converter_json"), py::arg("use_ngspice") = true,
+            py::arg("max_designs") = 16)
+        .def("inputs", &DesignPipeline::inputs,
+            R"pbdoc(
+            The processed converter, as process_converter() returns it.
+
+            Returns:
+                {"designRequirements": {...}, "operatingPoints": [...]}, or
+                {"error": "..."}.
+            )pbdoc",
+            py::call_guard<py::gil_scoped_release>())
+        .def("design", &DesignPipeline::design,
+            R"pbdoc(
+            Advised magnetics for the processed converter.
+
+            Args:
+                max_results: Designs to return.
+                core_mode_json: "available cores" or "standard cores".
+                weights_json: Optional per-filter weights.
+                fast: Fast core-only adviser instead of the full
+                    winding+simulation one.
+
+            Returns:
+                {"data": [{"mas", "scoring", "scoringPerFilter"}, ...]} as
+                design_magnetics_from_converter(), or {"error": "..."}.
+            )pbdoc",
+            py::arg("max_results") = 1, py::arg("core_mode_json") = "available cores",
+            py::arg("weights_json") = nullptr, py::arg("fast") = false,
+            py::call_guard<py::gil_scoped_release>())
+        .def("rerank", &DesignPipeline::rerank,
+            R"pbdoc(
+            Rank the candidates of the last full (fast=False) design() by new weights.
+
+            Each candidate scores the weighted sum of its scoringPerFilter;
+            filters missing from weights_json count with weight 1. No new
+            candidates are searched: run design() with the weights for that.
+
+            Args:
+                weights_json: Per-filter weights, e.g. {"COST": 2.0}.
+                max_results: Designs to return; -1 returns all of them.
+
+            Returns:
+                The design() envelope with the new scorings, or {"error": "..."}.
+            )pbdoc",
+            py::arg("weights_json"), py::arg("max_results") = -1,
+            py::call_guard<py::gil_scoped_release>())
+        .def("clear", &DesignPipeline::clear,
+            "Drop every cached stage.")
+        .def("info", &DesignPipeline::info,
+            R"pbdoc(
+            Cache state.
+
+            Returns:
+                {"inputsCached": bool, "designs": int, "maxDesigns": int,
+                "hits": int, "misses": int}.
+            )pbdoc");
+}
+
+} // namespace PyMKF
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "common.h"
+#include "advisers.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+
+namespace PyMKF {
+
+// ─── Staged converter-to-magnetic design ────────────────────────────────────
+// design_magnetics_from_converter reprocesses the converter and reruns the
+// adviser on every call, even when the same design is asked for again. A
+// DesignPipeline keeps the output of each stage keyed by what that stage
+// depends on:
+//
+//   * inputs  — the processed converter (process_converter), keyed by the
+//               spec, use_ngspice and the settings;
+//   * designs — one adviser run on the cached inputs per (maxResults, core
+//               mode, weights, fast) and settings. At most maxDesigns are
+//               kept; the least recently used one is dropped first, the
+//               one rerank() works on last.
+//
+// The adviser's results depend on maxResults, so a design() is only served
+// by a run with the same one. rerank() orders the candidates of the last
+// full design() by new weights without running anything. Database changes are
+// not seen, so call clear() after loading other cores or materials.
+class DesignPipeline {
+  public:
+    DesignPipeline(std::string topologyName, json converterJson, bool useNgspice, size_t maxDesigns = 16);
+
+    json inputs();
+    json design(int maxResults, json coreModeJson, json weightsJson, bool fast);
+    json rerank(json weightsJson, int maxResults);
+    void clear();
+    json info() const;
+
+  private:
+    struct AdvisedStage {
+        AdvisedMagnetics masMagnetics;  // in adviser order, best first
+        MagneticScorings scorings;
+        std::list<std::string>::iterator use;  // position in _designsByUse
+    };
+
+    // Both require the StateWriteLock and _mutex.
+    const OpenMagnetics::Inputs& ensure_inputs();
+    const AdvisedStage& ensure_design(int maxResults, const json& coreModeJson, const json& weightsJson, bool fast);
+
+    std::string _topologyName;
+    json _converterJson;
+    bool _useNgspice;
+    size_t _maxDesigns;
+
+    mutable std::mutex _mutex;
+    std::string _inputsKey;
+    std::optional<OpenMagnetics::Inputs> _inputs;
+    std::map<std::string, AdvisedStage> _designs;
+    std::list<std::string> _designsByUse;  // keys of _designs, most recent first
+    std::string _lastFullDesignKey;
+    size_t _hits = 0;
+    size_t _misses = 0;
+};
+
+void register_design_pipeline_bindings(py::module& m);
+
+} // namespace PyMKF
@@ -1,5 +1,6 @@
 
 #include "logging.h"
+#include "profiling.h"
 #ifdef ERROR
 #undef ERROR
 #endif
@@ -184,6 +185,58 @@ void register_logging_bindings(py::module& m) {
             >>> PyOpenMagnetics.log_message("INFO", "Starting calculation")
             >>> PyOpenMagnetics.log_message("DEBUG", "Value computed", "MyModule")
         )pbdoc");
+
+    m.def("enable_profiling", &enable_profiling,
+        py::arg("reset") = true,
+        R"pbdoc(
+        Start recording hot-path timers and counters.
+
+        Instrumented scopes (simulate, core and winding loss models, proximity
+        and skin effect losses, winding, adviser calls and each adviser step,
+        converter processing) record their wall time into a per-thread call
+        tree. While profiling is off each scope costs one atomic load.
+
+        Args:
+            reset: Drop what was recorded before (default True).
+
+        Example:
+            >>> PyOpenMagnetics.enable_profiling()
+            >>> PyOpenMagnetics.calculate_advised_magnetics(inputs, 3, "standard cores")
+            >>> profile = PyOpenMagnetics.get_profile()
+        )pbdoc");
+
+    m.def("disable_profiling", &disable_profiling,
+        R"pbdoc(
+        Stop recording. What was recorded stays available to get_profile().
+        )pbdoc");
+
+    m.def("reset_profile", &reset_profile,
+        R"pbdoc(
+        Drop all recorded timers and counters without changing whether
+        profiling is enabled.
+        )pbdoc");
+
+    m.def("get_profile", &get_profile,
+        R"pbdoc(
+        Get the recorded profile, merged over all threads.
+
+        Returns:
+            JSON object with:
+            - "enabled": Whether profiling is currently on
+            - "threads": Number of threads that recorded something
+            - "scopes": List of {"path", "name", "depth", "calls", "totalMs",
+              "selfMs"}, heaviest first. "path" joins the enclosing scopes with
+              ";" (e.g. "MagneticSimulator::simulate;CoreLossesModel").
+            - "counters": {name: value}, e.g. "adviserCoresEvaluated"
+            - "folded": One "path self_microseconds" line per scope, the
+              collapsed-stack format read by flamegraph.pl and speedscope.
+
+        Example:
+            >>> profile = PyOpenMagnetics.get_profile()
+            >>> for scope in profile["scopes"][:5]:
+            ...     print(scope["path"], scope["totalMs"], scope["calls"])
+            >>> open("profile.folded", "w").write(profile["folded"])
+        )pbdoc");
 }
 
 } // namespace PyMKF
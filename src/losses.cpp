@@ -1,8 +1,39 @@
 #include "losses.h"
+#include "concurrency.h"
+#include "database.h"
+#include "profiling.h"
+#include "simulation.h"
+#include "thread_pool.h"
+
+#include <algorithm>
 
 namespace PyMKF {
 
-json calculate_core_losses(json coreData, json coilData, json inputsData, json modelsData) {
+JsonResultCache& field_solution_cache() {
+    static JsonResultCache cache;
+    return cache;
+}
+
+// Quantities calculate_core_losses can return; "coreLosses" stands for the
+// whole CoreLossesOutput.
+static const std::vector<std::string> coreLossesOutputNames = {
+    "coreLosses",
+    "magneticFluxDensityPeak",
+    "magneticFluxDensityAcPeak",
+    "voltageRms",
+    "currentRms",
+    "apparentPower",
+    "maximumCoreTemperature",
+    "maximumCoreTemperatureRise",
+};
+
+json calculate_core_losses(json coreData, json coilData, json inputsData, json modelsData, json outputsJson) {
+    PYMKF_PROFILE_SCOPE("CoreLossesModel");
+    StateReadLockWithDatabases stateLock;
+    auto wants = parse_output_selection(outputsJson, coreLossesOutputNames);
+    bool needsCoreLosses = wants("coreLosses") || wants("maximumCoreTemperature") || wants("maximumCoreTemperatureRise");
+    bool needsMagneticFluxDensity = wants("magneticFluxDensityPeak") || wants("magneticFluxDensityAcPeak");
+
     OpenMagnetics::Core core(coreData);
     OpenMagnetics::Coil coil(coilData);
     OpenMagnetics::Inputs inputs(inputsData);
@@ -26,32 +57,56 @@ json calculate_core_losses(json coreData, json coilData, json inputsData, json m
         OpenMagnetics::from_json(models["coreLosses"], coreLossesModelName);
     }
 
-    OpenMagnetics::Magnetic magnetic;
-    magnetic.set_core(core);
-    magnetic.set_coil(coil);
-
-    OpenMagnetics::MagneticSimulator magneticSimulator;
-    magneticSimulator.set_core_losses_model_name(coreLossesModelName);
-    magneticSimulator.set_reluctance_model_name(reluctanceModelName);
-    auto coreLossesOutput = magneticSimulator.calculate_core_losses(operatingPoint, magnetic);
-    json result;
-    to_json(result, coreLossesOutput);
+    json result = json::object();
+    if (needsCoreLosses) {
+        OpenMagnetics::Magnetic magnetic;
+        magnetic.set_core(core);
+        magnetic.set_coil(coil);
+
+        OpenMagnetics::MagneticSimulator magneticSimulator;
+        magneticSimulator.set_core_losses_model_name(coreLossesModelName);
+        magneticSimulator.set_reluctance_model_name(reluctanceModelName);
+        auto coreLossesOutput = magneticSimulator.calculate_core_losses(operatingPoint, magnetic);
+        if (wants("coreLosses")) {
+            to_json(result, coreLossesOutput);
+        }
+        if (wants("maximumCoreTemperature")) {
+            result["maximumCoreTemperature"] = coreLossesOutput.get_temperature();
+        }
+        if (wants("maximumCoreTemperatureRise")) {
+            result["maximumCoreTemperatureRise"] = coreLossesOutput.get_temperature() - operatingPoint.get_conditions().get_ambient_temperature();
+        }
+    }
 
-    OpenMagnetics::MagnetizingInductance magnetizingInductanceObj(reluctanceModelName);
-    auto magneticFluxDensity = magnetizingInductanceObj.calculate_inductance_and_magnetic_flux_density(core, coil, &operatingPoint).second;
+    // The second reluctance pass only feeds the flux density fields.
+    if (needsMagneticFluxDensity) {
+        OpenMagnetics::MagnetizingInductance magnetizingInductanceObj(reluctanceModelName);
+        auto magneticFluxDensity = magnetizingInductanceObj.calculate_inductance_and_magnetic_flux_density(core, coil, &operatingPoint).second;
+        auto processed = magneticFluxDensity.get_processed().value();
+        if (wants("magneticFluxDensityPeak")) {
+            result["magneticFluxDensityPeak"] = processed.get_peak().value();
+        }
+        if (wants("magneticFluxDensityAcPeak")) {
+            result["magneticFluxDensityAcPeak"] = processed.get_peak().value() - processed.get_offset();
+        }
+    }
 
-    result["magneticFluxDensityPeak"] = magneticFluxDensity.get_processed().value().get_peak().value();
-    result["magneticFluxDensityAcPeak"] = magneticFluxDensity.get_processed().value().get_peak().value() - magneticFluxDensity.get_processed().value().get_offset();
-    result["voltageRms"] = operatingPoint.get_mutable_excitations_per_winding()[0].get_voltage().value().get_processed().value().get_rms().value();
-    result["currentRms"] = operatingPoint.get_mutable_excitations_per_winding()[0].get_current().value().get_processed().value().get_rms().value();
-    result["apparentPower"] = operatingPoint.get_mutable_excitations_per_winding()[0].get_voltage().value().get_processed().value().get_rms().value() * operatingPoint.get_mutable_excitations_per_winding()[0].get_current().value().get_processed().value().get_rms().value();
-    result["maximumCoreTemperature"] = coreLossesOutput.get_temperature();
-    result["maximumCoreTemperatureRise"] = coreLossesOutput.get_temperature() - operatingPoint.get_conditions().get_ambient_temperature();
+    auto& primaryExcitation = operatingPoint.get_mutable_excitations_per_winding()[0];
+    if (wants("voltageRms")) {
+        result["voltageRms"] = primaryExcitation.get_voltage().value().get_processed().value().get_rms().value();
+    }
+    if (wants("currentRms")) {
+        result["currentRms"] = primaryExcitation.get_current().value().get_processed().value().get_rms().value();
+    }
+    if (wants("apparentPower")) {
+        result["apparentPower"] = primaryExcitation.get_voltage().value().get_processed().value().get_rms().value() * primaryExcitation.get_current().value().get_processed().value().get_rms().value();
+    }
 
     return result;
 }
 
 json get_core_losses_model_information(json material) {
+    StateReadLockWithDatabases stateLock;
     json info;
     info["information"] = OpenMagnetics::CoreLossesModel::get_models_information();
     info["errors"] = OpenMagnetics::CoreLossesModel::get_models_errors();
@@ -61,18 +116,28 @@ json get_core_losses_model_information(json material) {
     return info;
 }
 
+static std::vector<std::pair<double, double>> parse_steinmetz_ranges(const json& rangesJson) {
+    std::vector<std::pair<double, double>> ranges;
+    for (auto& rangeJson : rangesJson) {
+        ranges.emplace_back(rangeJson[0].get<double>(), rangeJson[1].get<double>());
+    }
+    return ranges;
+}
+
+static std::vector<VolumetricLossesPoint> parse_volumetric_losses_points(const json& dataJson) {
+    std::vector<VolumetricLossesPoint> data;
+    data.reserve(dataJson.size());
+    for (auto& datumJson : dataJson) {
+        data.emplace_back(datumJson);
+    }
+    return data;
+}
+
 json calculate_steinmetz_coefficients(json dataJson, json rangesJson) {
     try {
-        std::vector<std::pair<double, double>> ranges;
-        for (auto rangeJson : rangesJson) {
-            std::pair<double, double> range{rangeJson[0], rangeJson[1]};
-            ranges.push_back(range);
-        }
-        std::vector<VolumetricLossesPoint> data;
-        for (auto datumJson : dataJson) {
-            VolumetricLossesPoint datum(datumJson);
-            data.push_back(datum);
-        }
+        StateReadLockWithDatabases stateLock;
+        auto ranges = parse_steinmetz_ranges(rangesJson);
+        auto data = parse_volumetric_losses_points(dataJson);
 
         auto [coefficientsPerRange, errorPerRange] = OpenMagnetics::CoreLossesSteinmetzModel::calculate_steinmetz_coefficients(data, ranges);
 
@@ -87,16 +152,9 @@ json calculate_steinmetz_coefficients(json dataJson, json rangesJson) {
 
 json calculate_steinmetz_coefficients_with_error(json dataJson, json rangesJson) {
     try {
-        std::vector<std::pair<double, double>> ranges;
-        for (auto rangeJson : rangesJson) {
-            std::pair<double, double> range{rangeJson[0], rangeJson[1]};
-            ranges.push_back(range);
-        }
-        std::vector<VolumetricLossesPoint> data;
-        for (auto datumJson : dataJson) {
-            VolumetricLossesPoint datum(datumJson);
-            data.push_back(datum);
-        }
+        StateReadLockWithDatabases stateLock;
+        auto ranges = parse_steinmetz_ranges(rangesJson);
+        auto data = parse_volumetric_losses_points(dataJson);
 
         auto [coefficientsPerRange, errorPerRange] = OpenMagnetics::CoreLossesSteinmetzModel::calculate_steinmetz_coefficients(data, ranges);
 
@@ -112,14 +170,197 @@ json calculate_steinmetz_coefficients_with_error(json dataJson, json rangesJson)
     }
 }
 
+// A material's volumetricLosses is a map of method lists, each entry either
+// an array of measured points or a method object such as
+// {"method": "steinmetz", "ranges": [...]}.
+static bool is_steinmetz_method(const json& element) {
+    return element.is_object() && element.value("method", "") == "steinmetz";
+}
+
+// Measured points of a material, from every volumetricLosses list.
+static json material_volumetric_losses_points(const json& materialJson) {
+    json points = json::array();
+    for (auto& [key, elements] : materialJson.value("volumetricLosses", json::object()).items()) {
+        for (auto& element : elements) {
+            if (element.is_array()) {
+                points.insert(points.end(), element.begin(), element.end());
+            }
+        }
+    }
+    return points;
+}
+
+// Frequency ranges of a material's current Steinmetz fit.
+static json material_steinmetz_ranges(const json& materialJson) {
+    json ranges = json::array();
+    for (auto& [key, elements] : materialJson.value("volumetricLosses", json::object()).items()) {
+        for (auto& element : elements) {
+            if (is_steinmetz_method(element)) {
+                for (auto& range : element.value("ranges", json::array())) {
+                    ranges.push_back({range.at("minimumFrequency"), range.at("maximumFrequency")});
+                }
+            }
+        }
+    }
+    return ranges;
+}
+
+// Replaces the Steinmetz method of a material with `coefficientsPerRange`,
+// keeping it in the list that held the old one ("default" if none did).
+static void replace_material_steinmetz_coefficients(json& materialJson, const json& coefficientsPerRange) {
+    auto& volumetricLosses = materialJson["volumetricLosses"];
+    if (!volumetricLosses.is_object()) {
+        volumetricLosses = json::object();
+    }
+    std::string key = "default";
+    for (auto& [listKey, elements] : volumetricLosses.items()) {
+        auto steinmetz = std::remove_if(elements.begin(), elements.end(), is_steinmetz_method);
+        if (steinmetz != elements.end()) {
+            key = listKey;
+            elements.erase(steinmetz, elements.end());
+        }
+    }
+    volumetricLosses[key].push_back({{"method", "steinmetz"}, {"ranges", coefficientsPerRange}});
+}
+
+struct SteinmetzFitJob {
+    std::string material;
+    json materialJson;
+    std::vector<VolumetricLossesPoint> data;
+    std::vector<std::pair<double, double>> ranges;
+};
+
+json fit_steinmetz_coefficients_batch(json jobsJson, int threads, bool updateDatabase) {
+    try {
+        size_t count = jobsJson.size();
+        std::vector<json> results(count);
+        std::vector<SteinmetzFitJob> jobs(count);
+        {
+            py::gil_scoped_release release;
+            {
+                StateReadLockWithDatabases stateLock;
+                // Each material is one fit: MKF fits the ranges of a material
+                // together, so the results match calculate_steinmetz_coefficients.
+                parallel_for(count, resolve_thread_count(threads, count), [&](size_t index) {
+                    auto& job = jobs[index];
+                    json result;
+                    try {
+                        const json& jobJson = jobsJson.at(index);
+                        job.material = jobJson.at("material").get<std::string>();
+                        result["material"] = job.material;
+                        if (!jobJson.contains("data") || !jobJson.contains("ranges")) {
+                            to_json(job.materialJson, OpenMagnetics::find_core_material_by_name(job.material));
+                        }
+                        job.data = parse_volumetric_losses_points(jobJson.contains("data") ? jobJson["data"] : material_volumetric_losses_points(job.materialJson));
+                        job.ranges = parse_steinmetz_ranges(jobJson.contains("ranges") ? jobJson["ranges"] : material_steinmetz_ranges(job.materialJson));
+                        if (job.data.empty()) {
+                            throw std::invalid_argument("no volumetric losses points to fit for " + job.material);
+                        }
+                        if (job.ranges.empty()) {
+                            throw std::invalid_argument("no frequency ranges to fit for " + job.material);
+                        }
+
+                        auto [coefficientsPerRange, errorPerRange] = OpenMagnetics::CoreLossesSteinmetzModel::calculate_steinmetz_coefficients(job.data, job.ranges);
+                        json coefficients;
+                        to_json(coefficients, coefficientsPerRange);
+                        result["coefficientsPerRange"] = coefficients;
+                        result["errorPerRange"] = errorPerRange;
+                    }
+                    catch (const std::exception &exc) {
+                        result["error"] = "Exception: " + std::string{exc.what()};
+                    }
+                    results[index] = std::move(result);
+                });
+            }
+
+            if (updateDatabase) {
+                StateWriteLock stateLock;
+                using CoreMaterialEntry = decltype(OpenMagnetics::coreMaterialDatabase)::mapped_type;
+                for (auto& result : results) {
+                    if (result.contains("error")) {
+                        continue;
+                    }
+                    auto material = OpenMagnetics::coreMaterialDatabase.find(result["material"].get<std::string>());
+                    if (material == OpenMagnetics::coreMaterialDatabase.end()) {
+                        result["updated"] = false;
+                        continue;
+                    }
+                    json materialJson;
+                    to_json(materialJson, material->second);
+                    replace_material_steinmetz_coefficients(materialJson, result["coefficientsPerRange"]);
+                    material->second = CoreMaterialEntry(materialJson);
+                    result["updated"] = true;
+                }
+                invalidate_database_views();
+            }
+        }
+
+        json response;
+        response["data"] = std::move(results);
+        return response;
+    }
+    catch (const std::exception &exc) {
+        json response;
+        response["data"] = "Exception: " + std::string{exc.what()};
+        return response;
+    }
+}
+
+// The winding-window H-field of `magnetic` at `operatingPoint`, solved by MKF.
+static json solve_field(OpenMagnetics::Magnetic& magnetic, OperatingPoint& operatingPoint) {
+    PYMKF_PROFILE_SCOPE("MagneticField");
+    auto windingWindowMagneticStrengthFieldOutput = OpenMagnetics::MagneticField().calculate_magnetic_field_strength_field(operatingPoint, magnetic);
+    json result;
+    to_json(result, windingWindowMagneticStrengthFieldOutput);
+    return result;
+}
+
+json cached_field_solution(const std::string& kind, const json& magneticJson, const json& operatingPointJson, const std::function<json()>& solve) {
+    if (!field_solution_cache().enabled()) {
+        return solve();
+    }
+    auto cacheKey = canonical_cache_key(kind, json::array({magneticJson, operatingPointJson}));
+    if (auto cached = field_solution_cache().get(cacheKey)) {
+        return *cached;
+    }
+    auto result = solve();
+    field_solution_cache().put(cacheKey, result);
+    return result;
+}
+
+// solve_field() through the field solution cache when it is enabled. The key
+// is the magnetic and operating point JSON plus the full settings, so the
+// number of field points and the model choices are part of it.
+// Call under a StateReadLock.
+static json field_solution(OpenMagnetics::Magnetic& magnetic, OperatingPoint& operatingPoint, const json& magneticJson, const json& operatingPointJson) {
+    return cached_field_solution("magneticFieldStrengthField", magneticJson, operatingPointJson,
+                                 [&] { return solve_field(magnetic, operatingPoint); });
+}
+
+WindingLossesOutput winding_losses_from_field_solution(OpenMagnetics::Magnetic& magnetic, OperatingPoint& operatingPoint,
+                                                       const json& magneticJson, const json& operatingPointJson, double temperature) {
+    OpenMagnetics::Coil coil = magnetic.get_coil();
+
+    auto windingLossesOutput = OpenMagnetics::WindingOhmicLosses::calculate_ohmic_losses(coil, operatingPoint, temperature);
+    windingLossesOutput = OpenMagnetics::WindingSkinEffectLosses::calculate_skin_effect_losses(coil, temperature, windingLossesOutput);
+    WindingWindowMagneticStrengthFieldOutput windingWindowMagneticStrengthFieldOutput(field_solution(magnetic, operatingPoint, magneticJson, operatingPointJson));
+    return OpenMagnetics::WindingProximityEffectLosses::calculate_proximity_effect_losses(coil, temperature, windingLossesOutput, windingWindowMagneticStrengthFieldOutput);
+}
+
 json calculate_winding_losses(json magneticJson, json operatingPointJson, double temperature) {
+    PYMKF_PROFILE_SCOPE("WindingLosses");
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
+        json result;
+        if (field_solution_cache().enabled()) {
+            to_json(result, winding_losses_from_field_solution(magnetic, operatingPoint, magneticJson, operatingPointJson, temperature));
+            return result;
+        }
 
         auto windingLossesOutput = OpenMagnetics::WindingLosses().calculate_losses(magnetic, operatingPoint, temperature);
 
-        json result;
         to_json(result, windingLossesOutput);
         return result;
     }
@@ -132,6 +373,7 @@ json calculate_winding_losses(json magneticJson, json operatingPointJson, double
 
 json calculate_ohmic_losses(json coilJson, json operatingPointJson, double temperature) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         OperatingPoint operatingPoint(operatingPointJson);
 
@@ -149,9 +391,14 @@ json calculate_ohmic_losses(json coilJson, json operatingPointJson, double tempe
 }
 
 json calculate_magnetic_field_strength_field(json operatingPointJson, json magneticJson) {
+    PYMKF_PROFILE_SCOPE("MagneticField");
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
+        if (field_solution_cache().enabled()) {
+            return field_solution(magnetic, operatingPoint, magneticJson, operatingPointJson);
+        }
         OpenMagnetics::MagneticField magneticField;
 
         auto windingWindowMagneticStrengthFieldOutput = magneticField.calculate_magnetic_field_strength_field(operatingPoint, magnetic);
@@ -168,7 +415,9 @@ json calculate_magnetic_field_strength_field(json operatingPointJson, json magne
 }
 
 json calculate_proximity_effect_losses(json coilJson, double temperature, json windingLossesOutputJson, json windingWindowMagneticStrengthFieldOutputJson) {
+    PYMKF_PROFILE_SCOPE("WindingProximityEffectLosses");
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         WindingLossesOutput windingLossesOutput(windingLossesOutputJson);
         WindingWindowMagneticStrengthFieldOutput windingWindowMagneticStrengthFieldOutput(windingWindowMagneticStrengthFieldOutputJson);
@@ -187,7 +436,9 @@ json calculate_proximity_effect_losses(json coilJson, double temperature, json w
 }
 
 json calculate_skin_effect_losses(json coilJson, json windingLossesOutputJson, double temperature) {
+    PYMKF_PROFILE_SCOPE("WindingSkinEffectLosses");
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         WindingLossesOutput windingLossesOutput(windingLossesOutputJson);
 
@@ -205,6 +456,7 @@ json calculate_skin_effect_losses(json coilJson, json windingLossesOutputJson, d
 
 json calculate_skin_effect_losses_per_meter(json wireJson, json currentJson, double temperature, double currentDivider) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Wire wire(wireJson);
         SignalDescriptor current(currentJson);
 
@@ -221,12 +473,14 @@ json calculate_skin_effect_losses_per_meter(json wireJson, json currentJson, dou
 }
 
 double calculate_dc_resistance_per_meter(json wireJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     auto dcResistancePerMeter = OpenMagnetics::WindingOhmicLosses::calculate_dc_resistance_per_meter(wire, temperature);
     return dcResistancePerMeter;
 }
 
 double calculate_dc_losses_per_meter(json wireJson, json currentJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     SignalDescriptor current(currentJson);
     auto dcLossesPerMeter = OpenMagnetics::WindingOhmicLosses::calculate_ohmic_losses_per_meter(wire, current, temperature);
@@ -234,6 +488,7 @@ double calculate_dc_losses_per_meter(json wireJson, json currentJson, double tem
 }
 
 double calculate_skin_ac_factor(json wireJson, json currentJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     SignalDescriptor current(currentJson);
     auto dcLossesPerMeter = OpenMagnetics::WindingOhmicLosses::calculate_ohmic_losses_per_meter(wire, current, temperature);
@@ -243,13 +498,25 @@ double calculate_skin_ac_factor(json wireJson, json currentJson, double temperat
 }
 
 double calculate_skin_ac_losses_per_meter(json wireJson, json currentJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     SignalDescriptor current(currentJson);
     auto [skinLossesPerMeter, _] = OpenMagnetics::WindingSkinEffectLosses::calculate_skin_effect_losses_per_meter(wire, current, temperature);
     return skinLossesPerMeter;
 }
 
+double calculate_skin_ac_losses_per_meter_numpy(json wireJson, NumpyArray time, NumpyArray data, double frequency, double temperature) {
+    auto waveform = waveform_from_numpy(time, data);
+    py::gil_scoped_release release;
+    StateReadLockWithDatabases stateLock;
+    OpenMagnetics::Wire wire(wireJson);
+    auto current = signal_descriptor_from_waveform(waveform, frequency);
+    auto [skinLossesPerMeter, _] = OpenMagnetics::WindingSkinEffectLosses::calculate_skin_effect_losses_per_meter(wire, current, temperature);
+    return skinLossesPerMeter;
+}
+
 double calculate_skin_ac_resistance_per_meter(json wireJson, json currentJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     SignalDescriptor current(currentJson);
     auto dcLossesPerMeter = OpenMagnetics::WindingOhmicLosses::calculate_ohmic_losses_per_meter(wire, current, temperature);
@@ -261,6 +528,7 @@ double calculate_skin_ac_resistance_per_meter(json wireJson, json currentJson, d
 }
 
 double calculate_effective_current_density(json wireJson, json currentJson, double temperature) {
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Wire wire(wireJson);
     SignalDescriptor current(currentJson);
     auto effectiveCurrentDensity = wire.calculate_effective_current_density(current, temperature);
@@ -270,6 +538,7 @@ double calculate_effective_current_density(json wireJson, json currentJson, doub
 
 double calculate_effective_skin_depth(std::string materialName, json currentJson, double temperature) {
     try {
+        StateReadLockWithDatabases stateLock;
         SignalDescriptor current(currentJson);
 
         if (!current.get_processed()->get_effective_frequency()) {
@@ -286,6 +555,7 @@ double calculate_effective_skin_depth(std::string materialName, json currentJson
 
 json get_available_core_losses_methods(json magneticJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         auto core = magnetic.get_core();
         auto material = core.get_functional_description().get_material();
@@ -308,6 +578,7 @@ json get_available_core_losses_methods(json magneticJson) {
 
 json calculate_filling_factor(json coilJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         auto [areaFillingFactor, otherFactors] = coil.calculate_filling_factor();
         auto [overlappingFillingFactor, contiguousFillingFactor] = otherFactors;
@@ -327,6 +598,7 @@ json calculate_filling_factor(json coilJson) {
 
 json calculate_ac_resistance_coefficients_per_winding(json magneticJson, double temperature, double frequency) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         auto coil = magnetic.get_coil();
 
@@ -353,6 +625,19 @@ json calculate_ac_resistance_coefficients_per_winding(json magneticJson, double
     }
 }
 
+void configure_field_solution_cache(size_t maxEntries, size_t maxBytes) {
+    field_solution_cache().configure(maxEntries, maxBytes);
+}
+
+json get_field_solution_cache_stats() {
+    return field_solution_cache().stats();
+}
+
+std::string clear_field_solution_cache() {
+    field_solution_cache().clear();
+    return std::to_string(0);
+}
+
 void register_losses_bindings(py::module& m) {
     // Core losses
     m.def("calculate_core_losses", &calculate_core_losses,
@@ -380,13 +665,19 @@ void register_losses_bindings(py::module& m) {
                 - apparentPower: Apparent power in VA
                 - maximumCoreTemperature: Estimated max temperature in Celsius
                 - maximumCoreTemperatureRise: Temperature rise in Kelvin
+            outputs: Optional list of the keys above to compute; the others
+                are neither computed nor returned. "coreLosses" selects the
+                whole CoreLossesOutput. None (default) computes everything.
         
         Example:
             >>> models = {"coreLosses": "IGSE", "reluctance": "ZHANG"}
             >>> losses = PyMKF.calculate_core_losses(core, coil, inputs, models)
             >>> print(f"Core losses: {losses['coreLosses']:.2f} W")
+            >>> # Screening: skip the flux density pass and the RMS fields
+            >>> PyMKF.calculate_core_losses(core, coil, inputs, models, ["coreLosses"])
         )pbdoc",
-        py::arg("core_data"), py::arg("coil_data"), py::arg("inputs_data"), py::arg("models_data"));
+        py::arg("core_data"), py::arg("coil_data"), py::arg("inputs_data"), py::arg("models_data"),
+        py::arg("outputs") = nullptr);
     
     m.def("get_core_losses_model_information", &get_core_losses_model_information,
         R"pbdoc(
@@ -446,6 +737,42 @@ void register_losses_bindings(py::module& m) {
         )pbdoc",
         py::arg("data_json"), py::arg("ranges_json"));
 
+    m.def("fit_steinmetz_coefficients_batch", &fit_steinmetz_coefficients_batch,
+        R"pbdoc(
+        Fit Steinmetz coefficients for many materials in parallel.
+
+        Each job is fitted as calculate_steinmetz_coefficients_with_error
+        would, on worker threads with the GIL released. A job that omits its
+        data or ranges takes them from the material in the database: every
+        measured volumetricLosses point, and the frequency ranges of its
+        current Steinmetz method, so a catalogue can be refitted as is.
+
+        Args:
+            jobs: JSON array of objects with:
+                - material: Material name
+                - data: Optional VolumetricLossesPoint array to fit
+                - ranges: Optional array of [min_freq, max_freq] tuples
+            threads: Worker threads; 0 or less uses all hardware threads.
+            update_database: Replace the Steinmetz method of each fitted
+                material in the material database with the new coefficients,
+                so later core-loss calculations use them. Materials not in
+                the database are left out.
+
+        Returns:
+            JSON object whose "data" holds one entry per job, in job order:
+                - material: The material name
+                - coefficientsPerRange: Fitted Steinmetz coefficients
+                - errorPerRange: RMS fitting error for each range
+                - updated: Whether the database entry was replaced (only
+                  with update_database)
+            A job that failed holds "error" instead of the coefficients.
+
+        Example:
+            >>> jobs = [{"material": name} for name in PyMKF.get_core_material_names()]
+            >>> fits = PyMKF.fit_steinmetz_coefficients_batch(jobs, update_database=True)
+        )pbdoc",
+        py::arg("jobs"), py::arg("threads") = 0, py::arg("update_database") = false);
+
     // Winding losses
     m.def("calculate_winding_losses", &calculate_winding_losses,
         R"pbdoc(
@@ -504,6 +831,45 @@ void register_losses_bindings(py::module& m) {
         )pbdoc",
         py::arg("operating_point_json"), py::arg("magnetic_json"));
     
+    m.def("configure_field_solution_cache", &configure_field_solution_cache,
+        R"pbdoc(
+        Enable, resize or disable the winding-window field solution cache.
+
+        When enabled, the H-field of a (magnetic, operating point) pair is
+        solved once and reused by calculate_magnetic_field_strength_field,
+        calculate_winding_losses and plot_wire_losses, which feed it to
+        MKF's proximity losses step. plot_magnetic_field caches the field on
+        the painter grid the same way. Only field solutions are stored:
+        losses are always recomputed and SVGs are never cached. Entries are
+        keyed by the magnetic, the operating point and the full settings
+        (field points, painter grid and mesher settings included), so
+        changing a setting never returns a stale field. Least recently used entries are evicted first. Disabled
+        by default; loading or clearing databases empties it.
+
+        Args:
+            max_entries: Maximum number of cached solutions; 0 disables the cache.
+            max_bytes: Maximum serialized size of keys plus solutions; 0 for no limit.
+
+        Example:
+            >>> PyMKF.configure_field_solution_cache(64, 256 * 1024 * 1024)
+            >>> PyMKF.calculate_magnetic_field_strength_field(operating_point, magnetic)
+            >>> PyMKF.calculate_winding_losses(magnetic, operating_point, 25)  # same field
+            >>> PyMKF.plot_wire_losses(magnetic, operating_point)               # same field
+        )pbdoc",
+        py::arg("max_entries"), py::arg("max_bytes") = 0);
+
+    m.def("get_field_solution_cache_stats", &get_field_solution_cache_stats,
+        R"pbdoc(
+        Get counters of the field solution cache.
+
+        Returns:
+            JSON object with "hits", "misses", "evictions", "entries",
+            "bytes", "maxEntries" and "maxBytes".
+        )pbdoc");
+
+    m.def("clear_field_solution_cache", &clear_field_solution_cache,
+        "Clear cached field solutions; counters are kept");
+
     m.def("calculate_proximity_effect_losses", &calculate_proximity_effect_losses,
         R"pbdoc(
         Calculate proximity effect losses from pre-computed field data.
@@ -599,6 +965,25 @@ void register_losses_bindings(py::module& m) {
             AC skin effect power loss in Watts per meter.
         )pbdoc",
         py::arg("wire_json"), py::arg("current_json"), py::arg("temperature"));
+
+    m.def("calculate_skin_ac_losses_per_meter", &calculate_skin_ac_losses_per_meter_numpy,
+        R"pbdoc(
+        Calculate AC skin effect losses per meter for a current given as NumPy arrays.
+
+        The harmonics and processed data of the current are computed
+        internally from the samples.
+
+        Args:
+            wire_json: JSON object with wire specification.
+            time: 1-D float64 array of sample times in seconds.
+            data: 1-D float64 array of current samples in A, same length as time.
+            frequency: Fundamental frequency in Hz.
+            temperature: Wire temperature in Celsius.
+
+        Returns:
+            AC skin effect power loss in Watts per meter.
+        )pbdoc",
+        py::arg("wire_json"), py::arg("time"), py::arg("data"), py::arg("frequency"), py::arg("temperature"));
     
     m.def("calculate_skin_ac_factor", &calculate_skin_ac_factor,
         R"pbdoc(
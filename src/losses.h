@@ -1,14 +1,21 @@
 #pragma once
 
 #include "common.h"
+#include "result_cache.h"
+#include "utils.h"
+
+#include <functional>
 
 namespace PyMKF {
 
 // Core losses
-json calculate_core_losses(json coreData, json coilData, json inputsData, json modelsData);
+json calculate_core_losses(json coreData, json coilData, json inputsData, json modelsData, json outputsJson = nullptr);
 json get_core_losses_model_information(json material);
 json calculate_steinmetz_coefficients(json dataJson, json rangesJson);
 json calculate_steinmetz_coefficients_with_error(json dataJson, json rangesJson);
+// Fits many materials in parallel and optionally writes the coefficients
+// into coreMaterialDatabase.
+json fit_steinmetz_coefficients_batch(json jobsJson, int threads = 0, bool updateDatabase = false);
 
 // Winding losses
 json calculate_winding_losses(json magneticJson, json operatingPointJson, double temperature);
@@ -18,11 +25,30 @@ json calculate_proximity_effect_losses(json coilJson, double temperature, json w
 json calculate_skin_effect_losses(json coilJson, json windingLossesOutputJson, double temperature);
 json calculate_skin_effect_losses_per_meter(json wireJson, json currentJson, double temperature, double currentDivider);
 
+// Winding-window field solution cache (opt-in LRU), shared by the field,
+// winding-loss and field plot bindings. It holds field solutions only, never
+// losses or SVGs.
+JsonResultCache& field_solution_cache();
+// solve() through the cache when it is enabled, keyed on `kind`, the magnetic
+// and operating point JSON and the full settings. Call under a state lock.
+json cached_field_solution(const std::string& kind, const json& magneticJson, const json& operatingPointJson, const std::function<json()>& solve);
+// Winding losses through MKF's ohmic, skin and proximity steps (those of
+// WindingLosses::calculate_losses) with the H-field at the turns taken from
+// the cache, so only the field is shared and the losses are always
+// recomputed. `magneticJson` must describe `magnetic`. Call under a state
+// lock; throws what the models throw.
+WindingLossesOutput winding_losses_from_field_solution(OpenMagnetics::Magnetic& magnetic, OperatingPoint& operatingPoint,
+                                                       const json& magneticJson, const json& operatingPointJson, double temperature);
+void configure_field_solution_cache(size_t maxEntries, size_t maxBytes);
+json get_field_solution_cache_stats();
+std::string clear_field_solution_cache();
+
 // DC resistance and losses
 double calculate_dc_resistance_per_meter(json wireJson, double temperature);
 double calculate_dc_losses_per_meter(json wireJson, json currentJson, double temperature);
 double calculate_skin_ac_factor(json wireJson, json currentJson, double temperature);
 double calculate_skin_ac_losses_per_meter(json wireJson, json currentJson, double temperature);
+double calculate_skin_ac_losses_per_meter_numpy(json wireJson, NumpyArray time, NumpyArray data, double frequency, double temperature);
 double calculate_skin_ac_resistance_per_meter(json wireJson, json currentJson, double temperature);
 double calculate_effective_current_density(json wireJson, json currentJson, double temperature);
 double calculate_effective_skin_depth(std::string materialName, json currentJson, double temperature);
@@ -0,0 +1,128 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace PyMKF {
+
+MappedFile::MappedFile(const std::filesystem::path& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Cannot open " + path.string());
+    }
+    _file = file;
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        throw std::runtime_error("Cannot stat " + path.string());
+    }
+    _size = static_cast<size_t>(fileSize.QuadPart);
+    _opened = true;
+    if (_size == 0) {
+        return;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        close();
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+    _mapping = mapping;
+    _data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (_data == nullptr) {
+        close();
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+#else
+    _fd = ::open(path.c_str(), O_RDONLY);
+    if (_fd < 0) {
+        throw std::runtime_error("Cannot open " + path.string());
+    }
+    struct stat fileStat;
+    if (fstat(_fd, &fileStat) != 0) {
+        close();
+        throw std::runtime_error("Cannot stat " + path.string());
+    }
+    _size = static_cast<size_t>(fileStat.st_size);
+    _opened = true;
+    if (_size == 0) {
+        return;
+    }
+    void* mapped = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        throw std::runtime_error("Cannot map " + path.string());
+    }
+    _data = static_cast<const char*>(mapped);
+#endif
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_opened, other._opened);
+#ifdef _WIN32
+        std::swap(_file, other._file);
+        std::swap(_mapping, other._mapping);
+#else
+        std::swap(_fd, other._fd);
+#endif
+    }
+    return *this;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+    if (_data != nullptr) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr) {
+        CloseHandle(static_cast<HANDLE>(_mapping));
+    }
+    if (_file != nullptr) {
+        CloseHandle(static_cast<HANDLE>(_file));
+    }
+    _mapping = nullptr;
+    _file = nullptr;
+#else
+    if (_data != nullptr) {
+        munmap(const_cast<char*>(_data), _size);
+    }
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+    _fd = -1;
+#endif
+    _data = nullptr;
+    _size = 0;
+    _opened = false;
+}
+
+} // namespace PyMKF
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+
+namespace PyMKF {
+
+// ─── Read-only memory-mapped file ───────────────────────────────────────────
+// Thin RAII wrapper over mmap (POSIX) / CreateFileMapping (Windows) used by
+// the on-disk core index and the NDJSON loaders. The mapping is read-only and
+// private to the process; pages are shared with the OS page cache, so several
+// workers mapping the same file cost one copy of physical memory.
+// An empty file maps to an empty view. Throws std::runtime_error when the file
+// cannot be opened or mapped.
+class MappedFile {
+  public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return _data; }
+    size_t size() const { return _size; }
+    std::string_view view() const { return {_data, _size}; }
+    bool is_open() const { return _opened; }
+
+  private:
+    void close();
+
+    const char* _data = nullptr;
+    size_t _size = 0;
+    bool _opened = false;
+#ifdef _WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#else
+    int _fd = -1;
+#endif
+};
+
+} // namespace PyMKF
@@ -0,0 +1,451 @@
+#include "material_table.h"
+#include "concurrency.h"
+#include "core.h"
+#include "physical_models/ComplexPermeability.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PyMKF {
+
+namespace {
+
+// Cell centres checked per axis when validating a table.
+constexpr size_t validationCellsPerAxis = 8;
+
+const char* property_key(size_t property) {
+    static const char* keys[] = {"permeability", "resistivity", "complexPermeability"};
+    return keys[property];
+}
+
+// Fritsch–Butland node slope: zero at a local extremum, otherwise the
+// harmonic mean of the neighbouring secants, which keeps every cell monotone.
+double monotone_slope(double left, double right) {
+    if (left * right <= 0) {
+        return 0;
+    }
+    return 2 * left * right / (left + right);
+}
+
+// Cubic Hermite between y0 and y1 at t in [0, 1], on a uniform grid.
+double monotone_cubic(double yPrevious, double y0, double y1, double yNext, bool hasPrevious, bool hasNext, double t) {
+    double secant = y1 - y0;
+    double m0 = monotone_slope(hasPrevious ? y0 - yPrevious : secant, secant);
+    double m1 = monotone_slope(secant, hasNext ? yNext - y1 : secant);
+    double t2 = t * t;
+    double t3 = t2 * t;
+    return (2 * t3 - 3 * t2 + 1) * y0 + (t3 - 2 * t2 + t) * m0 + (3 * t2 - 2 * t3) * y1 + (t3 - t2) * m1;
+}
+
+void check_range(const std::string& name, const std::pair<double, double>& range) {
+    if (!(range.first <= range.second)) {
+        throw std::invalid_argument(name + " minimum must not exceed its maximum");
+    }
+}
+
+} // namespace
+
+double TableAxis::node(size_t index) const {
+    if (points == 1) {
+        return minimum;
+    }
+    if (index + 1 == points) {
+        return maximum;
+    }
+    double fraction = static_cast<double>(index) / (points - 1);
+    if (logarithmic) {
+        return minimum * std::pow(maximum / minimum, fraction);
+    }
+    return minimum + (maximum - minimum) * fraction;
+}
+
+bool TableAxis::contains(double value) const {
+    return value >= minimum && value <= maximum;
+}
+
+std::pair<size_t, double> TableAxis::locate(double value) const {
+    if (points == 1) {
+        return {0, 0.0};
+    }
+    double fraction = logarithmic ? std::log(value / minimum) / std::log(maximum / minimum)
+                                  : (value - minimum) / (maximum - minimum);
+    double position = std::clamp(fraction, 0.0, 1.0) * (points - 1);
+    size_t cell = std::min(static_cast<size_t>(position), points - 2);
+    return {cell, position - cell};
+}
+
+PropertyGrid::PropertyGrid(std::vector<TableAxis> axes, size_t numberComponents, const Evaluator& evaluate)
+    : _axes(std::move(axes)), _strides(_axes.size()), _values(numberComponents) {
+    size_t count = 1;
+    for (size_t axis = _axes.size(); axis-- > 0;) {
+        _strides[axis] = count;
+        count *= _axes[axis].points;
+    }
+    for (auto& values : _values) {
+        values.resize(count);
+    }
+    Coordinates coordinates{};
+    for (size_t flat = 0; flat < count; ++flat) {
+        for (size_t axis = 0; axis < _axes.size(); ++axis) {
+            coordinates[axis] = _axes[axis].node(flat / _strides[axis] % _axes[axis].points);
+        }
+        auto sample = evaluate(coordinates);
+        for (size_t component = 0; component < numberComponents; ++component) {
+            _values[component][flat] = sample[component];
+        }
+    }
+}
+
+bool PropertyGrid::contains(const Coordinates& coordinates) const {
+    for (size_t axis = 0; axis < _axes.size(); ++axis) {
+        if (!_axes[axis].contains(coordinates[axis])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+double PropertyGrid::interpolate(size_t component, const Coordinates& coordinates) const {
+    std::array<std::pair<size_t, double>, maxAxes> cells{};
+    for (size_t axis = 0; axis < _axes.size(); ++axis) {
+        cells[axis] = _axes[axis].locate(coordinates[axis]);
+    }
+    return interpolate_axis(component, 0, 0, cells);
+}
+
+// Tensor-product interpolation: one 1-D monotone cubic per axis over the four
+// nodes around the cell, each node value interpolated on the remaining axes.
+double PropertyGrid::interpolate_axis(size_t component, size_t axis, size_t offset,
+                                      const std::array<std::pair<size_t, double>, maxAxes>& cells) const {
+    if (axis == _axes.size()) {
+        return _values[component][offset];
+    }
+    size_t points = _axes[axis].points;
+    if (points == 1) {
+        return interpolate_axis(component, axis + 1, offset, cells);
+    }
+    auto [cell, t] = cells[axis];
+    auto at = [&](size_t node) { return interpolate_axis(component, axis + 1, offset + node * _strides[axis], cells); };
+    bool hasPrevious = cell > 0;
+    bool hasNext = cell + 2 < points;
+    return monotone_cubic(hasPrevious ? at(cell - 1) : 0.0, at(cell), at(cell + 1), hasNext ? at(cell + 2) : 0.0,
+                          hasPrevious, hasNext, t);
+}
+
+double PropertyGrid::validate(const Evaluator& evaluate) const {
+    // Centres of up to validationCellsPerAxis evenly spread cells per axis.
+    std::vector<std::vector<double>> centres(_axes.size());
+    for (size_t axis = 0; axis < _axes.size(); ++axis) {
+        auto& tableAxis = _axes[axis];
+        if (tableAxis.points == 1) {
+            centres[axis].push_back(tableAxis.minimum);
+            continue;
+        }
+        size_t cells = tableAxis.points - 1;
+        size_t stride = std::max<size_t>(1, (cells + validationCellsPerAxis - 1) / validationCellsPerAxis);
+        for (size_t cell = 0; cell < cells; cell += stride) {
+            double low = tableAxis.node(cell);
+            double high = tableAxis.node(cell + 1);
+            centres[axis].push_back(tableAxis.logarithmic ? std::sqrt(low * high) : (low + high) / 2);
+        }
+    }
+
+    std::vector<double> scales(_values.size());
+    for (size_t component = 0; component < _values.size(); ++component) {
+        for (double value : _values[component]) {
+            scales[component] = std::max(scales[component], std::abs(value));
+        }
+    }
+
+    double maximumError = 0;
+    std::vector<size_t> index(_axes.size(), 0);
+    Coordinates coordinates{};
+    while (true) {
+        for (size_t axis = 0; axis < _axes.size(); ++axis) {
+            coordinates[axis] = centres[axis][index[axis]];
+        }
+        auto exact = evaluate(coordinates);
+        for (size_t component = 0; component < _values.size(); ++component) {
+            // Components that cross zero are judged against their full scale.
+            double reference = std::max(std::abs(exact[component]), 1e-6 * scales[component]);
+            if (reference > 0) {
+                maximumError = std::max(maximumError, std::abs(interpolate(component, coordinates) - exact[component]) / reference);
+            }
+        }
+        size_t axis = 0;
+        while (axis < _axes.size() && ++index[axis] == centres[axis].size()) {
+            index[axis++] = 0;
+        }
+        if (axis == _axes.size()) {
+            return maximumError;
+        }
+    }
+}
+
+MaterialPropertyTable::MaterialPropertyTable(json materialJson, std::pair<double, double> temperatureRange,
+                                             std::pair<double, double> magneticFieldDcBiasRange,
+                                             std::pair<double, double> frequencyRange, size_t points,
+                                             double maxRelativeError, size_t maxPoints)
+    : _material(materialJson.is_string() ? CoreMaterial(find_core_material_by_name(materialJson)) : CoreMaterial(materialJson)),
+      _temperatureRange(temperatureRange),
+      _magneticFieldDcBiasRange(magneticFieldDcBiasRange),
+      _frequencyRange(frequencyRange),
+      _points(points),
+      _maxRelativeError(maxRelativeError),
+      _maxPoints(std::max(points, maxPoints)) {
+    check_range("temperature_range", _temperatureRange);
+    check_range("magnetic_field_dc_bias_range", _magneticFieldDcBiasRange);
+    check_range("frequency_range", _frequencyRange);
+    if (_frequencyRange.first <= 0) {
+        throw std::invalid_argument("frequency_range must be positive");
+    }
+    if (_points < 2) {
+        throw std::invalid_argument("points must be at least 2");
+    }
+    if (!(_maxRelativeError > 0)) {
+        throw std::invalid_argument("max_relative_error must be positive");
+    }
+}
+
+std::vector<TableAxis> MaterialPropertyTable::property_axes(Property property, size_t points) const {
+    auto axis = [&](const std::pair<double, double>& range, bool logarithmic) {
+        return TableAxis{range.first, range.second, logarithmic, range.first == range.second ? 1 : points};
+    };
+    switch (property) {
+        case Property::PERMEABILITY:
+            return {axis(_temperatureRange, false), axis(_magneticFieldDcBiasRange, false), axis(_frequencyRange, true)};
+        case Property::RESISTIVITY:
+            return {axis(_temperatureRange, false)};
+        case Property::COMPLEX_PERMEABILITY:
+            return {axis(_frequencyRange, true)};
+    }
+    return {};
+}
+
+// Direct evaluation through the MKF models, on a private copy of the
+// material so concurrent evaluations share nothing.
+PropertyGrid::Evaluator MaterialPropertyTable::evaluator(Property property) const {
+    switch (property) {
+        case Property::PERMEABILITY:
+            return [material = _material](const PropertyGrid::Coordinates& coordinates) mutable {
+                OpenMagnetics::InitialPermeability initialPermeability;
+                return std::vector<double>{initialPermeability.get_initial_permeability(material, coordinates[0], coordinates[1], coordinates[2])};
+            };
+        case Property::RESISTIVITY:
+            return [material = _material,
+                    resistivityModel = OpenMagnetics::ResistivityModel::factory(OpenMagnetics::ResistivityModels::CORE_MATERIAL)](
+                       const PropertyGrid::Coordinates& coordinates) mutable {
+                return std::vector<double>{(*resistivityModel).get_resistivity(material, coordinates[0])};
+            };
+        case Property::COMPLEX_PERMEABILITY:
+            return [material = _material](const PropertyGrid::Coordinates& coordinates) mutable {
+                OpenMagnetics::ComplexPermeability complexPermeabilityObj;
+                auto [realPart, imagPart] = complexPermeabilityObj.get_complex_permeability(material, coordinates[0]);
+                return std::vector<double>{realPart, imagPart};
+            };
+    }
+    throw std::logic_error("unknown material property");
+}
+
+std::shared_ptr<const PropertyGrid> MaterialPropertyTable::grid(Property property) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t slot = static_cast<size_t>(property);
+    if (_grids[slot]) {
+        return _grids[slot];
+    }
+    auto evaluate = evaluator(property);
+    size_t numberComponents = property == Property::COMPLEX_PERMEABILITY ? 2 : 1;
+    size_t points = _points;
+    while (true) {
+        auto candidate = std::make_shared<const PropertyGrid>(property_axes(property, points), numberComponents, evaluate);
+        double error = candidate->validate(evaluate);
+        if (error <= _maxRelativeError || points >= _maxPoints) {
+            _grids[slot] = std::move(candidate);
+            _errors[slot] = error;
+            return _grids[slot];
+        }
+        points = std::min(2 * points - 1, _maxPoints);
+    }
+}
+
+std::vector<std::vector<double>> MaterialPropertyTable::evaluate(Property property, const std::vector<InputSpan>& inputs) {
+    size_t count = 1;
+    for (auto& input : inputs) {
+        if (input.size != 1) {
+            if (count != 1 && input.size != count) {
+                throw std::invalid_argument("inputs must have the same length, or length 1");
+            }
+            count = input.size;
+        }
+    }
+
+    StateReadLock stateLock;
+    auto table = grid(property);
+    std::optional<PropertyGrid::Evaluator> direct;
+    size_t numberComponents = property == Property::COMPLEX_PERMEABILITY ? 2 : 1;
+    std::vector<std::vector<double>> results(numberComponents, std::vector<double>(count));
+    PropertyGrid::Coordinates coordinates{};
+    for (size_t index = 0; index < count; ++index) {
+        for (size_t axis = 0; axis < inputs.size(); ++axis) {
+            coordinates[axis] = inputs[axis].data[inputs[axis].size == 1 ? 0 : index];
+        }
+        if (table->contains(coordinates)) {
+            for (size_t component = 0; component < numberComponents; ++component) {
+                results[component][index] = table->interpolate(component, coordinates);
+            }
+        }
+        else {
+            if (!direct) {
+                direct = evaluator(property);
+            }
+            auto sample = (*direct)(coordinates);
+            for (size_t component = 0; component < numberComponents; ++component) {
+                results[component][index] = sample[component];
+            }
+        }
+    }
+    return results;
+}
+
+py::array_t<double> MaterialPropertyTable::permeability(NumpyArray temperature, NumpyArray magneticFieldDcBias, NumpyArray frequency) {
+    std::vector<InputSpan> inputs{{temperature.data(), static_cast<size_t>(temperature.size())},
+                                  {magneticFieldDcBias.data(), static_cast<size_t>(magneticFieldDcBias.size())},
+                                  {frequency.data(), static_cast<size_t>(frequency.size())}};
+    std::vector<std::vector<double>> results;
+    {
+        py::gil_scoped_release release;
+        results = evaluate(Property::PERMEABILITY, inputs);
+    }
+    return vector_to_numpy(std::move(results[0]));
+}
+
+py::array_t<double> MaterialPropertyTable::resistivity(NumpyArray temperature) {
+    std::vector<InputSpan> inputs{{temperature.data(), static_cast<size_t>(temperature.size())}};
+    std::vector<std::vector<double>> results;
+    {
+        py::gil_scoped_release release;
+        results = evaluate(Property::RESISTIVITY, inputs);
+    }
+    return vector_to_numpy(std::move(results[0]));
+}
+
+py::tuple MaterialPropertyTable::complex_permeability(NumpyArray frequency) {
+    std::vector<InputSpan> inputs{{frequency.data(), static_cast<size_t>(frequency.size())}};
+    std::vector<std::vector<double>> results;
+    {
+        py::gil_scoped_release release;
+        results = evaluate(Property::COMPLEX_PERMEABILITY, inputs);
+    }
+    return py::make_tuple(vector_to_numpy(std::move(results[0])), vector_to_numpy(std::move(results[1])));
+}
+
+void MaterialPropertyTable::build() {
+    StateReadLock stateLock;
+    for (size_t slot = 0; slot < numberProperties; ++slot) {
+        grid(static_cast<Property>(slot));
+    }
+}
+
+json MaterialPropertyTable::info() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    json result = json::object();
+    for (size_t slot = 0; slot < numberProperties; ++slot) {
+        if (!_grids[slot]) {
+            continue;
+        }
+        json points = json::array();
+        for (auto& axis : _grids[slot]->axes()) {
+            points.push_back(axis.points);
+        }
+        result[property_key(slot)] = {{"points", points}, {"errorEstimate", _errors[slot]}};
+    }
+    return result;
+}
+
+void register_material_table_bindings(py::module& m) {
+    py::class_<MaterialPropertyTable>(m, "MaterialPropertyTable",
+        R"pbdoc(
+        Lookup tables of one core material's permeability and resistivity.
+
+        Each property is sampled on a dense grid the first time it is
+        evaluated and then interpolated with monotone cubics, so repeated
+        evaluation costs a table lookup instead of a walk through the
+        material curves. The grid starts at `points` nodes per axis and is
+        refined until the error at the cell centres is within
+        `max_relative_error` (or `max_points` is reached). Points outside the
+        ranges are evaluated directly, as get_material_permeability would.
+
+        The evaluate methods take NumPy arrays (or scalars) and return
+        arrays; inputs of length 1 are broadcast against the others.
+
+        Example:
+            >>> table = PyMKF.MaterialPropertyTable("3C95", temperature_range=(25, 120))
+            >>> mu = table.permeability(np.linspace(25, 120, 10000), 0.0, 100e3)
+            >>> rho = table.resistivity(temperatures)
+        )pbdoc")
+        .def(py::init<json, std::pair<double, double>, std::pair<double, double>, std::pair<double, double>, size_t, double, size_t>(),
+            R"pbdoc(
+            Create the tables; nothing is sampled until first use.
+
+            Args:
+                material: Material name or full CoreMaterial dict.
+                temperature_range: (min, max) temperature in °C.
+                magnetic_field_dc_bias_range: (min, max) DC bias in A/m; a
+                    single value when min == max.
+                frequency_range: (min, max) frequency in Hz, sampled
+                    logarithmically.
+                points: Initial nodes per axis.
+                max_relative_error: Target interpolation error.
+                max_points: Largest number of nodes per axis.
+            )pbdoc",
+            py::arg("material"), py::arg("temperature_range") = std::make_pair(-40.0, 200.0),
+            py::arg("magnetic_field_dc_bias_range") = std::make_pair(0.0, 0.0),
+            py::arg("frequency_range") = std::make_pair(1e3, 10e6), py::arg("points") = 33,
+            py::arg("max_relative_error") = 1e-4, py::arg("max_points") = 257)
+        .def_property_readonly("material_name", &MaterialPropertyTable::material_name,
+            "Name of the tabulated material.")
+        .def("permeability", &MaterialPropertyTable::permeability,
+            R"pbdoc(
+            Initial permeability, as get_material_permeability.
+
+            Args:
+                temperature: Temperatures in °C.
+                magnetic_field_dc_bias: DC bias fields in A/m.
+                frequency: Frequencies in Hz.
+
+            Returns:
+                Array of relative permeabilities.
+            )pbdoc",
+            py::arg("temperature"), py::arg("magnetic_field_dc_bias"), py::arg("frequency"))
+        .def("resistivity", &MaterialPropertyTable::resistivity,
+            R"pbdoc(
+            Resistivity in Ohm·m, as get_material_resistivity.
+
+            Args:
+                temperature: Temperatures in °C.
+            )pbdoc",
+            py::arg("temperature"))
+        .def("complex_permeability", &MaterialPropertyTable::complex_permeability,
+            R"pbdoc(
+            Complex permeability, as calculate_complex_permeability.
+
+            Args:
+                frequency: Frequencies in Hz.
+
+            Returns:
+                (real, imaginary) tuple of arrays.
+            )pbdoc",
+            py::arg("frequency"))
+        .def("build", &MaterialPropertyTable::build,
+            "Sample every table now instead of on first use.",
+            py::call_guard<py::gil_scoped_release>())
+        .def("info", &MaterialPropertyTable::info,
+            R"pbdoc(
+            Built tables, keyed "permeability", "resistivity" and
+            "complexPermeability", each with its nodes per axis ("points")
+            and the interpolation error measured when it was built
+            ("errorEstimate").
+            )pbdoc");
+}
+
+} // namespace PyMKF
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "common.h"
+#include "utils.h"
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace PyMKF {
+
+// ─── Material property lookup tables ────────────────────────────────────────
+// get_material_permeability, get_material_resistivity and
+// calculate_complex_permeability resolve the material and walk its measured
+// curves on every call. Thermal iterations and sweeps evaluate the same
+// material at millions of (temperature, DC bias, frequency) points, so a
+// MaterialPropertyTable samples each property once on a dense grid and then
+// answers from the grid with monotone cubic (Fritsch–Butland) interpolation,
+// which never overshoots the sampled curves.
+//
+// Each table is built on its first evaluation. It starts at `points` nodes
+// per axis and doubles them until the interpolation error at the cell centres
+// is within `maxRelativeError`, or `maxPoints` is reached. Queries outside the
+// table ranges are evaluated directly.
+
+// One grid axis; frequency is spaced logarithmically, the others linearly. A
+// range with minimum == maximum is a single node.
+struct TableAxis {
+    double minimum;
+    double maximum;
+    bool logarithmic;
+    size_t points;
+
+    double node(size_t index) const;
+    bool contains(double value) const;
+    // Cell index and position in the cell (0..1) of `value`, which must be in
+    // range.
+    std::pair<size_t, double> locate(double value) const;
+};
+
+// Samples of one property over up to three axes, the last axis fastest.
+class PropertyGrid {
+  public:
+    static constexpr size_t maxAxes = 3;
+    using Coordinates = std::array<double, maxAxes>;
+    using Evaluator = std::function<std::vector<double>(const Coordinates&)>;
+
+    PropertyGrid(std::vector<TableAxis> axes, size_t numberComponents, const Evaluator& evaluate);
+
+    bool contains(const Coordinates& coordinates) const;
+    double interpolate(size_t component, const Coordinates& coordinates) const;
+    // Largest relative error at the cell centres (sampled when there are many).
+    double validate(const Evaluator& evaluate) const;
+
+    const std::vector<TableAxis>& axes() const { return _axes; }
+
+  private:
+    double interpolate_axis(size_t component, size_t axis, size_t offset,
+                            const std::array<std::pair<size_t, double>, maxAxes>& cells) const;
+
+    std::vector<TableAxis> _axes;
+    std::vector<size_t> _strides;
+    std::vector<std::vector<double>> _values;
+};
+
+class MaterialPropertyTable {
+  public:
+    MaterialPropertyTable(json materialJson, std::pair<double, double> temperatureRange,
+                          std::pair<double, double> magneticFieldDcBiasRange, std::pair<double, double> frequencyRange,
+                          size_t points, double maxRelativeError, size_t maxPoints);
+
+    std::string material_name() const { return _material.get_name(); }
+
+    py::array_t<double> permeability(NumpyArray temperature, NumpyArray magneticFieldDcBias, NumpyArray frequency);
+    py::array_t<double> resistivity(NumpyArray temperature);
+    py::tuple complex_permeability(NumpyArray frequency);
+
+    // Builds every table now instead of on first use.
+    void build();
+    // Per built table: axis nodes and the error estimate of the last build.
+    json info() const;
+
+  private:
+    enum class Property {
+        PERMEABILITY,
+        RESISTIVITY,
+        COMPLEX_PERMEABILITY,
+    };
+    static constexpr size_t numberProperties = 3;
+
+    std::shared_ptr<const PropertyGrid> grid(Property property);
+    std::vector<TableAxis> property_axes(Property property, size_t points) const;
+    PropertyGrid::Evaluator evaluator(Property property) const;
+    struct InputSpan {
+        const double* data;
+        size_t size;
+    };
+    // Every component of `property` at each point, one input per axis of the
+    // table; size-1 inputs are broadcast.
+    std::vector<std::vector<double>> evaluate(Property property, const std::vector<InputSpan>& inputs);
+
+    CoreMaterial _material;
+    std::pair<double, double> _temperatureRange;
+    std::pair<double, double> _magneticFieldDcBiasRange;
+    std::pair<double, double> _frequencyRange;
+    size_t _points;
+    double _maxRelativeError;
+    size_t _maxPoints;
+
+    mutable std::mutex _mutex;
+    std::array<std::shared_ptr<const PropertyGrid>, numberProperties> _grids;
+    std::array<double, numberProperties> _errors{};
+};
+
+void register_material_table_bindings(py::module& m);
+
+} // namespace PyMKF
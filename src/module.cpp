@@ -12,6 +12,12 @@
 #include "settings.h"
 #include "utils.h"
 #include "logging.h"
+#include "snapshot.h"
+#include "session.h"
+#include "progress.h"
+#include "result_handles.h"
+#include "material_table.h"
+#include "design_pipeline.h"
 
 namespace PyMKF {
 
@@ -40,4 +46,10 @@ PYBIND11_MODULE(PyOpenMagnetics, m) {
     PyMKF::register_settings_bindings(m);
     PyMKF::register_utils_bindings(m);
     PyMKF::register_logging_bindings(m);
+    PyMKF::register_snapshot_bindings(m);
+    PyMKF::register_session_bindings(m);
+    PyMKF::register_progress_bindings(m);
+    PyMKF::register_result_handle_bindings(m);
+    PyMKF::register_material_table_bindings(m);
+    PyMKF::register_design_pipeline_bindings(m);
 }
\ No newline at end of file
@@ -0,0 +1,73 @@
+#include "name_index.h"
+
+#include <array>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace PyMKF {
+
+namespace {
+
+constexpr size_t nameIndexDatabaseCount = static_cast<size_t>(NameIndexDatabase::COUNT);
+constexpr size_t nameListCount = static_cast<size_t>(NameList::COUNT);
+
+// Own lock, independent of the MKF state lock: lookups run under either
+// guard, and hits only need the shared side.
+std::shared_mutex nameIndexMutex;
+std::array<std::unordered_map<std::string, json>, nameIndexDatabaseCount> entriesByName;
+std::array<std::optional<json>, nameListCount> nameLists;
+// Bumped by every invalidation; a result computed across one is not stored.
+uint64_t generation = 0;
+
+} // namespace
+
+json find_by_name_indexed(NameIndexDatabase database, const std::string& name, const std::function<json()>& lookup) {
+    auto& entries = entriesByName[static_cast<size_t>(database)];
+    uint64_t lookupGeneration;
+    {
+        std::shared_lock<std::shared_mutex> lock(nameIndexMutex);
+        auto it = entries.find(name);
+        if (it != entries.end()) {
+            return it->second;
+        }
+        lookupGeneration = generation;
+    }
+    json result = lookup();
+    std::unique_lock<std::shared_mutex> lock(nameIndexMutex);
+    if (generation == lookupGeneration) {
+        entries.emplace(name, result);
+    }
+    return result;
+}
+
+json names_indexed(NameList list, const std::function<json()>& build) {
+    auto& names = nameLists[static_cast<size_t>(list)];
+    uint64_t buildGeneration;
+    {
+        std::shared_lock<std::shared_mutex> lock(nameIndexMutex);
+        if (names) {
+            return *names;
+        }
+        buildGeneration = generation;
+    }
+    json result = build();
+    std::unique_lock<std::shared_mutex> lock(nameIndexMutex);
+    if (generation == buildGeneration) {
+        names = result;
+    }
+    return result;
+}
+
+void invalidate_name_indexes() {
+    std::unique_lock<std::shared_mutex> lock(nameIndexMutex);
+    ++generation;
+    for (auto& entries : entriesByName) {
+        entries.clear();
+    }
+    for (auto& names : nameLists) {
+        names.reset();
+    }
+}
+
+} // namespace PyMKF
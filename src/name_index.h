@@ -0,0 +1,46 @@
+#pragma once
+
+#include "common.h"
+
+#include <functional>
+
+namespace PyMKF {
+
+// ─── Memoised name lookups ──────────────────────────────────────────────────
+// The find_*_by_name and get_*_names bindings used to ask MKF and re-serialise
+// the result on every call. These hashed indexes keep the JSON of every entry
+// already looked up, and each name list once built, so repeated calls are a
+// single hash probe. Both are dropped by invalidate_name_indexes(), which
+// every binding that loads or clears a database calls.
+//
+// Lookups that fail (unknown name) are not memoised, so the MKF error path
+// and its lazy database loading behave exactly as before.
+enum class NameIndexDatabase : size_t {
+    CORE_MATERIALS,
+    CORE_SHAPES,
+    WIRES,
+    BOBBINS,
+    INSULATION_MATERIALS,
+    COUNT
+};
+
+enum class NameList : size_t {
+    CORE_MATERIALS,
+    CORE_SHAPES,
+    CORE_SHAPES_WITHOUT_TOROIDS,
+    WIRES,
+    BOBBINS,
+    COUNT
+};
+
+// Returns the memoised JSON for `name`, or calls `lookup` (which may throw)
+// and memoises its result. `lookup` takes whatever state lock MKF needs; a
+// result that raced with an invalidation is returned but not kept.
+json find_by_name_indexed(NameIndexDatabase database, const std::string& name, const std::function<json()>& lookup);
+
+// Returns the memoised name list, building it with `build` on first use.
+json names_indexed(NameList list, const std::function<json()>& build);
+
+void invalidate_name_indexes();
+
+} // namespace PyMKF
@@ -0,0 +1,65 @@
+#include "ndjson.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+namespace PyMKF {
+
+namespace {
+
+// Lines per task: large enough that queue traffic is negligible next to
+// json::parse, small enough that a few huge records still balance.
+constexpr size_t linesPerBlock = 64;
+
+} // namespace
+
+std::vector<std::string_view> split_ndjson_lines(std::string_view text) {
+    std::vector<std::string_view> lines;
+    while (!text.empty()) {
+        size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+    return lines;
+}
+
+std::vector<json> parse_ndjson(std::string_view text, const std::string& origin, int threads) {
+    auto lines = split_ndjson_lines(text);
+    std::vector<json> records(lines.size());
+    std::vector<std::string> errors(lines.size());
+
+    const size_t numberBlocks = (lines.size() + linesPerBlock - 1) / linesPerBlock;
+    parallel_for(numberBlocks, resolve_thread_count(threads, numberBlocks), [&](size_t block) {
+        const size_t end = std::min(lines.size(), (block + 1) * linesPerBlock);
+        for (size_t index = block * linesPerBlock; index < end; ++index) {
+            try {
+                records[index] = json::parse(lines[index]);
+            }
+            catch (const std::exception& exc) {
+                errors[index] = exc.what();
+            }
+        }
+    });
+
+    for (size_t index = 0; index < errors.size(); ++index) {
+        if (!errors[index].empty()) {
+            throw std::runtime_error(origin + ": record " + std::to_string(index + 1) + ": " + errors[index]);
+        }
+    }
+    return records;
+}
+
+std::vector<json> parse_ndjson_file(const std::filesystem::path& path, int threads) {
+    if (!std::filesystem::exists(path)) {
+        return {};
+    }
+    MappedFile file(path);
+    return parse_ndjson(file.view(), path.string(), threads);
+}
+
+} // namespace PyMKF
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "common.h"
+
+#include <string_view>
+
+namespace PyMKF {
+
+// ─── Parallel NDJSON parsing ────────────────────────────────────────────────
+// Shared engine of read_databases, load_magnetics_from_file and
+// load_magnetics_from_string. The text is split on '\n' without copying (a
+// trailing '\r' and blank lines are skipped) and the lines are parsed in
+// blocks on the native pool. Results keep file order. When records fail to
+// parse, the earliest one is reported as
+// std::runtime_error("<origin>: record <n>: <reason>") (n counts non-empty
+// lines from 1), so the message does not depend on thread scheduling.
+std::vector<std::string_view> split_ndjson_lines(std::string_view text);
+
+std::vector<json> parse_ndjson(std::string_view text, const std::string& origin, int threads = 0);
+
+// mmaps `path` and parses it. A missing file yields no records, matching the
+// old std::ifstream loops.
+std::vector<json> parse_ndjson_file(const std::filesystem::path& path, int threads = 0);
+
+} // namespace PyMKF
@@ -1,350 +1,353 @@
 #include "plotting.h"
+#include "concurrency.h"
+#include "losses.h"
+#include "thread_pool.h"
+
+#include <atomic>
 #include <filesystem>
-#include <fstream>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
 
 namespace PyMKF {
 
+namespace {
+
+// Where a Painter writes its SVG. MKF's Painter is bound to a file path and
+// writes to it when the SVG is exported, so without an outputPath the plot
+// goes to a scratch file whose name is unique to this render (concurrent
+// plots never share one) and which is removed once the SVG has been read:
+// the caller only ever sees the returned string.
+class PlotTarget {
+  public:
+    PlotTarget(const std::string& outputPath, const char* kind) {
+        if (!outputPath.empty()) {
+            _path = outputPath;
+            return;
+        }
+        static const uint64_t processTag = (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}();
+        static std::atomic<uint64_t> renderCount{0};
+        std::ostringstream name;
+        name << "pyom_plot_" << kind << "_" << std::hex << processTag << "_" << renderCount.fetch_add(1, std::memory_order_relaxed) << ".svg";
+        _path = std::filesystem::temp_directory_path() / name.str();
+        _scratch = true;
+    }
+    ~PlotTarget() {
+        if (_scratch) {
+            std::error_code ignored;
+            std::filesystem::remove(_path, ignored);
+        }
+    }
+    PlotTarget(const PlotTarget&) = delete;
+    PlotTarget& operator=(const PlotTarget&) = delete;
+
+    const std::filesystem::path& path() const { return _path; }
+
+  private:
+    std::filesystem::path _path;
+    bool _scratch = false;
+};
+
+json svg_result(std::string svgContent) {
+    json result;
+    result["success"] = true;
+    result["svg"] = std::move(svgContent);
+    return result;
+}
+
+json plot_error(const std::exception& exc) {
+    json exception;
+    exception["success"] = false;
+    exception["error"] = "Exception: " + std::string{exc.what()};
+    return exception;
+}
+
+// The turn and wire-loss plots paint litz wires in the simple style. That is
+// a global setting, so those plots take the write lock for the whole painting
+// and set it in a ScopedSettings, which puts the caller's choice back after.
+const json& simple_litz_painting() {
+    static const json overrides = {{"painterSimpleLitz", true}, {"painterAdvancedLitz", false}};
+    return overrides;
+}
+
+} // namespace
+
 json plot_core(json magneticJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_core.svg"
-            : std::filesystem::path(outputPath);
-        
-        // Create the painter and paint the core only
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "core");
+
+        // Paint the core only
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_magnetic(json magneticJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_magnetic.svg"
-            : std::filesystem::path(outputPath);
-        
-        // Create the painter and paint the full magnetic (core, bobbin, coil)
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "magnetic");
+
+        // Paint the full magnetic (core, bobbin, coil)
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
         painter.paint_coil_turns(magnetic);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_magnetic_field(json magneticJson, json operatingPointJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_magnetic_field.svg"
-            : std::filesystem::path(outputPath);
-        OpenMagnetics::Painter painter(filePath);
-        
-        // Paint the magnetic field, core, and coil turns
-        painter.paint_magnetic_field(operatingPoint, magnetic);
+        PlotTarget target(outputPath, "magnetic_field");
+
+        // Paint the magnetic field, core, and coil turns. The field on the
+        // painter grid goes through the field solution cache under its own
+        // kind: it is sampled on painterNumberPointsX/Y, not at the turns.
+        OpenMagnetics::Painter painter(target.path());
+        ComplexField field(cached_field_solution("painterMagneticField", magneticJson, operatingPointJson, [&] {
+            json solved;
+            to_json(solved, painter.calculate_magnetic_field(operatingPoint, magnetic));
+            return solved;
+        }));
+        painter.paint_magnetic_field(operatingPoint, magnetic, 1, field);
         painter.paint_core(magnetic);
         painter.paint_coil_turns(magnetic);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_electric_field(json magneticJson, json operatingPointJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_electric_field.svg"
-            : std::filesystem::path(outputPath);
-        OpenMagnetics::Painter painter(filePath);
-        
+        PlotTarget target(outputPath, "electric_field");
+
         // Paint the electric field, core, and coil turns
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_electric_field(operatingPoint, magnetic);
         painter.paint_core(magnetic);
         painter.paint_coil_turns(magnetic);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_wire(json wireDataJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Wire wire(wireDataJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_wire.svg"
-            : std::filesystem::path(outputPath);
-        
-        // Create the painter and paint the wire
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "wire");
+
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_wire(wire);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_bobbin(json magneticJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        
-        // Use provided path or default to temp directory
-        std::filesystem::path filePath = outputPath.empty() 
-            ? std::filesystem::temp_directory_path() / "pyom_plot_bobbin.svg"
-            : std::filesystem::path(outputPath);
-        
-        // Create the painter and paint the core and bobbin
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "bobbin");
+
+        // Paint the core and bobbin
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
-        
-        // Export and get the SVG string
-        std::string svgContent = painter.export_svg();
-        
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_sections(json magneticJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
+        PlotTarget target(outputPath, "sections");
 
-        std::filesystem::path filePath = outputPath.empty()
-            ? std::filesystem::temp_directory_path() / "pyom_plot_sections.svg"
-            : std::filesystem::path(outputPath);
-
-        OpenMagnetics::Painter painter(filePath);
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
         painter.paint_coil_sections(magnetic);
-
-        std::string svgContent = painter.export_svg();
-
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_layers(json magneticJson, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
+        PlotTarget target(outputPath, "layers");
 
-        std::filesystem::path filePath = outputPath.empty()
-            ? std::filesystem::temp_directory_path() / "pyom_plot_layers.svg"
-            : std::filesystem::path(outputPath);
-
-        OpenMagnetics::Painter painter(filePath);
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
         painter.paint_coil_layers(magnetic);
-
-        std::string svgContent = painter.export_svg();
-
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_turns(json magneticJson, std::string outputPath) {
     try {
+        StateWriteLock stateLock;
+        load_missing_databases();
+        ScopedSettings settingsScope(simple_litz_painting());
         OpenMagnetics::Magnetic magnetic(magneticJson);
 
-        OpenMagnetics::settings.set_painter_simple_litz(true);
-        OpenMagnetics::settings.set_painter_advanced_litz(false);
-
         if (!magnetic.get_coil().get_turns_description()) {
             magnetic.get_mutable_coil().wind();
         }
 
-        std::filesystem::path filePath = outputPath.empty()
-            ? std::filesystem::temp_directory_path() / "pyom_plot_turns.svg"
-            : std::filesystem::path(outputPath);
-
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "turns");
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
         painter.paint_coil_turns(magnetic);
-
-        std::string svgContent = painter.export_svg();
-
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_wire_losses(json magneticJson, json operatingPointJson, std::string outputPath) {
     try {
+        StateWriteLock stateLock;
+        load_missing_databases();
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
 
-        OpenMagnetics::settings.set_painter_simple_litz(true);
-        OpenMagnetics::settings.set_painter_advanced_litz(false);
-
+        json woundMagneticJson = magneticJson;
         if (!magnetic.get_coil().get_turns_description()) {
             magnetic.get_mutable_coil().wind();
+            to_json(woundMagneticJson, magnetic);
         }
 
-        std::filesystem::path filePath = outputPath.empty()
-            ? std::filesystem::temp_directory_path() / "pyom_plot_wire_losses.svg"
-            : std::filesystem::path(outputPath);
+        // With the field solution cache enabled, paint the losses
+        // calculate_winding_losses gives at the ambient temperature, whose
+        // turn field is shared with it, instead of having the painter solve
+        // its own. The losses themselves are always recomputed. This runs
+        // before the painter overrides so the cache key matches that call.
+        std::optional<Outputs> outputs;
+        if (field_solution_cache().enabled()) {
+            outputs = Outputs();
+            outputs->set_winding_losses(winding_losses_from_field_solution(
+                magnetic, operatingPoint, woundMagneticJson, operatingPointJson, operatingPoint.get_conditions().get_ambient_temperature()));
+        }
 
-        OpenMagnetics::Painter painter(filePath);
+        ScopedSettings settingsScope(simple_litz_painting());
+        PlotTarget target(outputPath, "wire_losses");
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_core(magnetic);
         painter.paint_bobbin(magnetic);
         painter.paint_coil_turns(magnetic);
-        painter.paint_wire_losses(magnetic, std::nullopt, operatingPoint);
-
-        std::string svgContent = painter.export_svg();
-
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+        painter.paint_wire_losses(magnetic, outputs, operatingPoint);
+        return svg_result(painter.export_svg());
     }
     catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+        return plot_error(exc);
     }
 }
 
 json plot_temperature_field(json magneticJson, json operatingPointJson, std::string textColor, std::string bgColor, std::string outputPath) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
 
         OpenMagnetics::Temperature temperatureModel(magnetic);
         auto thermalResult = temperatureModel.calculateTemperatures();
 
-        std::filesystem::path filePath = outputPath.empty()
-            ? std::filesystem::temp_directory_path() / "pyom_plot_temperature_field.svg"
-            : std::filesystem::path(outputPath);
-
         double ambientTemp = operatingPoint.get_conditions().get_ambient_temperature();
-        OpenMagnetics::Painter painter(filePath);
+        PlotTarget target(outputPath, "temperature_field");
+        OpenMagnetics::Painter painter(target.path());
         painter.paint_temperature_field(magnetic, thermalResult.nodeTemperatures, true,
             OpenMagnetics::ColorPalette::BLUE_TO_RED, ambientTemp, textColor, bgColor);
+        return svg_result(painter.export_svg());
+    }
+    catch (const std::exception &exc) {
+        return plot_error(exc);
+    }
+}
 
-        std::string svgContent = painter.export_svg();
+// One entry per plot kind accepted by plot_batch, keyed by the name of the
+// single-plot binding without its "plot_" prefix.
+static const std::map<std::string, std::function<json(const json&)>>& batch_plotters() {
+    static const std::map<std::string, std::function<json(const json&)>> plotters = {
+        {"core", [](const json& item) { return plot_core(item.at("magnetic")); }},
+        {"magnetic", [](const json& item) { return plot_magnetic(item.at("magnetic")); }},
+        {"magnetic_field", [](const json& item) { return plot_magnetic_field(item.at("magnetic"), item.at("operatingPoint")); }},
+        {"electric_field", [](const json& item) { return plot_electric_field(item.at("magnetic"), item.at("operatingPoint")); }},
+        {"wire", [](const json& item) { return plot_wire(item.at("wire")); }},
+        {"bobbin", [](const json& item) { return plot_bobbin(item.at("magnetic")); }},
+        {"sections", [](const json& item) { return plot_sections(item.at("magnetic")); }},
+        {"layers", [](const json& item) { return plot_layers(item.at("magnetic")); }},
+        {"turns", [](const json& item) { return plot_turns(item.at("magnetic")); }},
+        {"wire_losses", [](const json& item) { return plot_wire_losses(item.at("magnetic"), item.at("operatingPoint")); }},
+        {"temperature_field", [](const json& item) {
+            return plot_temperature_field(item.at("magnetic"), item.at("operatingPoint"),
+                                          item.value("textColor", std::string("#000000")), item.value("bgColor", std::string("#ffffff")));
+        }},
+    };
+    return plotters;
+}
 
-        json result;
-        result["success"] = true;
-        result["svg"] = svgContent;
-        return result;
+json plot_batch(json itemsJson, int threads) {
+    if (!itemsJson.is_array()) {
+        return json::array({plot_error(std::invalid_argument("plot_batch expects a list of plot requests"))});
     }
-    catch (const std::exception &exc) {
-        json exception;
-        exception["success"] = false;
-        exception["error"] = "Exception: " + std::string{exc.what()};
-        return exception;
+    // Load the databases once up front rather than racing to in the first
+    // few workers.
+    {
+        StateReadLockWithDatabases stateLock;
     }
+    std::vector<json> results(itemsJson.size());
+    parallel_for(results.size(), resolve_thread_count(threads, results.size()), [&](size_t index) {
+        try {
+            auto& item = itemsJson[index];
+            std::string kind = item.at("kind");
+            auto plotter = batch_plotters().find(kind);
+            if (plotter == batch_plotters().end()) {
+                throw std::invalid_argument("Unknown plot kind: " + kind);
+            }
+            results[index] = plotter->second(item);
+        }
+        catch (const std::exception &exc) {
+            results[index] = plot_error(exc);
+        }
+    });
+    return json(std::move(results));
 }
 
 void register_plotting_bindings(py::module& m) {
@@ -354,7 +357,7 @@ void register_plotting_bindings(py::module& m) {
         
         Args:
             magneticJson: JSON object with complete magnetic specification (core + coil).
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
         
         Returns:
             JSON object with:
@@ -372,7 +375,7 @@ void register_plotting_bindings(py::module& m) {
         
         Args:
             magneticJson: JSON object with complete magnetic specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
         
         Returns:
             JSON object with:
@@ -392,7 +395,7 @@ void register_plotting_bindings(py::module& m) {
         Args:
             magneticJson: JSON object with complete magnetic specification.
             operatingPointJson: Operating conditions including excitation currents.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
         
         Returns:
             JSON object with:
@@ -412,7 +415,7 @@ void register_plotting_bindings(py::module& m) {
         Args:
             magneticJson: JSON object with complete magnetic specification.
             operatingPointJson: Operating conditions including excitation voltages.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
         
         Returns:
             JSON object with:
@@ -431,7 +434,7 @@ void register_plotting_bindings(py::module& m) {
         
         Args:
             wireDataJson: JSON object with wire specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
         
         Returns:
             JSON object with:
@@ -447,7 +450,7 @@ void register_plotting_bindings(py::module& m) {
 
         Args:
             magneticJson: JSON object with complete magnetic specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with:
@@ -465,7 +468,7 @@ void register_plotting_bindings(py::module& m) {
 
         Args:
             magneticJson: JSON object with complete magnetic specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with success and svg fields.
@@ -480,7 +483,7 @@ void register_plotting_bindings(py::module& m) {
 
         Args:
             magneticJson: JSON object with complete magnetic specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with success and svg fields.
@@ -496,7 +499,7 @@ void register_plotting_bindings(py::module& m) {
 
         Args:
             magneticJson: JSON object with complete magnetic specification.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with success and svg fields.
@@ -512,7 +515,7 @@ void register_plotting_bindings(py::module& m) {
         Args:
             magneticJson: JSON object with complete magnetic specification.
             operatingPointJson: Operating conditions including excitation currents.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with success and svg fields.
@@ -531,13 +534,49 @@ void register_plotting_bindings(py::module& m) {
             operatingPointJson: Operating conditions.
             textColor: Color string for text elements.
             bgColor: Color string for background.
-            outputPath: Optional file path to save SVG. If empty, uses temp directory.
+            outputPath: Optional file path to save SVG. If empty, the SVG is only returned.
 
         Returns:
             JSON object with success and svg fields.
         )pbdoc",
         py::arg("magneticJson"), py::arg("operatingPointJson"),
         py::arg("textColor"), py::arg("bgColor"), py::arg("outputPath") = "");
+
+    m.def("plot_batch", &plot_batch,
+        R"pbdoc(
+        Render many plots in parallel and return their SVGs.
+
+        Each request names one of the single-plot functions by its suffix and
+        carries that function's inputs. Nothing is left on disk and concurrent
+        renders never share a scratch file, so batches from several threads
+        can run at the same time.
+
+        Args:
+            items: List of plot requests, each a dict with:
+                - kind: "core", "magnetic", "magnetic_field", "electric_field",
+                  "wire", "bobbin", "sections", "layers", "turns",
+                  "wire_losses" or "temperature_field"
+                - magnetic: Magnetic specification (all kinds but "wire")
+                - wire: Wire specification (kind "wire")
+                - operatingPoint: Operating point (field, loss and
+                  temperature kinds)
+                - textColor, bgColor: Optional colors for "temperature_field"
+            threads: Worker threads; 0 or less uses all hardware threads.
+
+        Returns:
+            List with one {success, svg} or {success, error} dict per
+            request, in request order. A failed request does not affect the
+            others.
+
+        Example:
+            >>> results = PyMKF.plot_batch([
+            ...     {"kind": "magnetic", "magnetic": magnetic},
+            ...     {"kind": "wire", "wire": wire},
+            ... ])
+            >>> svgs = [r["svg"] for r in results if r["success"]]
+        )pbdoc",
+        py::arg("items"), py::arg("threads") = 0,
+        py::call_guard<py::gil_scoped_release>());
 }
 
 } // namespace PyMKF} // namespace PyMKF
\ No newline at end of file
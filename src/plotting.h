@@ -16,6 +16,9 @@ json plot_turns(json magneticJson, std::string outputPath = "");
 json plot_wire_losses(json magneticJson, json operatingPointJson, std::string outputPath = "");
 json plot_temperature_field(json magneticJson, json operatingPointJson, std::string textColor, std::string bgColor, std::string outputPath = "");
 
+// Renders a list of {"kind", ...} plot requests in parallel
+json plot_batch(json itemsJson, int threads = 0);
+
 // Register all plotting bindings
 void register_plotting_bindings(py::module& m);
 
@@ -0,0 +1,328 @@
+#include "profiling.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace PyMKF {
+
+namespace profiling_detail {
+
+std::atomic<bool> enabled{false};
+
+constexpr uint32_t noNode = UINT32_MAX;
+constexpr size_t nodeChunkSize = 256;
+constexpr size_t nodeChunkCount = 64;
+constexpr size_t counterCapacity = 128;
+
+// Every field is atomic because get_profile() reads while the owner writes.
+// The owner is the only writer, so updates are plain load + store: no locked
+// read-modify-write on the hot path.
+struct ProfileNode {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint32_t> parent{noNode};
+    std::atomic<uint64_t> calls{0};
+    std::atomic<uint64_t> totalNs{0};
+};
+
+struct ProfileCounter {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> value{0};
+};
+
+template <typename T>
+void relaxed_add(std::atomic<T>& target, T amount) {
+    target.store(target.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+// Bumped by reset_profile(); a thread whose records carry an older epoch is
+// ignored by readers and clears itself when it next has no open scope.
+std::atomic<uint64_t> profileEpoch{0};
+
+struct ThreadProfile {
+    // Nodes live in fixed chunks so a reader never sees storage move.
+    std::array<std::atomic<ProfileNode*>, nodeChunkCount> chunks{};
+    std::atomic<uint32_t> nodeCount{0};
+    std::array<ProfileCounter, counterCapacity> counters;
+    std::atomic<uint32_t> counterCount{0};
+    std::atomic<uint64_t> epoch{0};
+
+    // Owner-thread only.
+    std::map<std::pair<uint32_t, const char*>, uint32_t> children;
+    uint32_t current = noNode;
+    uint32_t openScopes = 0;
+
+    ~ThreadProfile() {
+        for (auto& chunk : chunks) {
+            delete[] chunk.load(std::memory_order_relaxed);
+        }
+    }
+
+    ProfileNode& node(uint32_t index) const {
+        return chunks[index / nodeChunkSize].load(std::memory_order_acquire)[index % nodeChunkSize];
+    }
+
+    uint32_t add_node(const char* name, uint32_t parent) {
+        uint32_t index = nodeCount.load(std::memory_order_relaxed);
+        if (index >= nodeChunkSize * nodeChunkCount) {
+            return noNode;
+        }
+        auto& chunk = chunks[index / nodeChunkSize];
+        if (chunk.load(std::memory_order_relaxed) == nullptr) {
+            chunk.store(new ProfileNode[nodeChunkSize], std::memory_order_release);
+        }
+        auto& added = node(index);
+        added.name.store(name, std::memory_order_relaxed);
+        added.parent.store(parent, std::memory_order_relaxed);
+        added.calls.store(0, std::memory_order_relaxed);
+        added.totalNs.store(0, std::memory_order_relaxed);
+        nodeCount.store(index + 1, std::memory_order_release);
+        return index;
+    }
+
+    void clear(uint64_t newEpoch) {
+        nodeCount.store(0, std::memory_order_release);
+        counterCount.store(0, std::memory_order_release);
+        children.clear();
+        epoch.store(newEpoch, std::memory_order_release);
+    }
+};
+
+namespace {
+
+struct ScopeTotals {
+    std::string name;
+    size_t depth = 0;
+    uint64_t calls = 0;
+    uint64_t totalNs = 0;
+};
+
+struct ProfileRegistry {
+    std::mutex mutex;
+    std::vector<ThreadProfile*> live;
+    // Records of threads that have exited (pool workers are per call).
+    std::map<std::string, ScopeTotals> retiredScopes;
+    std::map<std::string, uint64_t> retiredCounters;
+    size_t retiredThreads = 0;
+};
+
+// Leaked on purpose: thread_local destructors may run after static ones.
+ProfileRegistry& registry() {
+    static auto* instance = new ProfileRegistry();
+    return *instance;
+}
+
+// Must be called with the registry mutex held.
+bool collect(const ThreadProfile& profile, std::map<std::string, ScopeTotals>& scopes, std::map<std::string, uint64_t>& counters) {
+    if (profile.epoch.load(std::memory_order_acquire) != profileEpoch.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    uint32_t count = profile.nodeCount.load(std::memory_order_acquire);
+    std::vector<std::string> paths(count);
+    std::vector<size_t> depths(count, 0);
+    for (uint32_t index = 0; index < count; ++index) {
+        auto& node = profile.node(index);
+        const char* name = node.name.load(std::memory_order_relaxed);
+        uint32_t parent = node.parent.load(std::memory_order_relaxed);
+        // Parents are always recorded before their children.
+        if (parent != noNode && parent < index) {
+            paths[index] = paths[parent] + ";" + name;
+            depths[index] = depths[parent] + 1;
+        }
+        else {
+            paths[index] = name;
+        }
+        auto& totals = scopes[paths[index]];
+        totals.name = name;
+        totals.depth = depths[index];
+        totals.calls += node.calls.load(std::memory_order_relaxed);
+        totals.totalNs += node.totalNs.load(std::memory_order_relaxed);
+    }
+    uint32_t counterCount = profile.counterCount.load(std::memory_order_acquire);
+    for (uint32_t index = 0; index < counterCount; ++index) {
+        counters[profile.counters[index].name.load(std::memory_order_relaxed)] +=
+            profile.counters[index].value.load(std::memory_order_relaxed);
+    }
+    return count > 0 || counterCount > 0;
+}
+
+struct ThreadProfileHandle {
+    ThreadProfile* profile = nullptr;
+
+    ~ThreadProfileHandle() {
+        if (!profile) {
+            return;
+        }
+        auto& profiles = registry();
+        std::lock_guard<std::mutex> lock(profiles.mutex);
+        if (collect(*profile, profiles.retiredScopes, profiles.retiredCounters)) {
+            ++profiles.retiredThreads;
+        }
+        std::erase(profiles.live, profile);
+        delete profile;
+    }
+};
+
+thread_local ThreadProfileHandle threadProfile;
+
+ThreadProfile& this_thread_profile() {
+    if (!threadProfile.profile) {
+        auto* profile = new ThreadProfile();
+        profile->epoch.store(profileEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        auto& profiles = registry();
+        std::lock_guard<std::mutex> lock(profiles.mutex);
+        profiles.live.push_back(profile);
+        threadProfile.profile = profile;
+    }
+    auto& profile = *threadProfile.profile;
+    uint64_t epoch = profileEpoch.load(std::memory_order_relaxed);
+    if (profile.openScopes == 0 && profile.epoch.load(std::memory_order_relaxed) != epoch) {
+        profile.clear(epoch);
+    }
+    return profile;
+}
+
+} // namespace
+
+} // namespace profiling_detail
+
+using namespace profiling_detail;
+
+void ProfileScope::begin(const char* name) {
+    auto& profile = this_thread_profile();
+    uint32_t parent = profile.current;
+    auto key = std::make_pair(parent, name);
+    auto child = profile.children.find(key);
+    uint32_t node;
+    if (child != profile.children.end()) {
+        node = child->second;
+    }
+    else {
+        node = profile.add_node(name, parent);
+        if (node == noNode) {
+            return;
+        }
+        profile.children.emplace(key, node);
+    }
+    _profile = &profile;
+    _node = node;
+    _parent = parent;
+    profile.current = node;
+    ++profile.openScopes;
+    _start = std::chrono::steady_clock::now();
+}
+
+void ProfileScope::end() {
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+    auto& node = _profile->node(_node);
+    relaxed_add<uint64_t>(node.calls, 1);
+    relaxed_add<uint64_t>(node.totalNs, static_cast<uint64_t>(elapsed));
+    _profile->current = _parent;
+    --_profile->openScopes;
+}
+
+void profile_count_slow(const char* name, uint64_t amount) {
+    auto& profile = this_thread_profile();
+    uint32_t count = profile.counterCount.load(std::memory_order_relaxed);
+    for (uint32_t index = 0; index < count; ++index) {
+        if (profile.counters[index].name.load(std::memory_order_relaxed) == name) {
+            relaxed_add(profile.counters[index].value, amount);
+            return;
+        }
+    }
+    if (count < counterCapacity) {
+        profile.counters[count].name.store(name, std::memory_order_relaxed);
+        profile.counters[count].value.store(amount, std::memory_order_relaxed);
+        profile.counterCount.store(count + 1, std::memory_order_release);
+    }
+}
+
+void enable_profiling(bool reset) {
+    if (reset) {
+        reset_profile();
+    }
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable_profiling() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void reset_profile() {
+    auto& profiles = registry();
+    std::lock_guard<std::mutex> lock(profiles.mutex);
+    profileEpoch.fetch_add(1, std::memory_order_relaxed);
+    profiles.retiredScopes.clear();
+    profiles.retiredCounters.clear();
+    profiles.retiredThreads = 0;
+}
+
+json get_profile() {
+    std::map<std::string, ScopeTotals> scopes;
+    std::map<std::string, uint64_t> counters;
+    size_t threads = 0;
+    {
+        auto& profiles = registry();
+        std::lock_guard<std::mutex> lock(profiles.mutex);
+        scopes = profiles.retiredScopes;
+        counters = profiles.retiredCounters;
+        threads = profiles.retiredThreads;
+        for (auto* profile : profiles.live) {
+            if (collect(*profile, scopes, counters)) {
+                ++threads;
+            }
+        }
+    }
+
+    std::map<std::string, uint64_t> childrenNs;
+    for (auto& [path, totals] : scopes) {
+        auto separator = path.rfind(';');
+        if (separator != std::string::npos) {
+            childrenNs[path.substr(0, separator)] += totals.totalNs;
+        }
+    }
+
+    std::vector<const std::pair<const std::string, ScopeTotals>*> order;
+    for (auto& entry : scopes) {
+        order.push_back(&entry);
+    }
+    std::stable_sort(order.begin(), order.end(), [](auto* a, auto* b) {
+        return a->second.totalNs > b->second.totalNs;
+    });
+
+    json result;
+    result["enabled"] = profiling_enabled();
+    result["threads"] = threads;
+    result["scopes"] = json::array();
+    std::string folded;
+    for (auto* entry : order) {
+        auto& [path, totals] = *entry;
+        uint64_t childNs = childrenNs.count(path) ? childrenNs[path] : 0;
+        uint64_t selfNs = totals.totalNs > childNs ? totals.totalNs - childNs : 0;
+        json scope;
+        scope["path"] = path;
+        scope["name"] = totals.name;
+        scope["depth"] = totals.depth;
+        scope["calls"] = totals.calls;
+        scope["totalMs"] = totals.totalNs * 1e-6;
+        scope["selfMs"] = selfNs * 1e-6;
+        result["scopes"].push_back(std::move(scope));
+    }
+    for (auto& [path, totals] : scopes) {
+        uint64_t childNs = childrenNs.count(path) ? childrenNs[path] : 0;
+        uint64_t selfUs = (totals.totalNs > childNs ? totals.totalNs - childNs : 0) / 1000;
+        if (selfUs > 0) {
+            folded += path + " " + std::to_string(selfUs) + "\n";
+        }
+    }
+    result["folded"] = folded;
+    result["counters"] = json::object();
+    for (auto& [name, value] : counters) {
+        result["counters"][name] = value;
+    }
+    return result;
+}
+
+} // namespace PyMKF
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "common.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace PyMKF {
+
+// ─── Hot-path profiling ─────────────────────────────────────────────────────
+// PYMKF_PROFILE_SCOPE("MagneticSimulator::simulate") times the enclosing block
+// into a call tree keyed by the stack of scopes open on the current thread;
+// PYMKF_PROFILE_COUNT("name", n) adds to a counter. Every thread writes only
+// its own records (relaxed atomics, no locks on the hot path) and
+// get_profile() merges them by scope path, so worker threads of a parallel
+// sweep each contribute their own tree.
+//
+// Off by default: a scope then costs one relaxed atomic load. Names must be
+// string literals, because records are looked up by address. A thread keeps
+// at most 16384 distinct scope paths; deeper or later ones are not recorded.
+namespace profiling_detail {
+extern std::atomic<bool> enabled;
+struct ThreadProfile;
+}
+
+inline bool profiling_enabled() {
+    return profiling_detail::enabled.load(std::memory_order_relaxed);
+}
+
+class ProfileScope {
+  public:
+    explicit ProfileScope(const char* name) {
+        if (profiling_enabled()) {
+            begin(name);
+        }
+    }
+    ~ProfileScope() {
+        if (_profile) {
+            end();
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    void begin(const char* name);
+    void end();
+
+    profiling_detail::ThreadProfile* _profile = nullptr;
+    uint32_t _node = 0;
+    uint32_t _parent = 0;
+    std::chrono::steady_clock::time_point _start;
+};
+
+void profile_count_slow(const char* name, uint64_t amount);
+
+inline void profile_count(const char* name, uint64_t amount = 1) {
+    if (profiling_enabled()) {
+        profile_count_slow(name, amount);
+    }
+}
+
+// `reset` drops everything recorded so far. Threads that are inside a scope
+// when the profile is reset drop their records once that scope closes.
+void enable_profiling(bool reset = true);
+void disable_profiling();
+void reset_profile();
+
+// {"enabled", "threads", "scopes": [{"path", "name", "depth", "calls",
+// "totalMs", "selfMs"}, ...] (heaviest first), "counters": {name: value},
+// "folded": "outer;inner <self µs>\n..."} — the last in the collapsed-stack
+// format flamegraph.pl and speedscope read.
+json get_profile();
+
+} // namespace PyMKF
+
+#define PYMKF_PROFILE_CONCAT_INNER(a, b) a##b
+#define PYMKF_PROFILE_CONCAT(a, b) PYMKF_PROFILE_CONCAT_INNER(a, b)
+#define PYMKF_PROFILE_SCOPE(name) ::PyMKF::ProfileScope PYMKF_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PYMKF_PROFILE_COUNT(name, amount) ::PyMKF::profile_count(name, amount)
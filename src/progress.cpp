@@ -0,0 +1,80 @@
+#include "progress.h"
+
+namespace PyMKF {
+
+ProgressReporter::ProgressReporter(py::object callback, std::shared_ptr<CancellationToken> token, double minimumIntervalMs)
+    : _callback(std::move(callback)),
+      _token(std::move(token)),
+      _minimumIntervalMs(minimumIntervalMs) {
+    _hasCallback = _callback && !_callback.is_none();
+}
+
+ProgressReporter::~ProgressReporter() {
+    // The search may end on a thread that released the GIL; dropping the
+    // last reference to the callable must not.
+    if (_callback) {
+        py::gil_scoped_acquire acquire;
+        _callback = py::object();
+    }
+}
+
+void ProgressReporter::report(const SearchProgress& progress, bool force) {
+    // A callback that raised is not called again; one that asked to stop
+    // still gets the final report.
+    if (!_hasCallback || !_callbackError.empty()) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (!force && _lastReport &&
+        std::chrono::duration<double, std::milli>(now - *_lastReport).count() < _minimumIntervalMs) {
+        return;
+    }
+    _lastReport = now;
+
+    py::gil_scoped_acquire acquire;
+    try {
+        py::dict progressDict;
+        progressDict["phase"] = progress.phase;
+        progressDict["evaluated"] = progress.evaluated;
+        progressDict["total"] = progress.total;
+        progressDict["bestScore"] = progress.bestScore ? py::object(py::float_(*progress.bestScore)) : py::object(py::none());
+        progressDict["elapsedMs"] = progress.elapsedMs;
+        py::object answer = _callback(progressDict);
+        if (py::isinstance<py::bool_>(answer) && !answer.cast<bool>()) {
+            _stopRequested = true;
+        }
+    }
+    catch (py::error_already_set& e) {
+        _callbackError = e.what();
+        _stopRequested = true;
+    }
+}
+
+bool ProgressReporter::cancelled() const {
+    return _stopRequested || (_token && _token->cancelled());
+}
+
+void register_progress_bindings(py::module& m) {
+    py::class_<CancellationToken, std::shared_ptr<CancellationToken>>(m, "CancellationToken",
+        R"pbdoc(
+        Flag for stopping a running adviser or converter design.
+
+        Pass it as cancellation_token= and call cancel() from any other
+        thread. An interruptible search stops before its next step and
+        returns the best designs found so far with "cancelled": True; a
+        plain one is skipped if the token is cancelled before it starts.
+
+        Example:
+            >>> token = PyMKF.CancellationToken()
+            >>> threading.Timer(5.0, token.cancel).start()
+            >>> result = PyMKF.calculate_advised_magnetics(inputs, 5, "standard cores",
+            ...                                            cancellation_token=token, interruptible=True)
+        )pbdoc")
+        .def(py::init<>())
+        .def("cancel", &CancellationToken::cancel, "Request the search to stop.")
+        .def("reset", &CancellationToken::reset, "Clear the flag so the token can be reused.")
+        .def_property_readonly("cancelled", &CancellationToken::cancelled,
+            "True once cancel() has been called.");
+}
+
+} // namespace PyMKF
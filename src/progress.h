@@ -0,0 +1,81 @@
+#pragma once
+
+#include "common.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+
+namespace PyMKF {
+
+// ─── Progress reporting and cooperative cancellation ────────────────────────
+// The adviser and converter-design bindings run for minutes with the GIL
+// released. A CancellationToken is a flag another Python thread (a web
+// request handler, a UI) can set while the search runs; the search checks it
+// between adviser steps and returns what it has so far. A ProgressReporter
+// wraps an optional Python callable that receives a progress dict; it
+// reacquires the GIL only for the call itself and is rate-limited, so a
+// callback that does I/O does not slow the search down.
+class CancellationToken {
+  public:
+    void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+    void reset() { _cancelled.store(false, std::memory_order_relaxed); }
+    bool cancelled() const { return _cancelled.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<bool> _cancelled{false};
+};
+
+struct SearchProgress {
+    std::string phase;
+    size_t evaluated = 0;
+    size_t total = 0;
+    std::optional<double> bestScore;
+    double elapsedMs = 0;
+};
+
+class ProgressReporter {
+  public:
+    // Minimum time between two callback invocations; the final report of a
+    // search is always delivered.
+    static constexpr double DEFAULT_INTERVAL_MS = 100;
+
+    // Construct with the GIL held. `callback` may be None and `token` null.
+    ProgressReporter(py::object callback, std::shared_ptr<CancellationToken> token,
+                     double minimumIntervalMs = DEFAULT_INTERVAL_MS);
+    ~ProgressReporter();
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    // Either a callback or a token was given. This does not by itself make
+    // a search stepwise; the bindings take an explicit `interruptible`.
+    bool active() const { return _hasCallback || _token != nullptr; }
+
+    // Callable without the GIL. Invokes the callback unless the previous call
+    // was less than the minimum interval ago (`force` bypasses the limit). A
+    // callback that returns False or raises stops the search, exactly as a
+    // cancelled token does. The search calls this while holding the state
+    // lock; threads waiting for that lock release the GIL first (see
+    // concurrency.h), so acquiring it here cannot deadlock against them.
+    void report(const SearchProgress& progress, bool force = false);
+
+    // True once the token was cancelled or the callback asked to stop.
+    bool cancelled() const;
+
+    // Message of the exception raised by the callback, if any.
+    const std::string& callback_error() const { return _callbackError; }
+
+  private:
+    py::object _callback;
+    bool _hasCallback;
+    std::shared_ptr<CancellationToken> _token;
+    double _minimumIntervalMs;
+    std::optional<std::chrono::steady_clock::time_point> _lastReport;
+    bool _stopRequested = false;
+    std::string _callbackError;
+};
+
+void register_progress_bindings(py::module& m);
+
+} // namespace PyMKF
@@ -0,0 +1,90 @@
+#include "result_cache.h"
+#include "settings.h"
+
+namespace PyMKF {
+
+std::optional<json> JsonResultCache::get(const std::string& key) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_maxEntries == 0) {
+        return std::nullopt;
+    }
+    auto it = _index.find(key);
+    if (it == _index.end()) {
+        _misses++;
+        return std::nullopt;
+    }
+    _entries.splice(_entries.begin(), _entries, it->second);
+    _hits++;
+    return it->second->value;
+}
+
+void JsonResultCache::put(const std::string& key, const json& value) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_maxEntries == 0) {
+        return;
+    }
+    size_t bytes = key.size() + value.dump().size();
+    if (_maxBytes > 0 && bytes > _maxBytes) {
+        return;
+    }
+
+    auto it = _index.find(key);
+    if (it != _index.end()) {
+        auto entry = it->second;
+        _index.erase(it);
+        _bytes -= entry->bytes;
+        _entries.erase(entry);
+    }
+    _entries.push_front({key, value, bytes});
+    _index.emplace(std::string_view(_entries.front().key), _entries.begin());
+    _bytes += bytes;
+    evict_to_limits();
+}
+
+void JsonResultCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _index.clear();
+    _bytes = 0;
+}
+
+void JsonResultCache::configure(size_t maxEntries, size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxEntries = maxEntries;
+    _maxBytes = maxBytes;
+    evict_to_limits();
+}
+
+bool JsonResultCache::enabled() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxEntries > 0;
+}
+
+json JsonResultCache::stats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    json result;
+    result["hits"] = _hits;
+    result["misses"] = _misses;
+    result["evictions"] = _evictions;
+    result["entries"] = _entries.size();
+    result["bytes"] = _bytes;
+    result["maxEntries"] = _maxEntries;
+    result["maxBytes"] = _maxBytes;
+    return result;
+}
+
+void JsonResultCache::evict_to_limits() {
+    while (!_entries.empty() && (_entries.size() > _maxEntries || (_maxBytes > 0 && _bytes > _maxBytes))) {
+        auto& oldest = _entries.back();
+        _bytes -= oldest.bytes;
+        _index.erase(std::string_view(oldest.key));
+        _entries.pop_back();
+        _evictions++;
+    }
+}
+
+std::string canonical_cache_key(const std::string& function, const json& arguments) {
+    return function + '\n' + arguments.dump() + '\n' + get_settings().dump();
+}
+
+} // namespace PyMKF
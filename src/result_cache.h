@@ -0,0 +1,63 @@
+#pragma once
+
+#include "common.h"
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+namespace PyMKF {
+
+// ─── Bounded LRU cache of JSON results ──────────────────────────────────────
+// Maps a canonical request string (see canonical_cache_key) to the JSON a
+// binding returned for it. Bounded both by entry count and by the serialized
+// size of keys plus values; the least recently used entries go first. A
+// capacity of zero entries disables the cache, which is the default, so
+// nothing is retained unless the caller opts in.
+//
+// Thread-safe on its own mutex, independent of the MKF state lock, so cache
+// hits from concurrent simulate() calls do not serialise on each other.
+class JsonResultCache {
+  public:
+    std::optional<json> get(const std::string& key);
+    void put(const std::string& key, const json& value);
+    void clear();
+
+    // maxEntries == 0 disables the cache; maxBytes == 0 means no byte limit.
+    void configure(size_t maxEntries, size_t maxBytes);
+    bool enabled() const;
+
+    // {"hits", "misses", "evictions", "entries", "bytes", "maxEntries", "maxBytes"}
+    json stats() const;
+
+  private:
+    struct Entry {
+        std::string key;
+        json value;
+        size_t bytes;
+    };
+
+    void evict_to_limits();
+
+    mutable std::mutex _mutex;
+    std::list<Entry> _entries;  // most recently used first
+    // Keyed by the full request string, viewed in place in its Entry (list
+    // nodes never move), so distinct keys never share a slot.
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> _index;
+    size_t _maxEntries = 0;
+    size_t _maxBytes = 0;
+    size_t _bytes = 0;
+    size_t _hits = 0;
+    size_t _misses = 0;
+    size_t _evictions = 0;
+};
+
+// Stable key for a request: nlohmann::json keeps object keys sorted, so
+// dump() of the arguments is canonical regardless of dict insertion order.
+// The complete get_settings() snapshot is appended because MKF results depend
+// on it. Call under a StateReadLock.
+std::string canonical_cache_key(const std::string& function, const json& arguments);
+
+} // namespace PyMKF
@@ -0,0 +1,195 @@
+#include "result_handles.h"
+
+namespace PyMKF {
+
+std::optional<std::string> MagneticHandle::reference() const {
+    auto manufacturerInfo = _magnetic->get_manufacturer_info();
+    if (!manufacturerInfo) {
+        return std::nullopt;
+    }
+    return manufacturerInfo->get_reference();
+}
+
+std::optional<std::string> MagneticHandle::core_name() const {
+    return _magnetic->get_core().get_name();
+}
+
+std::string MagneticHandle::core_shape() const {
+    return _magnetic->get_mutable_core().get_shape_name();
+}
+
+std::string MagneticHandle::core_material() const {
+    return _magnetic->get_mutable_core().get_material_name();
+}
+
+std::vector<std::string> MagneticHandle::winding_names() const {
+    std::vector<std::string> names;
+    for (auto& winding : _magnetic->get_coil().get_functional_description()) {
+        names.push_back(winding.get_name());
+    }
+    return names;
+}
+
+std::vector<int64_t> MagneticHandle::number_turns() const {
+    std::vector<int64_t> numberTurns;
+    for (auto& winding : _magnetic->get_coil().get_functional_description()) {
+        numberTurns.push_back(winding.get_number_turns());
+    }
+    return numberTurns;
+}
+
+json MagneticHandle::core() const {
+    json result;
+    to_json(result, _magnetic->get_core());
+    return result;
+}
+
+json MagneticHandle::coil() const {
+    json result;
+    to_json(result, _magnetic->get_coil());
+    return result;
+}
+
+json MagneticHandle::as_json() const {
+    json result;
+    to_json(result, *_magnetic);
+    return result;
+}
+
+json MasHandle::inputs() const {
+    json result;
+    to_json(result, _mas->get_inputs());
+    return result;
+}
+
+json MasHandle::outputs() const {
+    json result = json::array();
+    for (auto& output : _mas->get_outputs()) {
+        json outputJson;
+        to_json(outputJson, output);
+        result.push_back(std::move(outputJson));
+    }
+    return result;
+}
+
+json MasHandle::as_json() const {
+    json result;
+    to_json(result, *_mas);
+    return result;
+}
+
+json MasHandle::as_result_json() const {
+    json result;
+    result["mas"] = as_json();
+    result["scoring"] = _scoring;
+    if (!_scoringPerFilter.is_null()) {
+        result["scoringPerFilter"] = _scoringPerFilter;
+    }
+    return result;
+}
+
+void register_result_handle_bindings(py::module& m) {
+    py::class_<MagneticHandle>(m, "MagneticHandle",
+        R"pbdoc(
+        Read-only view of a native Magnetic held by a MasHandle.
+
+        The names and turns are read from the C++ object directly; core, coil
+        and to_dict() convert that part to a dict on each access.
+        )pbdoc")
+        .def_property_readonly("reference", &MagneticHandle::reference,
+            "Manufacturer reference of the design, or None.")
+        .def_property_readonly("core_name", &MagneticHandle::core_name,
+            "Name of the core, or None.")
+        .def_property_readonly("core_shape", &MagneticHandle::core_shape,
+            "Name of the core shape.")
+        .def_property_readonly("core_material", &MagneticHandle::core_material,
+            "Name of the core material.")
+        .def_property_readonly("winding_names", &MagneticHandle::winding_names,
+            "Winding names, in coil order.")
+        .def_property_readonly("number_turns", &MagneticHandle::number_turns,
+            "Number of turns per winding, in coil order.")
+        .def_property_readonly("core", &MagneticHandle::core,
+            "The core as JSON.")
+        .def_property_readonly("coil", &MagneticHandle::coil,
+            "The coil as JSON.")
+        .def("to_dict", &MagneticHandle::as_json,
+            "The full Magnetic as JSON.")
+        .def("__getitem__", [](const MagneticHandle& self, const std::string& key) -> json {
+            if (key == "core") {
+                return self.core();
+            }
+            if (key == "coil") {
+                return self.coil();
+            }
+            auto magneticJson = self.as_json();
+            if (!magneticJson.contains(key)) {
+                throw py::key_error(key);
+            }
+            return magneticJson[key];
+        })
+        .def("__repr__", [](const MagneticHandle& self) {
+            return "<MagneticHandle " + self.reference().value_or(self.core_name().value_or("")) + ">";
+        });
+
+    py::class_<MasHandle>(m, "MasHandle",
+        R"pbdoc(
+        One adviser result kept as a native Mas.
+
+        Returned by the adviser functions with return_handles=True instead of
+        the {"mas", "scoring", "scoringPerFilter"} dict. Reading scoring, the
+        reference or the names on magnetic converts nothing. inputs, outputs
+        and to_dict() convert on access, so read them once if they are
+        needed more than once.
+
+        Indexing keeps code written for the dict results working:
+        handle["scoring"], handle["scoringPerFilter"] and handle["mas"]
+        (the full conversion).
+
+        Example:
+            >>> result = PyMKF.calculate_advised_magnetics(inputs, 50, "standard cores",
+            ...                                            return_handles=True)
+            >>> best = result["data"][0]
+            >>> best.scoring, best.magnetic.core_shape, best.magnetic.number_turns
+            >>> mas = best.to_dict()
+        )pbdoc")
+        .def_property_readonly("scoring", &MasHandle::scoring,
+            "Adviser score; for the fast adviser, total losses in W.")
+        .def_property_readonly("scoring_per_filter", [](const MasHandle& self) -> py::object {
+            if (self.scoring_per_filter().is_null()) {
+                return py::none();
+            }
+            return py::cast(self.scoring_per_filter());
+        }, "Score per adviser filter, or None for the fast adviser.")
+        .def_property_readonly("reference", &MasHandle::reference,
+            "Manufacturer reference of the design, or None.")
+        .def_property_readonly("magnetic", &MasHandle::magnetic,
+            "The magnetic, as a MagneticHandle.")
+        .def_property_readonly("inputs", &MasHandle::inputs,
+            "The inputs as JSON.")
+        .def_property_readonly("outputs", &MasHandle::outputs,
+            "The outputs as a list of JSON objects.")
+        .def("to_dict", &MasHandle::as_json,
+            "The full Mas as JSON, as the \"mas\" entry of the dict results.")
+        .def("to_result_dict", &MasHandle::as_result_json,
+            "The {\"mas\", \"scoring\", \"scoringPerFilter\"} dict the JSON mode returns.")
+        .def("__getitem__", [](const MasHandle& self, const std::string& key) -> json {
+            if (key == "scoring") {
+                return self.scoring();
+            }
+            if (key == "scoringPerFilter" && !self.scoring_per_filter().is_null()) {
+                return self.scoring_per_filter();
+            }
+            if (key == "mas") {
+                return self.as_json();
+            }
+            throw py::key_error(key);
+        })
+        .def("__contains__", [](const MasHandle& self, const std::string& key) {
+            return key == "mas" || key == "scoring" || (key == "scoringPerFilter" && !self.scoring_per_filter().is_null());
+        })
+        .def("__repr__", [](const MasHandle& self) {
+            return "<MasHandle " + self.reference().value_or("") + " scoring=" + std::to_string(self.scoring()) + ">";
+        });
+}
+
+} // namespace PyMKF
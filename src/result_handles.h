@@ -0,0 +1,69 @@
+#pragma once
+
+#include "common.h"
+
+#include <memory>
+
+namespace PyMKF {
+
+// ─── Typed adviser results ──────────────────────────────────────────────────
+// The adviser bindings serialise every Mas they return to JSON and then to
+// nested Python dicts, which for dozens of full designs costs more than many
+// callers' whole use of the result: the scoring and a couple of names. With
+// return_handles=True they return these handles instead. A handle keeps the
+// native Mas and converts only what is read: scalar properties come straight
+// from the C++ object, sub-objects are converted when accessed, and
+// to_dict() gives the full Mas as the JSON mode would have.
+//
+// Handles are immutable snapshots, independent of the databases and of each
+// other, so they stay valid after the databases are cleared or reloaded.
+class MagneticHandle {
+  public:
+    // `owner` keeps `magnetic` alive: it is the Mas the magnetic belongs to.
+    MagneticHandle(std::shared_ptr<void> owner, OpenMagnetics::Magnetic* magnetic)
+        : _owner(std::move(owner)), _magnetic(magnetic) {}
+
+    std::optional<std::string> reference() const;
+    std::optional<std::string> core_name() const;
+    std::string core_shape() const;
+    std::string core_material() const;
+    std::vector<std::string> winding_names() const;
+    std::vector<int64_t> number_turns() const;
+
+    json core() const;
+    json coil() const;
+    json as_json() const;
+
+  private:
+    std::shared_ptr<void> _owner;
+    OpenMagnetics::Magnetic* _magnetic;
+};
+
+class MasHandle {
+  public:
+    MasHandle(OpenMagnetics::Mas mas, double scoring, json scoringPerFilter = nullptr)
+        : _mas(std::make_shared<OpenMagnetics::Mas>(std::move(mas))),
+          _scoring(scoring),
+          _scoringPerFilter(std::move(scoringPerFilter)) {}
+
+    double scoring() const { return _scoring; }
+    const json& scoring_per_filter() const { return _scoringPerFilter; }
+    std::optional<std::string> reference() const { return magnetic().reference(); }
+    MagneticHandle magnetic() const { return MagneticHandle(_mas, &_mas->get_mutable_magnetic()); }
+
+    json inputs() const;
+    json outputs() const;
+    json as_json() const;
+
+    // The {"mas", "scoring", "scoringPerFilter"} entry the JSON mode returns.
+    json as_result_json() const;
+
+  private:
+    std::shared_ptr<OpenMagnetics::Mas> _mas;
+    double _scoring;
+    json _scoringPerFilter;
+};
+
+void register_result_handle_bindings(py::module& m);
+
+} // namespace PyMKF
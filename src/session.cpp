@@ -0,0 +1,181 @@
+#include "session.h"
+#include "concurrency.h"
+#include "profiling.h"
+#include "simulation.h"
+
+namespace PyMKF {
+
+MagneticSession::MagneticSession(json magneticJson, json modelsData)
+    : _modelsData(std::move(modelsData)) {
+    StateReadLockWithDatabases stateLock;
+    _magnetic = OpenMagnetics::Magnetic(magneticJson);
+    configure_magnetic_simulator(_magneticSimulator, _modelsData);
+}
+
+json MagneticSession::get_magnetic() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    json result;
+    to_json(result, _magnetic);
+    return result;
+}
+
+json MagneticSession::evaluate(json operatingPointJson) {
+    try {
+        StateReadLockWithDatabases stateLock;
+        std::lock_guard<std::mutex> lock(_mutex);
+        OperatingPoint operatingPoint(operatingPointJson);
+        auto losses = evaluate_operating_point_losses(_magneticSimulator, _windingLossesModel, _magnetic, operatingPoint);
+        json result;
+        result["coreLosses"] = losses.coreLosses;
+        result["windingLosses"] = losses.windingLosses;
+        result["totalLosses"] = losses.coreLosses + losses.windingLosses;
+        result["magneticFluxDensityPeak"] = losses.magneticFluxDensityPeak;
+        result["maximumCoreTemperature"] = losses.temperature;
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+json MagneticSession::calculate_core_losses(json operatingPointJson) {
+    try {
+        StateReadLockWithDatabases stateLock;
+        std::lock_guard<std::mutex> lock(_mutex);
+        OperatingPoint operatingPoint(operatingPointJson);
+        PYMKF_PROFILE_SCOPE("CoreLossesModel");
+        auto coreLossesOutput = _magneticSimulator.calculate_core_losses(operatingPoint, _magnetic);
+        json result;
+        to_json(result, coreLossesOutput);
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+json MagneticSession::calculate_winding_losses(json operatingPointJson, std::optional<double> temperature) {
+    try {
+        StateReadLockWithDatabases stateLock;
+        std::lock_guard<std::mutex> lock(_mutex);
+        OperatingPoint operatingPoint(operatingPointJson);
+        PYMKF_PROFILE_SCOPE("WindingLosses");
+        auto windingLossesOutput = _windingLossesModel.calculate_losses(
+            _magnetic, operatingPoint, temperature.value_or(operatingPoint.get_conditions().get_ambient_temperature()));
+        json result;
+        to_json(result, windingLossesOutput);
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+json MagneticSession::simulate(json inputsJson) {
+    try {
+        StateReadLockWithDatabases stateLock;
+        std::lock_guard<std::mutex> lock(_mutex);
+        OpenMagnetics::Inputs inputs(inputsJson);
+        auto mas = _magneticSimulator.simulate(inputs, _magnetic);
+        json result;
+        to_json(result, mas);
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+void register_session_bindings(py::module& m) {
+    py::class_<MagneticSession>(m, "MagneticSession",
+        R"pbdoc(
+        A magnetic built once and evaluated against many operating points.
+
+        The magnetic and the simulation models are parsed and set up when the
+        session is created; each call then only computes the terms that
+        depend on the excitation. Use it instead of simulate() or the loss
+        functions when the design is fixed and only the operating point
+        changes.
+
+        Example:
+            >>> session = PyMKF.MagneticSession(magnetic, {"coreLosses": "IGSE"})
+            >>> for operating_point in operating_points:
+            ...     losses = session.evaluate(operating_point)
+            ...     print(losses["totalLosses"])
+        )pbdoc")
+        .def(py::init<json, json>(),
+            R"pbdoc(
+            Build the session.
+
+            Args:
+                magnetic_json: JSON object with the magnetic specification.
+                models_json: Optional {"coreLosses": ..., "reluctance": ...}.
+            )pbdoc",
+            py::arg("magnetic_json"), py::arg("models_json") = nullptr,
+            py::call_guard<py::gil_scoped_release>())
+        .def_property_readonly("magnetic", &MagneticSession::get_magnetic,
+            "The magnetic as built by the session, as JSON.")
+        .def_property_readonly("models", &MagneticSession::get_models,
+            "The models JSON the session was created with.")
+        .def("evaluate", &MagneticSession::evaluate,
+            R"pbdoc(
+            Core and winding losses of the session magnetic at one operating point.
+
+            Args:
+                operating_point_json: JSON OperatingPoint with excitations.
+
+            Returns:
+                JSON object with "coreLosses", "windingLosses", "totalLosses",
+                "magneticFluxDensityPeak" and "maximumCoreTemperature".
+            )pbdoc",
+            py::arg("operating_point_json"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("calculate_core_losses", &MagneticSession::calculate_core_losses,
+            R"pbdoc(
+            Full CoreLossesOutput of the session magnetic at one operating point.
+
+            Args:
+                operating_point_json: JSON OperatingPoint with excitations.
+
+            Returns:
+                JSON CoreLossesOutput.
+            )pbdoc",
+            py::arg("operating_point_json"),
+            py::call_guard<py::gil_scoped_release>())
+        .def("calculate_winding_losses", &MagneticSession::calculate_winding_losses,
+            R"pbdoc(
+            Full WindingLossesOutput of the session magnetic at one operating point.
+
+            Args:
+                operating_point_json: JSON OperatingPoint with excitations.
+                temperature: Winding temperature in °C; defaults to the
+                    operating point's ambient temperature.
+
+            Returns:
+                JSON WindingLossesOutput.
+            )pbdoc",
+            py::arg("operating_point_json"), py::arg("temperature") = py::none(),
+            py::call_guard<py::gil_scoped_release>())
+        .def("simulate", &MagneticSession::simulate,
+            R"pbdoc(
+            Same as simulate(inputs, magnetic, models) for the session magnetic.
+
+            Args:
+                inputs_json: JSON Inputs with design requirements and operating points.
+
+            Returns:
+                JSON Mas object.
+            )pbdoc",
+            py::arg("inputs_json"),
+            py::call_guard<py::gil_scoped_release>());
+}
+
+} // namespace PyMKF
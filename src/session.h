@@ -0,0 +1,42 @@
+#pragma once
+
+#include "common.h"
+
+#include <mutex>
+
+namespace PyMKF {
+
+// ─── Stateful per-magnetic evaluation ───────────────────────────────────────
+// simulate() and the loss bindings rebuild the Magnetic (coil description,
+// wire lookups, processed core) and the models from JSON on every call. A
+// MagneticSession does that once and then only runs the excitation-dependent
+// part — core losses, winding skin/proximity losses, core temperature — for
+// each operating point it is given, which is what control-loop tuning and
+// Monte-Carlo studies call hundreds of times against a fixed design.
+//
+// The session holds a private copy of the magnetic and its simulator; calls
+// on one session are serialised by its own mutex, calls on different
+// sessions run in parallel under the shared state lock.
+class MagneticSession {
+  public:
+    explicit MagneticSession(json magneticJson, json modelsData = nullptr);
+
+    json get_magnetic() const;
+    json get_models() const { return _modelsData; }
+
+    json evaluate(json operatingPointJson);
+    json calculate_core_losses(json operatingPointJson);
+    json calculate_winding_losses(json operatingPointJson, std::optional<double> temperature);
+    json simulate(json inputsJson);
+
+  private:
+    mutable std::mutex _mutex;
+    json _modelsData;
+    OpenMagnetics::Magnetic _magnetic;
+    OpenMagnetics::MagneticSimulator _magneticSimulator;
+    OpenMagnetics::WindingLosses _windingLossesModel;
+};
+
+void register_session_bindings(py::module& m);
+
+} // namespace PyMKF
@@ -1,4 +1,5 @@
 #include "settings.h"
+#include "concurrency.h"
 
 namespace PyMKF {
 
@@ -66,6 +67,7 @@ py::dict get_defaults() {
 json get_settings() {
     json settingsJson;
     try {
+        StateReadLock stateLock;
         // General
         settingsJson["verbose"] = OpenMagnetics::settings.get_verbose();
         settingsJson["useToroidalCores"] = OpenMagnetics::settings.get_use_toroidal_cores();
@@ -259,6 +261,7 @@ json get_settings() {
 
 void set_settings(json settingsJson) {
     try {
+        StateWriteLock stateLock;
         // General
         if (settingsJson.contains("verbose")) OpenMagnetics::settings.set_verbose(settingsJson["verbose"]);
         if (settingsJson.contains("useToroidalCores")) OpenMagnetics::settings.set_use_toroidal_cores(settingsJson["useToroidalCores"]);
@@ -448,6 +451,7 @@ void set_settings(json settingsJson) {
 }
 
 void reset_settings() {
+    StateWriteLock stateLock;
     OpenMagnetics::settings.reset();
 }
 
@@ -560,7 +564,8 @@ void register_settings_bindings(py::module& m) {
         
         Returns:
             JSON object with all current settings.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("set_settings", &set_settings,
         R"pbdoc(
@@ -578,7 +583,8 @@ void register_settings_bindings(py::module& m) {
             - coilAllowInsulatedWire: Allow insulated wire
             - useOnlyCoresInStock: Limit to in-stock cores
             - painterNumberPointsX/Y: Field plot resolution
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("reset_settings", &reset_settings,
         R"pbdoc(
@@ -586,7 +592,8 @@ void register_settings_bindings(py::module& m) {
         
         Restores all library settings to their initial defaults.
         Useful for ensuring consistent behavior between tests.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("get_default_models", &get_default_models,
         R"pbdoc(
@@ -1,28 +1,87 @@
 #include "simulation.h"
+#include "concurrency.h"
+#include "profiling.h"
+#include "result_cache.h"
+#include "thread_pool.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace PyMKF {
 
-json simulate(json inputsJson, json magneticJson, json modelsData) {
+JsonResultCache& simulation_cache() {
+    static JsonResultCache cache;
+    return cache;
+}
+
+// Per-operating-point outputs simulate(..., outputs) can compute on their own.
+static const std::vector<std::string> simulationOutputNames = {
+    "coreLosses",
+    "windingLosses",
+    "magnetizingInductance",
+};
+
+static OpenMagnetics::ReluctanceModels reluctance_model_from(const json& modelsData) {
+    auto reluctanceModelName = OpenMagnetics::defaults.reluctanceModelDefault;
+    if (!modelsData.is_null() && modelsData.find("reluctance") != modelsData.end()) {
+        OpenMagnetics::from_json(modelsData["reluctance"], reluctanceModelName);
+    }
+    return reluctanceModelName;
+}
+
+json simulate(json inputsJson, json magneticJson, json modelsData, json outputsJson) {
+    PYMKF_PROFILE_SCOPE("MagneticSimulator::simulate");
     try {
+        StateReadLockWithDatabases stateLock;
+        auto wants = parse_output_selection(outputsJson, simulationOutputNames);
+        std::string cacheKey;
+        if (simulation_cache().enabled()) {
+            cacheKey = canonical_cache_key("simulate", json::array({inputsJson, magneticJson, modelsData, outputsJson}));
+            if (auto cached = simulation_cache().get(cacheKey)) {
+                return *cached;
+            }
+        }
+
         OpenMagnetics::Inputs inputs(inputsJson);
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        
-        auto reluctanceModelName = OpenMagnetics::defaults.reluctanceModelDefault;
-        if (!modelsData.is_null() && modelsData.find("reluctance") != modelsData.end()) {
-            OpenMagnetics::from_json(modelsData["reluctance"], reluctanceModelName);
-        }
-        auto coreLossesModelName = OpenMagnetics::defaults.coreLossesModelDefault;
-        if (!modelsData.is_null() && modelsData.find("coreLosses") != modelsData.end()) {
-            OpenMagnetics::from_json(modelsData["coreLosses"], coreLossesModelName);
-        }
 
         OpenMagnetics::MagneticSimulator magneticSimulator;
-        magneticSimulator.set_core_losses_model_name(coreLossesModelName);
-        magneticSimulator.set_reluctance_model_name(reluctanceModelName);
-        auto mas = magneticSimulator.simulate(inputs, magnetic);
+        configure_magnetic_simulator(magneticSimulator, modelsData);
 
         json result;
-        to_json(result, mas);
+        if (outputsJson.is_null()) {
+            auto mas = magneticSimulator.simulate(inputs, magnetic);
+            to_json(result, mas);
+        }
+        else {
+            // Only the selected models run; the Mas carries just those fields
+            // in each entry of "outputs".
+            to_json(result["inputs"], inputs);
+            to_json(result["magnetic"], magnetic);
+            result["outputs"] = json::array();
+            OpenMagnetics::WindingLosses windingLossesModel;
+            OpenMagnetics::MagnetizingInductance magnetizingInductanceModel(reluctance_model_from(modelsData));
+            for (auto& operatingPoint : inputs.get_mutable_operating_points()) {
+                json outputs = json::object();
+                if (wants("coreLosses")) {
+                    PYMKF_PROFILE_SCOPE("CoreLossesModel");
+                    to_json(outputs["coreLosses"], magneticSimulator.calculate_core_losses(operatingPoint, magnetic));
+                }
+                if (wants("windingLosses")) {
+                    PYMKF_PROFILE_SCOPE("WindingLosses");
+                    to_json(outputs["windingLosses"], windingLossesModel.calculate_losses(magnetic, operatingPoint, operatingPoint.get_conditions().get_ambient_temperature()));
+                }
+                if (wants("magnetizingInductance")) {
+                    to_json(outputs["magnetizingInductance"], magnetizingInductanceModel.calculate_inductance_from_number_turns_and_gapping(magnetic.get_core(), magnetic.get_coil(), &operatingPoint));
+                }
+                result["outputs"].push_back(std::move(outputs));
+            }
+        }
+        if (!cacheKey.empty()) {
+            simulation_cache().put(cacheKey, result);
+        }
         return result;
     }
     catch (const std::exception &exc) {
@@ -32,6 +91,54 @@ json simulate(json inputsJson, json magneticJson, json modelsData) {
     }
 }
 
+void configure_magnetic_simulator(OpenMagnetics::MagneticSimulator& magneticSimulator, const json& modelsData) {
+    auto reluctanceModelName = reluctance_model_from(modelsData);
+    auto coreLossesModelName = OpenMagnetics::defaults.coreLossesModelDefault;
+    if (!modelsData.is_null() && modelsData.find("coreLosses") != modelsData.end()) {
+        OpenMagnetics::from_json(modelsData["coreLosses"], coreLossesModelName);
+    }
+    magneticSimulator.set_core_losses_model_name(coreLossesModelName);
+    magneticSimulator.set_reluctance_model_name(reluctanceModelName);
+}
+
+OperatingPointLosses evaluate_operating_point_losses(OpenMagnetics::MagneticSimulator& magneticSimulator,
+                                                     OpenMagnetics::WindingLosses& windingLossesModel,
+                                                     OpenMagnetics::Magnetic& magnetic,
+                                                     OperatingPoint& operatingPoint) {
+    PYMKF_PROFILE_COUNT("operatingPointsEvaluated", 1);
+    OperatingPointLosses losses;
+    double ambientTemperature = operatingPoint.get_conditions().get_ambient_temperature();
+    {
+        PYMKF_PROFILE_SCOPE("CoreLossesModel");
+        auto coreLossesOutput = magneticSimulator.calculate_core_losses(operatingPoint, magnetic);
+        losses.coreLosses = coreLossesOutput.get_core_losses();
+        losses.temperature = coreLossesOutput.get_temperature();
+        if (auto fluxDensity = coreLossesOutput.get_magnetic_flux_density()) {
+            if (fluxDensity->get_processed() && fluxDensity->get_processed()->get_peak()) {
+                losses.magneticFluxDensityPeak = fluxDensity->get_processed()->get_peak().value();
+            }
+        }
+    }
+    {
+        PYMKF_PROFILE_SCOPE("WindingLosses");
+        losses.windingLosses = windingLossesModel.calculate_losses(magnetic, operatingPoint, ambientTemperature).get_winding_losses();
+    }
+    return losses;
+}
+
+void configure_simulation_cache(size_t maxEntries, size_t maxBytes) {
+    simulation_cache().configure(maxEntries, maxBytes);
+}
+
+json get_simulation_cache_stats() {
+    return simulation_cache().stats();
+}
+
+std::string clear_simulation_cache() {
+    simulation_cache().clear();
+    return std::to_string(0);
+}
+
 std::string export_magnetic_as_subcircuit(json magneticJson) {
     // Returns the raw SPICE subcircuit netlist as a plain string. We must NOT
     // return nlohmann::ordered_json here: pybind11_json registers a caster for
@@ -45,6 +152,7 @@ std::string export_magnetic_as_subcircuit(json magneticJson) {
     // component JSON): consumers of this binding need a real ".subckt ... .ends"
     // SPICE subcircuit (e.g. the MAS MKF_MODEL path stamps it into
     // magnetic.modelOutputs.spiceSubcircuit).
+    StateReadLockWithDatabases stateLock;
     OpenMagnetics::Magnetic magnetic(magneticJson);
     return OpenMagnetics::CircuitSimulatorExporter(OpenMagnetics::CircuitSimulatorExporterModels::NGSPICE)
         .export_magnetic_as_subcircuit(magnetic);
@@ -52,6 +160,7 @@ std::string export_magnetic_as_subcircuit(json magneticJson) {
 
 json mas_autocomplete(json masJson, json configuration) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Mas mas(masJson);
         auto completedMas = OpenMagnetics::mas_autocomplete(mas, configuration);
         json result;
@@ -67,6 +176,7 @@ json mas_autocomplete(json masJson, json configuration) {
 
 json magnetic_autocomplete(json magneticJson, json configuration) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         auto completedMagnetic = OpenMagnetics::magnetic_autocomplete(magnetic, configuration);
         json result;
@@ -80,52 +190,64 @@ json magnetic_autocomplete(json magneticJson, json configuration) {
     }
 }
 
-json process_inputs(json inputsJson) {
+// Fills in the processed data, harmonics and waveform a signal is missing.
+// With an energy threshold the harmonics are the adaptive set instead, and
+// the truncation is returned for the report.
+static json process_signal(SignalDescriptor& signal, double frequency, std::optional<double> harmonicEnergyThreshold) {
+    if (!signal.get_processed() && signal.get_waveform()) {
+        auto processed = OpenMagnetics::Inputs::calculate_basic_processed_data(signal.get_waveform().value());
+        signal.set_processed(processed);
+    }
+    json report = nullptr;
+    if (harmonicEnergyThreshold && signal.get_waveform()) {
+        auto truncation = adaptive_harmonics(signal.get_waveform().value(), frequency, harmonicEnergyThreshold.value());
+        signal.set_harmonics(truncation.harmonics);
+        report = harmonic_truncation_report(truncation);
+    }
+    else if (harmonicEnergyThreshold && signal.get_harmonics()) {
+        auto truncation = truncate_harmonics(signal.get_harmonics().value(), harmonicEnergyThreshold.value());
+        signal.set_harmonics(truncation.harmonics);
+        report = harmonic_truncation_report(truncation);
+    }
+    else if (!signal.get_harmonics() && signal.get_waveform()) {
+        auto harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(signal.get_waveform().value(), frequency);
+        signal.set_harmonics(harmonics);
+    }
+    if (!signal.get_waveform() && signal.get_processed()) {
+        auto waveform = OpenMagnetics::Inputs::create_waveform(signal.get_processed().value(), frequency);
+        signal.set_waveform(waveform);
+    }
+    return report;
+}
+
+json process_inputs(json inputsJson, std::optional<double> harmonicEnergyThreshold) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Inputs inputs(inputsJson);
-        auto operatingPoints = inputs.get_mutable_operating_points();
-        for (size_t operatingPointIndex = 0; operatingPointIndex < operatingPoints.size(); ++operatingPointIndex) {
-            auto excitationsPerWinding = operatingPoints[operatingPointIndex].get_excitations_per_winding();
-            for (size_t excitationIndex = 0; excitationIndex < excitationsPerWinding.size(); ++excitationIndex) {
-                auto excitation = operatingPoints[operatingPointIndex].get_mutable_excitations_per_winding()[excitationIndex];
+        json truncationReport = json::array();
+        for (auto& operatingPoint : inputs.get_mutable_operating_points()) {
+            json operatingPointReport = json::array();
+            for (auto& excitation : operatingPoint.get_mutable_excitations_per_winding()) {
+                json excitationReport = json::object();
                 if (excitation.get_current()) {
                     auto current = excitation.get_current().value();
-                    if (!current.get_processed() && current.get_waveform()) {
-                        auto processed = OpenMagnetics::Inputs::calculate_basic_processed_data(current.get_waveform().value());
-                        current.set_processed(processed);
-                    }
-                    if (!current.get_harmonics() && current.get_waveform()) {
-                        auto harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(current.get_waveform().value(), excitation.get_frequency());
-                        current.set_harmonics(harmonics);
-                    }
-                    if (!current.get_waveform() && current.get_processed()) {
-                        auto waveform = OpenMagnetics::Inputs::create_waveform(current.get_processed().value(), excitation.get_frequency());
-                        current.set_waveform(waveform);
-                    }
+                    excitationReport["current"] = process_signal(current, excitation.get_frequency(), harmonicEnergyThreshold);
                     excitation.set_current(current);
                 }
                 if (excitation.get_voltage()) {
                     auto voltage = excitation.get_voltage().value();
-                    if (!voltage.get_processed() && voltage.get_waveform()) {
-                        auto processed = OpenMagnetics::Inputs::calculate_basic_processed_data(voltage.get_waveform().value());
-                        voltage.set_processed(processed);
-                    }
-                    if (!voltage.get_harmonics() && voltage.get_waveform()) {
-                        auto harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(voltage.get_waveform().value(), excitation.get_frequency());
-                        voltage.set_harmonics(harmonics);
-                    }
-                    if (!voltage.get_waveform() && voltage.get_processed()) {
-                        auto waveform = OpenMagnetics::Inputs::create_waveform(voltage.get_processed().value(), excitation.get_frequency());
-                        voltage.set_waveform(waveform);
-                    }
+                    excitationReport["voltage"] = process_signal(voltage, excitation.get_frequency(), harmonicEnergyThreshold);
                     excitation.set_voltage(voltage);
                 }
-                operatingPoints[operatingPointIndex].get_mutable_excitations_per_winding()[excitationIndex] = excitation;
+                operatingPointReport.push_back(std::move(excitationReport));
             }
-            inputs.get_mutable_operating_points()[operatingPointIndex] = operatingPoints[operatingPointIndex];
+            truncationReport.push_back(std::move(operatingPointReport));
         }
         json result;
         to_json(result, inputs);
+        if (harmonicEnergyThreshold) {
+            result["harmonicTruncation"] = std::move(truncationReport);
+        }
         return result;
     }
     catch (const std::exception &exc) {
@@ -137,6 +259,7 @@ json process_inputs(json inputsJson) {
 
 json extract_operating_point(json fileJson, size_t numberWindings, double frequency, double desiredMagnetizingInductance, json mapColumnNamesJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         std::vector<std::map<std::string, std::string>> mapColumnNames = mapColumnNamesJson.get<std::vector<std::map<std::string, std::string>>>();
         auto reader = OpenMagnetics::CircuitSimulationReader(fileJson);
         auto operatingPoint = reader.extract_operating_point(numberWindings, frequency, mapColumnNames);
@@ -154,6 +277,7 @@ json extract_operating_point(json fileJson, size_t numberWindings, double freque
 
 json extract_map_column_names(json fileJson, size_t numberWindings, double frequency) {
     try {
+        StateReadLockWithDatabases stateLock;
         auto reader = OpenMagnetics::CircuitSimulationReader(fileJson);
         auto columnNames = reader.extract_map_column_names(numberWindings, frequency);
         json result = json::array();
@@ -175,6 +299,7 @@ json extract_map_column_names(json fileJson, size_t numberWindings, double frequ
 
 json extract_column_names(json fileJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         auto reader = OpenMagnetics::CircuitSimulationReader(fileJson);
         auto columnNames = reader.extract_column_names();
         json result = json::array();
@@ -192,6 +317,7 @@ json extract_column_names(json fileJson) {
 
 json calculate_inductance_matrix(json magneticJson, double frequency, json modelsData) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         
         auto reluctanceModelName = OpenMagnetics::defaults.reluctanceModelDefault;
@@ -215,6 +341,7 @@ json calculate_inductance_matrix(json magneticJson, double frequency, json model
 
 json calculate_leakage_inductance(json magneticJson, double frequency, size_t sourceIndex) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
 
         auto leakageInductanceOutput = OpenMagnetics::LeakageInductance().calculate_leakage_inductance_all_windings(magnetic, frequency, sourceIndex);
@@ -232,6 +359,7 @@ json calculate_leakage_inductance(json magneticJson, double frequency, size_t so
 
 json calculate_dc_resistance_per_winding(json coilJson, double temperature) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         
         auto resistances = OpenMagnetics::WindingOhmicLosses::calculate_dc_resistance_per_winding(coil, temperature);
@@ -248,6 +376,7 @@ json calculate_dc_resistance_per_winding(json coilJson, double temperature) {
 
 json calculate_resistance_matrix(json magneticJson, double temperature, double frequency) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         
         OpenMagnetics::WindingLosses windingLosses;
@@ -266,6 +395,7 @@ json calculate_resistance_matrix(json magneticJson, double temperature, double f
 
 json calculate_stray_capacitance(json coilJson, json operatingPointJson, json modelsData) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         OperatingPoint operatingPoint(operatingPointJson);
         
@@ -290,6 +420,7 @@ json calculate_stray_capacitance(json coilJson, json operatingPointJson, json mo
 
 json calculate_maxwell_capacitance_matrix(json coilJson, json capacitanceAmongWindingsJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
         auto capacitanceAmongWindings = capacitanceAmongWindingsJson.get<std::map<std::string, std::map<std::string, double>>>();
 
@@ -310,14 +441,89 @@ json calculate_maxwell_capacitance_matrix(json coilJson, json capacitanceAmongWi
     }
 }
 
-json sweep_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title) {
-    try {
-        OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_impedance_over_frequency(magnetic, start, stop, numberElements, mode, title);
+// Smallest slice of a sweep grid worth a worker of its own.
+constexpr size_t minimumSweepPointsPerChunk = 16;
+
+// The spacing modes OpenMagnetics::Sweeper understands, by their exact names.
+// Anything else is rejected before any worker starts, so a typo fails the
+// same way with or without threads instead of being split as a log grid.
+static void check_sweep_mode(const std::string& mode, double start, double stop) {
+    if (mode == "linear") {
+        return;
+    }
+    if (mode != "log") {
+        throw std::invalid_argument("Unknown sweep mode: " + mode + " (expected linear or log)");
+    }
+    if (!(start > 0) || !(stop > 0)) {
+        throw std::invalid_argument("A log sweep needs positive start and stop");
+    }
+}
+
+// Position `index` of an OpenMagnetics::Sweeper grid in a mode that
+// check_sweep_mode() accepted: "linear" is evenly spaced, "log"
+// logarithmically.
+static double sweep_grid_point(double start, double stop, size_t numberElements, const std::string& mode, size_t index) {
+    if (numberElements < 2) {
+        return start;
+    }
+    double fraction = static_cast<double>(index) / static_cast<double>(numberElements - 1);
+    if (mode == "linear") {
+        return start + (stop - start) * fraction;
+    }
+    return std::exp(std::log(start) + (std::log(stop) - std::log(start)) * fraction);
+}
+
+// Runs a Sweeper call as one contiguous chunk of the grid per worker, each
+// on its own copy of the already-built magnetic, and concatenates the
+// resulting curves in order. A contiguous slice of a linear or log grid is a
+// grid of the same kind, so each chunk asks the Sweeper for exactly its
+// slice of the points. threads == 1 (the default) is the plain serial call.
+template <typename Sweep>
+static json chunked_sweep(const OpenMagnetics::Magnetic& magnetic, double start, double stop, size_t numberElements,
+                          const std::string& mode, int threads, Sweep sweep) {
+    check_sweep_mode(mode, start, stop);
+    size_t numberChunks = threads == 1 ? 1 : resolve_thread_count(threads, numberElements / minimumSweepPointsPerChunk);
+    if (numberChunks <= 1) {
+        auto chunkMagnetic = magnetic;
         json resultJson;
-        to_json(resultJson, result);
+        to_json(resultJson, sweep(chunkMagnetic, start, stop, numberElements));
         return resultJson;
     }
+
+    std::vector<json> chunks(numberChunks);
+    parallel_for(numberChunks, numberChunks, [&](size_t chunk) {
+        size_t first = chunk * numberElements / numberChunks;
+        size_t last = (chunk + 1) * numberElements / numberChunks;
+        auto chunkMagnetic = magnetic;
+        auto curve = sweep(chunkMagnetic,
+                           sweep_grid_point(start, stop, numberElements, mode, first),
+                           sweep_grid_point(start, stop, numberElements, mode, last - 1),
+                           last - first);
+        to_json(chunks[chunk], curve);
+    });
+
+    json resultJson = std::move(chunks[0]);
+    for (size_t chunk = 1; chunk < numberChunks; ++chunk) {
+        for (auto& [key, values] : chunks[chunk].items()) {
+            if (values.is_array() && resultJson[key].is_array()) {
+                for (auto& value : values) {
+                    resultJson[key].push_back(std::move(value));
+                }
+            }
+        }
+    }
+    return resultJson;
+}
+
+json sweep_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads) {
+    try {
+        StateReadLockWithDatabases stateLock;
+        OpenMagnetics::Magnetic magnetic(magneticJson);
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_impedance_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, mode, title);
+            });
+    }
     catch (const std::exception &exc) {
         json exception;
         exception["data"] = "Exception: " + std::string{exc.what()};
@@ -325,13 +531,14 @@ json sweep_impedance_over_frequency(json magneticJson, double start, double stop
     }
 }
 
-json sweep_differential_mode_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title) {
+json sweep_differential_mode_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_differential_mode_impedance_over_frequency(magnetic, start, stop, numberElements, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_differential_mode_impedance_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -340,13 +547,14 @@ json sweep_differential_mode_impedance_over_frequency(json magneticJson, double
     }
 }
 
-json sweep_q_factor_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title) {
+json sweep_q_factor_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_q_factor_over_frequency(magnetic, start, stop, numberElements, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_q_factor_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -355,13 +563,14 @@ json sweep_q_factor_over_frequency(json magneticJson, double start, double stop,
     }
 }
 
-json sweep_winding_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, size_t windingIndex, double temperature, std::string mode, std::string title) {
+json sweep_winding_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, size_t windingIndex, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_winding_resistance_over_frequency(magnetic, start, stop, numberElements, windingIndex, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_winding_resistance_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, windingIndex, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -370,13 +579,14 @@ json sweep_winding_resistance_over_frequency(json magneticJson, double start, do
     }
 }
 
-json sweep_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title) {
+json sweep_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_resistance_over_frequency(magnetic, start, stop, numberElements, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_resistance_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -385,13 +595,14 @@ json sweep_resistance_over_frequency(json magneticJson, double start, double sto
     }
 }
 
-json sweep_magnetizing_inductance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title) {
+json sweep_magnetizing_inductance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_frequency(magnetic, start, stop, numberElements, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_frequency(chunkMagnetic, chunkStart, chunkStop, chunkElements, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -400,13 +611,14 @@ json sweep_magnetizing_inductance_over_frequency(json magneticJson, double start
     }
 }
 
-json sweep_magnetizing_inductance_over_temperature(json magneticJson, double start, double stop, size_t numberElements, double frequency, std::string mode, std::string title) {
+json sweep_magnetizing_inductance_over_temperature(json magneticJson, double start, double stop, size_t numberElements, double frequency, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_temperature(magnetic, start, stop, numberElements, frequency, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_temperature(chunkMagnetic, chunkStart, chunkStop, chunkElements, frequency, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -415,13 +627,14 @@ json sweep_magnetizing_inductance_over_temperature(json magneticJson, double sta
     }
 }
 
-json sweep_magnetizing_inductance_over_dc_bias(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title) {
+json sweep_magnetizing_inductance_over_dc_bias(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
-        auto result = OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_dc_bias(magnetic, start, stop, numberElements, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                return OpenMagnetics::Sweeper::sweep_magnetizing_inductance_over_dc_bias(chunkMagnetic, chunkStart, chunkStop, chunkElements, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -430,14 +643,16 @@ json sweep_magnetizing_inductance_over_dc_bias(json magneticJson, double start,
     }
 }
 
-json sweep_core_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title) {
+json sweep_core_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
-        auto result = OpenMagnetics::Sweeper::sweep_core_losses_over_frequency(magnetic, operatingPoint, start, stop, numberElements, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                auto chunkOperatingPoint = operatingPoint;
+                return OpenMagnetics::Sweeper::sweep_core_losses_over_frequency(chunkMagnetic, chunkOperatingPoint, chunkStart, chunkStop, chunkElements, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -446,14 +661,16 @@ json sweep_core_losses_over_frequency(json magneticJson, json operatingPointJson
     }
 }
 
-json sweep_winding_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title) {
+json sweep_winding_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OperatingPoint operatingPoint(operatingPointJson);
-        auto result = OpenMagnetics::Sweeper::sweep_winding_losses_over_frequency(magnetic, operatingPoint, start, stop, numberElements, temperature, mode, title);
-        json resultJson;
-        to_json(resultJson, result);
-        return resultJson;
+        return chunked_sweep(magnetic, start, stop, numberElements, mode, threads,
+            [&](OpenMagnetics::Magnetic& chunkMagnetic, double chunkStart, double chunkStop, size_t chunkElements) {
+                auto chunkOperatingPoint = operatingPoint;
+                return OpenMagnetics::Sweeper::sweep_winding_losses_over_frequency(chunkMagnetic, chunkOperatingPoint, chunkStart, chunkStop, chunkElements, temperature, mode, title);
+            });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -462,8 +679,219 @@ json sweep_winding_losses_over_frequency(json magneticJson, json operatingPointJ
     }
 }
 
+// Axes understood by sweep_grid, in the order they are applied to a point:
+// the duty cycle regenerates waveforms from their processed description, so
+// it must run before the DC bias shifts them and the frequency rescales them.
+enum class GridAxis { DUTY_CYCLE, DC_BIAS, FREQUENCY, TEMPERATURE };
+
+static GridAxis parse_grid_axis(const std::string& name) {
+    if (name == "dutyCycle") return GridAxis::DUTY_CYCLE;
+    if (name == "dcBias") return GridAxis::DC_BIAS;
+    if (name == "frequency") return GridAxis::FREQUENCY;
+    if (name == "temperature") return GridAxis::TEMPERATURE;
+    throw std::invalid_argument("Unknown sweep_grid axis: " + name + " (expected temperature, frequency, dcBias or dutyCycle)");
+}
+
+// Recomputes harmonics and processed data after the waveform was edited.
+static void refresh_signal(SignalDescriptor& signal, double frequency) {
+    auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(signal.get_waveform().value(), frequency);
+    signal.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency));
+    signal.set_processed(OpenMagnetics::Inputs::calculate_processed_data(signal, sampledWaveform, true));
+}
+
+static void set_signal_duty_cycle(std::optional<SignalDescriptor>& signal, double frequency, double dutyCycle) {
+    if (!signal) {
+        return;
+    }
+    auto processed = signal->get_processed().value();
+    processed.set_duty_cycle(dutyCycle);
+    signal->set_waveform(OpenMagnetics::Inputs::create_waveform(processed, frequency));
+    refresh_signal(signal.value(), frequency);
+}
+
+// Applies one grid point to a copy of the template operating point. The DC
+// bias is the offset of the first winding's current, i.e. the magnetizing
+// winding of an inductor.
+static void apply_grid_point(OperatingPoint& operatingPoint, const std::vector<std::pair<GridAxis, double>>& values) {
+    auto& excitations = operatingPoint.get_mutable_excitations_per_winding();
+    for (auto [axis, value] : values) {
+        switch (axis) {
+            case GridAxis::DUTY_CYCLE:
+                for (auto& excitation : excitations) {
+                    auto current = excitation.get_current();
+                    auto voltage = excitation.get_voltage();
+                    set_signal_duty_cycle(current, excitation.get_frequency(), value);
+                    set_signal_duty_cycle(voltage, excitation.get_frequency(), value);
+                    excitation.set_current(current);
+                    excitation.set_voltage(voltage);
+                }
+                break;
+            case GridAxis::DC_BIAS: {
+                auto current = excitations[0].get_current();
+                auto waveform = current->get_waveform().value();
+                double shift = value - OpenMagnetics::Inputs::calculate_basic_processed_data(waveform).get_offset();
+                auto data = waveform.get_data();
+                for (auto& datum : data) {
+                    datum += shift;
+                }
+                waveform.set_data(data);
+                current->set_waveform(waveform);
+                refresh_signal(current.value(), excitations[0].get_frequency());
+                excitations[0].set_current(current);
+                break;
+            }
+            case GridAxis::FREQUENCY:
+                for (auto& excitation : excitations) {
+                    OpenMagnetics::Inputs::scale_time_to_frequency(excitation, value, false, true);
+                }
+                break;
+            case GridAxis::TEMPERATURE:
+                operatingPoint.get_mutable_conditions().set_ambient_temperature(value);
+                break;
+        }
+    }
+}
+
+py::dict sweep_grid(json magneticJson, json operatingPointJson, py::sequence axes, json modelsData, int threads) {
+    // Axes are read with the GIL held; NumPy arrays and lists both work.
+    struct Axis {
+        std::string name;
+        GridAxis kind;
+        std::vector<double> values;
+    };
+    std::vector<Axis> gridAxes;
+    for (auto item : axes) {
+        auto pair = item.cast<py::sequence>();
+        if (pair.size() != 2) {
+            throw std::invalid_argument("Each sweep_grid axis must be a (name, values) pair");
+        }
+        Axis axis;
+        axis.name = pair[0].cast<std::string>();
+        axis.kind = parse_grid_axis(axis.name);
+        auto values = NumpyArray::ensure(pair[1]);
+        if (!values || values.ndim() != 1 || values.size() == 0) {
+            throw std::invalid_argument("Values of axis " + axis.name + " must be a non-empty 1-D sequence of numbers");
+        }
+        axis.values.assign(values.data(), values.data() + values.size());
+        for (auto& other : gridAxes) {
+            if (other.kind == axis.kind) {
+                throw std::invalid_argument("Axis " + axis.name + " appears twice");
+            }
+        }
+        gridAxes.push_back(std::move(axis));
+    }
+
+    std::vector<size_t> shape;
+    size_t numberPoints = 1;
+    for (auto& axis : gridAxes) {
+        shape.push_back(axis.values.size());
+        numberPoints *= axis.values.size();
+    }
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> coreLosses(numberPoints, nan);
+    std::vector<double> windingLosses(numberPoints, nan);
+    std::vector<double> magneticFluxDensityPeak(numberPoints, nan);
+    std::vector<uint8_t> failed(numberPoints, 0);
+    {
+        py::gil_scoped_release release;
+        StateReadLockWithDatabases stateLock;
+        OpenMagnetics::Magnetic magnetic(magneticJson);
+        OperatingPoint operatingPointTemplate(operatingPointJson);
+
+        // Axis preconditions are checked once on the template so only
+        // physics failures are left to the per-point handler below.
+        std::vector<size_t> applyOrder(gridAxes.size());
+        for (size_t axisIndex = 0; axisIndex < gridAxes.size(); ++axisIndex) {
+            applyOrder[axisIndex] = axisIndex;
+            if (gridAxes[axisIndex].kind == GridAxis::DC_BIAS) {
+                auto& excitations = operatingPointTemplate.get_excitations_per_winding();
+                if (excitations.empty() || !excitations[0].get_current() || !excitations[0].get_current()->get_waveform()) {
+                    throw std::invalid_argument("dcBias axis needs a current waveform on the first winding");
+                }
+            }
+            if (gridAxes[axisIndex].kind == GridAxis::DUTY_CYCLE) {
+                for (auto& excitation : operatingPointTemplate.get_excitations_per_winding()) {
+                    for (auto& signal : {excitation.get_current(), excitation.get_voltage()}) {
+                        if (signal && (!signal->get_processed() || !signal->get_processed()->get_label())) {
+                            throw std::invalid_argument("dutyCycle axis needs a labelled processed description on every signal");
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(applyOrder.begin(), applyOrder.end(), [&](size_t a, size_t b) { return gridAxes[a].kind < gridAxes[b].kind; });
+
+        // Points are grouped into contiguous chunks so each worker builds its
+        // magnetic copy and simulator once and reuses them for every point of
+        // its chunk; a few chunks per thread keep the pool balanced when some
+        // corners of the grid (high bias, low frequency) are slower.
+        size_t numberThreads = resolve_thread_count(threads, numberPoints);
+        size_t numberChunks = std::min(numberPoints, numberThreads * 4);
+        parallel_for(numberChunks, numberThreads, [&](size_t chunk) {
+            size_t first = chunk * numberPoints / numberChunks;
+            size_t last = (chunk + 1) * numberPoints / numberChunks;
+            auto chunkMagnetic = magnetic;
+            OpenMagnetics::MagneticSimulator magneticSimulator;
+            configure_magnetic_simulator(magneticSimulator, modelsData);
+            OpenMagnetics::WindingLosses windingLossesModel;
+
+            std::vector<size_t> valueIndexes(gridAxes.size());
+            std::vector<std::pair<GridAxis, double>> values(gridAxes.size());
+            for (size_t point = first; point < last; ++point) {
+                // Row-major: the last axis varies fastest.
+                size_t remainder = point;
+                for (size_t axisIndex = gridAxes.size(); axisIndex-- > 0;) {
+                    valueIndexes[axisIndex] = remainder % shape[axisIndex];
+                    remainder /= shape[axisIndex];
+                }
+                for (size_t position = 0; position < applyOrder.size(); ++position) {
+                    auto& axis = gridAxes[applyOrder[position]];
+                    values[position] = {axis.kind, axis.values[valueIndexes[applyOrder[position]]]};
+                }
+
+                try {
+                    auto operatingPoint = operatingPointTemplate;
+                    apply_grid_point(operatingPoint, values);
+                    auto losses = evaluate_operating_point_losses(magneticSimulator, windingLossesModel, chunkMagnetic, operatingPoint);
+                    coreLosses[point] = losses.coreLosses;
+                    windingLosses[point] = losses.windingLosses;
+                    magneticFluxDensityPeak[point] = losses.magneticFluxDensityPeak;
+                }
+                catch (const std::exception&) {
+                    failed[point] = 1;
+                }
+            }
+        });
+    }
+
+    std::vector<double> totalLosses(numberPoints);
+    size_t failedPoints = 0;
+    for (size_t point = 0; point < numberPoints; ++point) {
+        totalLosses[point] = coreLosses[point] + windingLosses[point];
+        failedPoints += failed[point];
+    }
+
+    py::dict result;
+    result["coreLosses"] = vector_to_numpy(std::move(coreLosses)).reshape(shape);
+    result["windingLosses"] = vector_to_numpy(std::move(windingLosses)).reshape(shape);
+    result["totalLosses"] = vector_to_numpy(std::move(totalLosses)).reshape(shape);
+    result["magneticFluxDensityPeak"] = vector_to_numpy(std::move(magneticFluxDensityPeak)).reshape(shape);
+    py::list axisNames;
+    py::dict coordinates;
+    for (auto& axis : gridAxes) {
+        axisNames.append(axis.name);
+        coordinates[py::str(axis.name)] = vector_to_numpy(std::move(axis.values));
+    }
+    result["axes"] = axisNames;
+    result["coordinates"] = coordinates;
+    result["failedPoints"] = failedPoints;
+    return result;
+}
+
 json calculate_coupling_coefficient_matrix(json magneticJson, double frequency, json modelsData) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
 
         auto reluctanceModelName = OpenMagnetics::defaults.reluctanceModelDefault;
@@ -510,6 +938,7 @@ json calculate_coupling_coefficient_matrix(json magneticJson, double frequency,
 
 json calculate_leakage_inductance_matrix(json magneticJson, double frequency, json modelsData) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
 
         auto reluctanceModelName = OpenMagnetics::defaults.reluctanceModelDefault;
@@ -533,6 +962,7 @@ json calculate_leakage_inductance_matrix(json magneticJson, double frequency, js
 
 json calculate_capacitance_matrix(json coilJson, json modelsData) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Coil coil(coilJson, false);
 
         auto strayCapacitanceModelName = OpenMagnetics::StrayCapacitanceModels::ALBACH;
@@ -567,6 +997,7 @@ json calculate_capacitance_matrix(json coilJson, json modelsData) {
 
 json calculate_capacitance_models_between_windings(double energy, double voltageDrop, double relativeTurnsRatio) {
     try {
+        StateReadLockWithDatabases stateLock;
         auto result = OpenMagnetics::StrayCapacitance::calculate_capacitance_models_between_windings(energy, voltageDrop, relativeTurnsRatio);
 
         json resultJson;
@@ -593,6 +1024,7 @@ json calculate_capacitance_models_between_windings(double energy, double voltage
 
 json export_magnetic_as_symbol(json magneticJson, json inputsJson) {
     try {
+        StateReadLockWithDatabases stateLock;
         OpenMagnetics::Magnetic magnetic(magneticJson);
         OpenMagnetics::Inputs inputs(inputsJson);
         auto result = OpenMagnetics::CircuitSimulatorExporter().export_magnetic_as_symbol(magnetic);
@@ -619,9 +1051,48 @@ void register_simulation_bindings(py::module& m) {
             magnetic_json: JSON object containing magnetic component specification.
             inputs_json: JSON object containing operating points and conditions.
             models_json: JSON object specifying which models to use for simulation.
+            outputs: Optional subset of "coreLosses", "windingLosses" and
+                "magnetizingInductance". Only those models run, and each
+                entry of "outputs" holds only those fields. None (default)
+                runs the full simulation.
         
         Returns:
             JSON object with simulation results including outputs.
+
+        Example:
+            >>> mas = PyMKF.simulate(inputs, magnetic, models, ["coreLosses"])
+            >>> mas["outputs"][0]["coreLosses"]["coreLosses"]
+        )pbdoc",
+        py::arg("inputs_json"), py::arg("magnetic_json"), py::arg("models_json"),
+        py::arg("outputs") = nullptr,
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("configure_simulation_cache", &configure_simulation_cache,
+        R"pbdoc(
+        Enable, resize or disable the simulate() result cache.
+
+        When enabled, simulate() returns the stored Mas for an (inputs,
+        magnetic, models) triple it has already simulated under the same
+        settings, instead of rebuilding and re-running the simulator. Least
+        recently used results are evicted first. Disabled by default.
+
+        Args:
+            max_entries: Maximum number of cached results; 0 disables the cache.
+            max_bytes: Maximum serialized size of keys plus results; 0 for no limit.
+
+        Example:
+            >>> PyMKF.configure_simulation_cache(256, 64 * 1024 * 1024)
+            >>> PyMKF.get_simulation_cache_stats()["hits"]
+        )pbdoc",
+        py::arg("max_entries"), py::arg("max_bytes") = 0);
+
+    m.def("get_simulation_cache_stats", &get_simulation_cache_stats,
+        R"pbdoc(
+        Get counters of the simulate() result cache.
+
+        Returns:
+            JSON object with "hits", "misses", "evictions", "entries",
+            "bytes", "maxEntries" and "maxBytes".
         )pbdoc");
     
     m.def("export_magnetic_as_subcircuit", &export_magnetic_as_subcircuit,
@@ -636,7 +1107,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             String containing the subcircuit definition.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("mas_autocomplete", &mas_autocomplete,
         R"pbdoc(
@@ -649,7 +1121,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             Complete Mas JSON object with all fields populated.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("magnetic_autocomplete", &magnetic_autocomplete,
         R"pbdoc(
@@ -662,7 +1135,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             Complete Magnetic JSON object with all fields populated.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("process_inputs", &process_inputs,
         R"pbdoc(
@@ -673,10 +1147,22 @@ void register_simulation_bindings(py::module& m) {
         
         Args:
             inputs_json: Raw input JSON object with operating points.
+            harmonic_energy_threshold: Optional fraction of each signal's AC
+                energy that may be dropped (e.g. 1e-4). The harmonics are then
+                recomputed adaptively, as calculate_harmonics(...,
+                energy_threshold=...) does, and only the retained ones are
+                kept, so the loss models iterate fewer of them. None keeps the
+                fixed sampling and every harmonic.
         
         Returns:
             ProcessedWaveform inputs JSON with calculated harmonics and processed data.
-        )pbdoc");
+            With harmonic_energy_threshold, also "harmonicTruncation": per
+            operating point, per excitation, {"current", "voltage"} reports
+            with numberSamples, totalHarmonics, retainedHarmonics and
+            truncationError.
+        )pbdoc",
+        py::arg("inputs_json"), py::arg("harmonic_energy_threshold") = py::none(),
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("extract_operating_point", &extract_operating_point,
         R"pbdoc(
@@ -693,7 +1179,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON object representing the extracted operating point.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("extract_map_column_names", &extract_map_column_names,
         R"pbdoc(
@@ -709,7 +1196,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON array mapping signal types to column names.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("extract_column_names", &extract_column_names,
         R"pbdoc(
@@ -720,7 +1208,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON array of column name strings.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_inductance_matrix", &calculate_inductance_matrix,
         R"pbdoc(
@@ -736,7 +1225,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON object with the inductance matrix at the specified frequency.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_leakage_inductance", &calculate_leakage_inductance,
         R"pbdoc(
@@ -751,7 +1241,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON object with leakage inductance values to each winding.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_dc_resistance_per_winding", &calculate_dc_resistance_per_winding,
         R"pbdoc(
@@ -766,7 +1257,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON array with DC resistance value for each winding in Ohms.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_resistance_matrix", &calculate_resistance_matrix,
         R"pbdoc(
@@ -783,7 +1275,8 @@ void register_simulation_bindings(py::module& m) {
         
         Returns:
             JSON object with resistance matrix (magnitude and frequency).
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_stray_capacitance", &calculate_stray_capacitance,
         R"pbdoc(
@@ -800,7 +1293,8 @@ void register_simulation_bindings(py::module& m) {
         Returns:
             JSON object with capacitance values including capacitance among turns,
             capacitance among windings, and Maxwell capacitance matrix.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
     
     m.def("calculate_maxwell_capacitance_matrix", &calculate_maxwell_capacitance_matrix,
         R"pbdoc(
@@ -816,7 +1310,8 @@ void register_simulation_bindings(py::module& m) {
 
         Returns:
             JSON array containing the Maxwell capacitance matrix.
-        )pbdoc");
+        )pbdoc",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_impedance_over_frequency", &sweep_impedance_over_frequency,
         py::arg("magnetic_json"),
@@ -825,7 +1320,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("number_elements"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep impedance over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep impedance over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_differential_mode_impedance_over_frequency", &sweep_differential_mode_impedance_over_frequency,
         py::arg("magnetic_json"),
@@ -834,7 +1331,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("number_elements"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep differential-mode impedance (leakage + winding R + inter-winding C) over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep differential-mode impedance (leakage + winding R + inter-winding C) over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_q_factor_over_frequency", &sweep_q_factor_over_frequency,
         py::arg("magnetic_json"),
@@ -843,7 +1342,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("number_elements"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep Q factor over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep Q factor over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_winding_resistance_over_frequency", &sweep_winding_resistance_over_frequency,
         py::arg("magnetic_json"),
@@ -854,7 +1355,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep winding resistance over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep winding resistance over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_resistance_over_frequency", &sweep_resistance_over_frequency,
         py::arg("magnetic_json"),
@@ -864,7 +1367,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep total resistance over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep total resistance over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_magnetizing_inductance_over_frequency", &sweep_magnetizing_inductance_over_frequency,
         py::arg("magnetic_json"),
@@ -874,7 +1379,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep magnetizing inductance over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep magnetizing inductance over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_magnetizing_inductance_over_temperature", &sweep_magnetizing_inductance_over_temperature,
         py::arg("magnetic_json"),
@@ -884,7 +1391,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("frequency"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep magnetizing inductance over a temperature range.");
+        py::arg("threads") = 1,
+        "Sweep magnetizing inductance over a temperature range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_magnetizing_inductance_over_dc_bias", &sweep_magnetizing_inductance_over_dc_bias,
         py::arg("magnetic_json"),
@@ -894,7 +1403,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep magnetizing inductance over DC bias current.");
+        py::arg("threads") = 1,
+        "Sweep magnetizing inductance over DC bias current. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_core_losses_over_frequency", &sweep_core_losses_over_frequency,
         py::arg("magnetic_json"),
@@ -905,7 +1416,9 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep core losses over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep core losses over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("sweep_winding_losses_over_frequency", &sweep_winding_losses_over_frequency,
         py::arg("magnetic_json"),
@@ -916,35 +1429,87 @@ void register_simulation_bindings(py::module& m) {
         py::arg("temperature"),
         py::arg("mode"),
         py::arg("title"),
-        "Sweep winding losses over a frequency range.");
+        py::arg("threads") = 1,
+        "Sweep winding losses over a frequency range. threads > 1 (or 0 = all cores) splits the grid across workers.",
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("sweep_grid", &sweep_grid,
+        R"pbdoc(
+        Evaluate core and winding losses over an N-D grid of operating points.
+
+        Every combination of the axis values is applied to a copy of the
+        template operating point and evaluated natively, in parallel. The
+        magnetic is parsed once and each worker reuses its own magnetic copy
+        and MagneticSimulator across its points. Points whose evaluation
+        fails are left as NaN and counted in "failedPoints".
+
+        Axes:
+            temperature: ambient temperature in °C.
+            frequency: switching frequency in Hz; waveforms are rescaled.
+            dcBias: DC offset in A of the first winding's current.
+            dutyCycle: regenerates every waveform from its processed
+                description (which must carry a label) with this duty cycle.
+
+        Args:
+            magnetic_json: JSON object with the magnetic specification.
+            operating_point_json: Template operating point with excitations.
+            axes: Sequence of (name, values) pairs; values may be NumPy arrays.
+                The order of the pairs is the order of the output dimensions.
+            models_json: Optional {"coreLosses": ..., "reluctance": ...}.
+            threads: Worker threads; 0 (default) uses all hardware threads.
+
+        Returns:
+            Dict with "coreLosses", "windingLosses", "totalLosses" and
+            "magneticFluxDensityPeak" as float64 arrays shaped like the axes,
+            plus "axes" (names in order), "coordinates" (name -> values) and
+            "failedPoints".
+
+        Example:
+            >>> grid = PyMKF.sweep_grid(magnetic, operating_point, [
+            ...     ("temperature", [25, 60, 100]),
+            ...     ("frequency", np.geomspace(50e3, 500e3, 10)),
+            ... ])
+            >>> grid["coreLosses"].shape
+            (3, 10)
+        )pbdoc",
+        py::arg("magnetic_json"),
+        py::arg("operating_point_json"),
+        py::arg("axes"),
+        py::arg("models_json") = nullptr,
+        py::arg("threads") = 0);
 
     m.def("calculate_coupling_coefficient_matrix", &calculate_coupling_coefficient_matrix,
         py::arg("magnetic_json"),
         py::arg("frequency"),
         py::arg("models_data"),
-        "Calculate the coupling coefficient matrix for a magnetic component.");
+        "Calculate the coupling coefficient matrix for a magnetic component.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_leakage_inductance_matrix", &calculate_leakage_inductance_matrix,
         py::arg("magnetic_json"),
         py::arg("frequency"),
         py::arg("models_data"),
-        "Calculate the leakage inductance matrix for a magnetic component.");
+        "Calculate the leakage inductance matrix for a magnetic component.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_capacitance_matrix", &calculate_capacitance_matrix,
         py::arg("coil_json"),
         py::arg("models_data"),
-        "Calculate the capacitance matrix for a coil.");
+        "Calculate the capacitance matrix for a coil.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("calculate_capacitance_models_between_windings", &calculate_capacitance_models_between_windings,
         py::arg("energy"),
         py::arg("voltage_drop"),
         py::arg("relative_turns_ratio"),
-        "Calculate six-capacitor and tripole capacitance models between windings.");
+        "Calculate six-capacitor and tripole capacitance models between windings.",
+        py::call_guard<py::gil_scoped_release>());
 
     m.def("export_magnetic_as_symbol", &export_magnetic_as_symbol,
         py::arg("magnetic_json"),
         py::arg("inputs_json"),
-        "Export a magnetic component as a circuit simulator symbol.");
+        "Export a magnetic component as a circuit simulator symbol.",
+        py::call_guard<py::gil_scoped_release>());
 }
 
 } // namespace PyMKF
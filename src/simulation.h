@@ -2,10 +2,36 @@
 
 #include "common.h"
 
+#include <limits>
+
 namespace PyMKF {
 
 // Simulation
-json simulate(json inputsJson, json magneticJson, json modelsData);
+json simulate(json inputsJson, json magneticJson, json modelsData, json outputsJson = nullptr);
+
+// Model selection and per-operating-point evaluation shared by simulate,
+// sweep_grid and MagneticSession. modelsData is {"coreLosses": ...,
+// "reluctance": ...} or null for the defaults.
+void configure_magnetic_simulator(OpenMagnetics::MagneticSimulator& magneticSimulator, const json& modelsData);
+
+struct OperatingPointLosses {
+    double coreLosses = std::numeric_limits<double>::quiet_NaN();
+    double windingLosses = std::numeric_limits<double>::quiet_NaN();
+    double magneticFluxDensityPeak = std::numeric_limits<double>::quiet_NaN();
+    double temperature = std::numeric_limits<double>::quiet_NaN();
+};
+
+// Core losses (with flux density and core temperature) and winding losses at
+// the point's ambient temperature. Throws whatever the MKF models throw.
+OperatingPointLosses evaluate_operating_point_losses(OpenMagnetics::MagneticSimulator& magneticSimulator,
+                                                     OpenMagnetics::WindingLosses& windingLossesModel,
+                                                     OpenMagnetics::Magnetic& magnetic,
+                                                     OperatingPoint& operatingPoint);
+
+// simulate() result cache (opt-in LRU)
+void configure_simulation_cache(size_t maxEntries, size_t maxBytes);
+json get_simulation_cache_stats();
+std::string clear_simulation_cache();
 
 // Export
 std::string export_magnetic_as_subcircuit(json magneticJson);
@@ -15,7 +41,7 @@ json mas_autocomplete(json masJson, json configuration);
 json magnetic_autocomplete(json magneticJson, json configuration);
 
 // Input processing
-json process_inputs(json inputsJson);
+json process_inputs(json inputsJson, std::optional<double> harmonicEnergyThreshold = std::nullopt);
 json extract_operating_point(json fileJson, size_t numberWindings, double frequency, double desiredMagnetizingInductance, json mapColumnNamesJson);
 json extract_map_column_names(json fileJson, size_t numberWindings, double frequency);
 json extract_column_names(json fileJson);
@@ -35,16 +61,17 @@ json calculate_capacitance_matrix(json coilJson, json modelsData);
 json calculate_capacitance_models_between_windings(double energy, double voltageDrop, double relativeTurnsRatio);
 
 // Sweep functions
-json sweep_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title);
-json sweep_differential_mode_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title);
-json sweep_q_factor_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title);
-json sweep_winding_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, size_t windingIndex, double temperature, std::string mode, std::string title);
-json sweep_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title);
-json sweep_magnetizing_inductance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title);
-json sweep_magnetizing_inductance_over_temperature(json magneticJson, double start, double stop, size_t numberElements, double frequency, std::string mode, std::string title);
-json sweep_magnetizing_inductance_over_dc_bias(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title);
-json sweep_core_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title);
-json sweep_winding_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title);
+json sweep_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads = 1);
+json sweep_differential_mode_impedance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads = 1);
+json sweep_q_factor_over_frequency(json magneticJson, double start, double stop, size_t numberElements, std::string mode, std::string title, int threads = 1);
+json sweep_winding_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, size_t windingIndex, double temperature, std::string mode, std::string title, int threads = 1);
+json sweep_resistance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads = 1);
+json sweep_magnetizing_inductance_over_frequency(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads = 1);
+json sweep_magnetizing_inductance_over_temperature(json magneticJson, double start, double stop, size_t numberElements, double frequency, std::string mode, std::string title, int threads = 1);
+json sweep_magnetizing_inductance_over_dc_bias(json magneticJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads = 1);
+json sweep_core_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads = 1);
+json sweep_winding_losses_over_frequency(json magneticJson, json operatingPointJson, double start, double stop, size_t numberElements, double temperature, std::string mode, std::string title, int threads = 1);
+py::dict sweep_grid(json magneticJson, json operatingPointJson, py::sequence axes, json modelsData = nullptr, int threads = 0);
 
 // Matrix calculations
 json calculate_coupling_coefficient_matrix(json magneticJson, double frequency, json modelsData);
@@ -0,0 +1,572 @@
+#include "snapshot.h"
+#include "concurrency.h"
+#include "database.h"
+#include "mapped_file.h"
+#include "settings.h"
+#include "thread_pool.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+namespace PyMKF {
+
+namespace {
+
+constexpr char snapshotMagic[8] = {'P', 'Y', 'O', 'M', 'S', 'N', 'A', 'P'};
+constexpr size_t snapshotSectionCount = static_cast<size_t>(SnapshotSection::COUNT);
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t recordCount;
+};
+static_assert(sizeof(SnapshotHeader) == 24, "unexpected header padding");
+
+struct SnapshotRecord {
+    SnapshotSection section;
+    uint32_t keySize;
+    uint64_t offset;  // of the key; the value blob follows it
+    uint64_t size;    // of the value blob
+};
+static_assert(sizeof(SnapshotRecord) == 24, "unexpected record padding");
+
+struct EncodedRecord {
+    std::string key;
+    std::vector<uint8_t> value;
+};
+
+using CoreMaterialEntry = decltype(OpenMagnetics::coreMaterialDatabase)::mapped_type;
+using CoreShapeEntry = decltype(OpenMagnetics::coreShapeDatabase)::mapped_type;
+using WireEntry = decltype(OpenMagnetics::wireDatabase)::mapped_type;
+using BobbinEntry = decltype(OpenMagnetics::bobbinDatabase)::mapped_type;
+using InsulationMaterialEntry = decltype(OpenMagnetics::insulationMaterialDatabase)::mapped_type;
+using WireMaterialEntry = decltype(OpenMagnetics::wireMaterialDatabase)::mapped_type;
+using CoreEntry = decltype(OpenMagnetics::coreDatabase)::value_type;
+
+template <typename T>
+EncodedRecord encode_record(std::string key, const T& value) {
+    json valueJson;
+    to_json(valueJson, value);
+    return {std::move(key), json::to_msgpack(valueJson)};
+}
+
+// MKF's own classes build from JSON; the plain MAS types only have from_json.
+template <typename T>
+T decode_entry(const json& value) {
+    if constexpr (std::is_constructible_v<T, const json&>) {
+        return T(value);
+    }
+    else {
+        return value.get<T>();
+    }
+}
+
+json snapshot_counts() {
+    json counts;
+    counts["coreMaterials"] = OpenMagnetics::coreMaterialDatabase.size();
+    counts["coreShapes"] = OpenMagnetics::coreShapeDatabase.size();
+    counts["wires"] = OpenMagnetics::wireDatabase.size();
+    counts["bobbins"] = OpenMagnetics::bobbinDatabase.size();
+    counts["insulationMaterials"] = OpenMagnetics::insulationMaterialDatabase.size();
+    counts["wireMaterials"] = OpenMagnetics::wireMaterialDatabase.size();
+    counts["cores"] = OpenMagnetics::coreDatabase.size();
+    counts["magnetics"] = OpenMagnetics::magneticsCache.size();
+    return counts;
+}
+
+// Validates the header and record table of a snapshot image.
+std::vector<SnapshotRecord> read_record_table(std::string_view image, const std::string& origin) {
+    SnapshotHeader header;
+    if (image.size() < sizeof(header)) {
+        throw std::runtime_error(origin + " is not a state snapshot");
+    }
+    std::memcpy(&header, image.data(), sizeof(header));
+    if (std::memcmp(header.magic, snapshotMagic, sizeof(snapshotMagic)) != 0) {
+        throw std::runtime_error(origin + " is not a state snapshot");
+    }
+    if (header.version != snapshotFormatVersion) {
+        throw std::runtime_error(origin + " has snapshot format version " + std::to_string(header.version) +
+                                 ", expected " + std::to_string(snapshotFormatVersion));
+    }
+    // Bound the count by the bytes actually there before multiplying, so a
+    // corrupt count can neither overflow nor size a huge allocation.
+    if (header.recordCount > (image.size() - sizeof(header)) / sizeof(SnapshotRecord)) {
+        throw std::runtime_error(origin + " is truncated");
+    }
+    const size_t tableBytes = header.recordCount * sizeof(SnapshotRecord);
+    std::vector<SnapshotRecord> records(header.recordCount);
+    std::memcpy(records.data(), image.data() + sizeof(header), tableBytes);
+    for (size_t index = 0; index < records.size(); ++index) {
+        auto& record = records[index];
+        if (static_cast<size_t>(record.section) >= snapshotSectionCount ||
+            record.offset > image.size() ||
+            record.keySize > image.size() - record.offset ||
+            record.size > image.size() - record.offset - record.keySize) {
+            throw std::runtime_error(origin + " is corrupt at record " + std::to_string(index));
+        }
+    }
+    return records;
+}
+
+std::string_view record_key(std::string_view image, const SnapshotRecord& record) {
+    return image.substr(record.offset, record.keySize);
+}
+
+json decode_record_value(std::string_view image, const SnapshotRecord& record) {
+    auto begin = reinterpret_cast<const uint8_t*>(image.data() + record.offset + record.keySize);
+    return json::from_msgpack(begin, begin + record.size);
+}
+
+struct SharedStateStore {
+    std::string path;
+    MappedFile file;
+    std::vector<SnapshotRecord> records;
+    // Keys view straight into the mapping.
+    std::array<std::unordered_map<std::string_view, size_t>, snapshotSectionCount> index;
+};
+
+std::unique_ptr<SharedStateStore> sharedState;
+
+} // namespace
+
+json save_state_snapshot(std::string path) {
+    try {
+        StateWriteLock stateLock;
+
+        // One encoder per record, in a fixed order, so equal states produce
+        // byte-identical files.
+        std::vector<SnapshotSection> sections;
+        std::vector<std::function<EncodedRecord()>> encoders;
+        sections.push_back(SnapshotSection::SETTINGS);
+        encoders.push_back([] { return EncodedRecord{"settings", json::to_msgpack(get_settings())}; });
+        for (auto& [name, material] : OpenMagnetics::coreMaterialDatabase) {
+            sections.push_back(SnapshotSection::CORE_MATERIALS);
+            encoders.push_back([&name, &material] { return encode_record(name, material); });
+        }
+        for (auto& [name, shape] : OpenMagnetics::coreShapeDatabase) {
+            sections.push_back(SnapshotSection::CORE_SHAPES);
+            encoders.push_back([&name, &shape] { return encode_record(name, shape); });
+        }
+        for (auto& [name, wire] : OpenMagnetics::wireDatabase) {
+            sections.push_back(SnapshotSection::WIRES);
+            encoders.push_back([&name, &wire] { return encode_record(name, wire); });
+        }
+        for (auto& [name, bobbin] : OpenMagnetics::bobbinDatabase) {
+            sections.push_back(SnapshotSection::BOBBINS);
+            encoders.push_back([&name, &bobbin] { return encode_record(name, bobbin); });
+        }
+        for (auto& [name, material] : OpenMagnetics::insulationMaterialDatabase) {
+            sections.push_back(SnapshotSection::INSULATION_MATERIALS);
+            encoders.push_back([&name, &material] { return encode_record(name, material); });
+        }
+        for (auto& [name, material] : OpenMagnetics::wireMaterialDatabase) {
+            sections.push_back(SnapshotSection::WIRE_MATERIALS);
+            encoders.push_back([&name, &material] { return encode_record(name, material); });
+        }
+        for (auto& core : OpenMagnetics::coreDatabase) {
+            sections.push_back(SnapshotSection::CORES);
+            encoders.push_back([&core] { return encode_record(core.get_name().value_or(""), core); });
+        }
+        auto magnetics = OpenMagnetics::magneticsCache.get();
+        for (auto& magnetic : magnetics) {
+            sections.push_back(SnapshotSection::MAGNETICS);
+            encoders.push_back([&magnetic] {
+                return encode_record(magnetic.get_manufacturer_info()->get_reference().value(), magnetic);
+            });
+        }
+
+        std::vector<EncodedRecord> encoded(encoders.size());
+        parallel_for(encoded.size(), resolve_thread_count(0, encoded.size()), [&](size_t index) {
+            encoded[index] = encoders[index]();
+        });
+
+        SnapshotHeader header;
+        std::memcpy(header.magic, snapshotMagic, sizeof(snapshotMagic));
+        header.version = snapshotFormatVersion;
+        header.reserved = 0;
+        header.recordCount = encoded.size();
+
+        std::vector<SnapshotRecord> records(encoded.size());
+        uint64_t offset = sizeof(SnapshotHeader) + records.size() * sizeof(SnapshotRecord);
+        for (size_t index = 0; index < encoded.size(); ++index) {
+            auto keySize = static_cast<uint32_t>(encoded[index].key.size());
+            records[index] = {sections[index], keySize, offset, encoded[index].value.size()};
+            offset += keySize + encoded[index].value.size();
+        }
+
+        // Write-then-rename so readers never see a partial snapshot.
+        std::filesystem::path snapshotPath{path};
+        auto temporaryPath = snapshotPath;
+        temporaryPath += ".tmp";
+        {
+            std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                throw std::runtime_error("Cannot write snapshot to " + temporaryPath.string());
+            }
+            out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(SnapshotRecord)));
+            for (auto& record : encoded) {
+                out.write(record.key.data(), static_cast<std::streamsize>(record.key.size()));
+                out.write(reinterpret_cast<const char*>(record.value.data()), static_cast<std::streamsize>(record.value.size()));
+            }
+        }
+        std::filesystem::rename(temporaryPath, snapshotPath);
+
+        json result = snapshot_counts();
+        result["bytes"] = offset;
+        return result;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+// The live state restore_state_snapshot replaces, kept so a failed restore
+// can put it back.
+struct LiveState {
+    json settings;
+    decltype(OpenMagnetics::coreMaterialDatabase) coreMaterials;
+    decltype(OpenMagnetics::coreShapeDatabase) coreShapes;
+    decltype(OpenMagnetics::wireDatabase) wires;
+    decltype(OpenMagnetics::bobbinDatabase) bobbins;
+    decltype(OpenMagnetics::insulationMaterialDatabase) insulationMaterials;
+    decltype(OpenMagnetics::wireMaterialDatabase) wireMaterials;
+
+    void swap_databases() {
+        std::swap(coreMaterials, OpenMagnetics::coreMaterialDatabase);
+        std::swap(coreShapes, OpenMagnetics::coreShapeDatabase);
+        std::swap(wires, OpenMagnetics::wireDatabase);
+        std::swap(bobbins, OpenMagnetics::bobbinDatabase);
+        std::swap(insulationMaterials, OpenMagnetics::insulationMaterialDatabase);
+        std::swap(wireMaterials, OpenMagnetics::wireMaterialDatabase);
+    }
+};
+
+template <typename Entry, typename Database>
+void install_entries(std::vector<std::optional<std::pair<std::string, Entry>>>& entries, Database& database) {
+    database.clear();
+    for (auto& entry : entries) {
+        database.emplace(std::move(entry->first), std::move(entry->second));
+    }
+}
+
+json restore_state_snapshot(std::string_view image, const std::string& origin) {
+    auto records = read_record_table(image, origin);
+
+    // Slot of each record inside its section, so decoders write disjoint cells.
+    std::vector<size_t> slots(records.size());
+    std::array<size_t, snapshotSectionCount> sectionSizes{};
+    for (size_t index = 0; index < records.size(); ++index) {
+        slots[index] = sectionSizes[static_cast<size_t>(records[index].section)]++;
+    }
+    auto sectionSize = [&](SnapshotSection section) { return sectionSizes[static_cast<size_t>(section)]; };
+    auto isDatabase = [](SnapshotSection section) {
+        return section != SnapshotSection::CORES && section != SnapshotSection::MAGNETICS;
+    };
+
+    // Databases first: they are plain data and decode without looking
+    // anything up.
+    json settingsJson;
+    std::vector<std::optional<std::pair<std::string, CoreMaterialEntry>>> materials(sectionSize(SnapshotSection::CORE_MATERIALS));
+    std::vector<std::optional<std::pair<std::string, CoreShapeEntry>>> shapes(sectionSize(SnapshotSection::CORE_SHAPES));
+    std::vector<std::optional<std::pair<std::string, WireEntry>>> wires(sectionSize(SnapshotSection::WIRES));
+    std::vector<std::optional<std::pair<std::string, BobbinEntry>>> bobbins(sectionSize(SnapshotSection::BOBBINS));
+    std::vector<std::optional<std::pair<std::string, InsulationMaterialEntry>>> insulationMaterials(sectionSize(SnapshotSection::INSULATION_MATERIALS));
+    std::vector<std::optional<std::pair<std::string, WireMaterialEntry>>> wireMaterials(sectionSize(SnapshotSection::WIRE_MATERIALS));
+
+    parallel_for(records.size(), resolve_thread_count(0, records.size()), [&](size_t index) {
+        auto& record = records[index];
+        if (!isDatabase(record.section)) {
+            return;
+        }
+        std::string key{record_key(image, record)};
+        json value = decode_record_value(image, record);
+        size_t slot = slots[index];
+        switch (record.section) {
+            case SnapshotSection::SETTINGS:
+                settingsJson = std::move(value);
+                break;
+            case SnapshotSection::CORE_MATERIALS:
+                materials[slot].emplace(std::move(key), decode_entry<CoreMaterialEntry>(value));
+                break;
+            case SnapshotSection::CORE_SHAPES:
+                shapes[slot].emplace(std::move(key), decode_entry<CoreShapeEntry>(value));
+                break;
+            case SnapshotSection::WIRES:
+                wires[slot].emplace(std::move(key), decode_entry<WireEntry>(value));
+                break;
+            case SnapshotSection::BOBBINS:
+                bobbins[slot].emplace(std::move(key), decode_entry<BobbinEntry>(value));
+                break;
+            case SnapshotSection::INSULATION_MATERIALS:
+                insulationMaterials[slot].emplace(std::move(key), decode_entry<InsulationMaterialEntry>(value));
+                break;
+            case SnapshotSection::WIRE_MATERIALS:
+                wireMaterials[slot].emplace(std::move(key), decode_entry<WireMaterialEntry>(value));
+                break;
+            default:
+                break;
+        }
+    });
+
+    // Cores and magnetics resolve materials, shapes and wires by name while
+    // they are built, so the new databases go live before they decode, with
+    // the old ones kept aside in case one of them fails. The live cores and
+    // magnetics are only replaced once all of them have decoded.
+    LiveState previous;
+    previous.settings = get_settings();
+    previous.swap_databases();
+    try {
+        if (!settingsJson.is_null()) {
+            set_settings(settingsJson);
+        }
+        install_entries(materials, OpenMagnetics::coreMaterialDatabase);
+        install_entries(shapes, OpenMagnetics::coreShapeDatabase);
+        install_entries(wires, OpenMagnetics::wireDatabase);
+        install_entries(bobbins, OpenMagnetics::bobbinDatabase);
+        install_entries(insulationMaterials, OpenMagnetics::insulationMaterialDatabase);
+        install_entries(wireMaterials, OpenMagnetics::wireMaterialDatabase);
+        // A database the snapshot did not carry would otherwise be loaded
+        // lazily, and concurrently, by the first decoder that needs it.
+        load_missing_databases();
+
+        std::vector<std::optional<CoreEntry>> cores(sectionSize(SnapshotSection::CORES));
+        std::vector<std::optional<std::pair<std::string, OpenMagnetics::Magnetic>>> magnetics(sectionSize(SnapshotSection::MAGNETICS));
+        parallel_for(records.size(), resolve_thread_count(0, records.size()), [&](size_t index) {
+            auto& record = records[index];
+            if (record.section == SnapshotSection::CORES) {
+                cores[slots[index]].emplace(decode_record_value(image, record));
+            }
+            else if (record.section == SnapshotSection::MAGNETICS) {
+                magnetics[slots[index]].emplace(std::string{record_key(image, record)},
+                                                OpenMagnetics::Magnetic(decode_record_value(image, record)));
+            }
+        });
+
+        OpenMagnetics::coreDatabase.clear();
+        for (auto& core : cores) {
+            OpenMagnetics::coreDatabase.push_back(std::move(*core));
+        }
+        OpenMagnetics::magneticsCache.clear();
+        for (auto& entry : magnetics) {
+            OpenMagnetics::magneticsCache.load(entry->first, entry->second);
+        }
+    }
+    catch (...) {
+        previous.swap_databases();
+        OpenMagnetics::settings.reset();
+        set_settings(previous.settings);
+        throw;
+    }
+    invalidate_database_views();
+
+    json result = snapshot_counts();
+    result["bytes"] = image.size();
+    return result;
+}
+
+json load_state_snapshot(std::string path) {
+    try {
+        StateWriteLock stateLock;
+        MappedFile file(path);
+        return restore_state_snapshot(file.view(), path);
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+json attach_shared_state(std::string path, bool hydrate) {
+    try {
+        StateWriteLock stateLock;
+        auto store = std::make_unique<SharedStateStore>();
+        store->path = path;
+        store->file = MappedFile(path);
+        store->records = read_record_table(store->file.view(), path);
+        for (size_t index = 0; index < store->records.size(); ++index) {
+            auto& record = store->records[index];
+            store->index[static_cast<size_t>(record.section)].emplace(record_key(store->file.view(), record), index);
+        }
+
+        json result;
+        if (hydrate) {
+            result = restore_state_snapshot(store->file.view(), path);
+        }
+        sharedState = std::move(store);
+        json info = get_shared_state_info();
+        info["hydrated"] = hydrate;
+        if (hydrate) {
+            info["loaded"] = result;
+        }
+        return info;
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+void detach_shared_state() {
+    StateWriteLock stateLock;
+    sharedState.reset();
+}
+
+json get_shared_state_info() {
+    StateReadLock stateLock;
+    json info;
+    info["attached"] = sharedState != nullptr;
+    if (sharedState) {
+        info["path"] = sharedState->path;
+        info["bytes"] = sharedState->file.size();
+        info["coreMaterials"] = sharedState->index[static_cast<size_t>(SnapshotSection::CORE_MATERIALS)].size();
+        info["coreShapes"] = sharedState->index[static_cast<size_t>(SnapshotSection::CORE_SHAPES)].size();
+        info["wires"] = sharedState->index[static_cast<size_t>(SnapshotSection::WIRES)].size();
+        info["bobbins"] = sharedState->index[static_cast<size_t>(SnapshotSection::BOBBINS)].size();
+        info["insulationMaterials"] = sharedState->index[static_cast<size_t>(SnapshotSection::INSULATION_MATERIALS)].size();
+        info["wireMaterials"] = sharedState->index[static_cast<size_t>(SnapshotSection::WIRE_MATERIALS)].size();
+        info["cores"] = sharedState->index[static_cast<size_t>(SnapshotSection::CORES)].size();
+        info["magnetics"] = sharedState->index[static_cast<size_t>(SnapshotSection::MAGNETICS)].size();
+    }
+    return info;
+}
+
+// Whether the in-process database behind `section` holds anything; once it
+// does, it is the authority and the shared store no longer answers for it.
+bool in_process_database_loaded(SnapshotSection section) {
+    switch (section) {
+        case SnapshotSection::CORE_MATERIALS:
+            return OpenMagnetics::coreMaterialDatabase.size() > 0;
+        case SnapshotSection::CORE_SHAPES:
+            return OpenMagnetics::coreShapeDatabase.size() > 0;
+        case SnapshotSection::WIRES:
+            return OpenMagnetics::wireDatabase.size() > 0;
+        case SnapshotSection::BOBBINS:
+            return OpenMagnetics::bobbinDatabase.size() > 0;
+        case SnapshotSection::INSULATION_MATERIALS:
+            return OpenMagnetics::insulationMaterialDatabase.size() > 0;
+        case SnapshotSection::WIRE_MATERIALS:
+            return OpenMagnetics::wireMaterialDatabase.size() > 0;
+        case SnapshotSection::CORES:
+            return OpenMagnetics::coreDatabase.size() > 0;
+        case SnapshotSection::MAGNETICS:
+            return OpenMagnetics::magneticsCache.size() > 0;
+        default:
+            return false;
+    }
+}
+
+std::optional<json> find_in_shared_state(SnapshotSection section, const std::string& name) {
+    StateReadLock stateLock;
+    if (!sharedState || in_process_database_loaded(section)) {
+        return std::nullopt;
+    }
+    auto& sectionIndex = sharedState->index[static_cast<size_t>(section)];
+    auto it = sectionIndex.find(name);
+    if (it == sectionIndex.end()) {
+        return std::nullopt;
+    }
+    return decode_record_value(sharedState->file.view(), sharedState->records[it->second]);
+}
+
+void register_snapshot_bindings(py::module& m) {
+    m.def("save_state_snapshot", &save_state_snapshot,
+        R"pbdoc(
+        Save the loaded databases and magnetics cache to a binary snapshot.
+
+        Stores the settings, core materials, core shapes, wires, bobbins,
+        insulation materials, wire materials, loaded cores and the magnetics
+        cache. Restoring it with load_state_snapshot() skips
+        NDJSON parsing and magnetic autocompletion entirely.
+
+        Args:
+            path: Destination file. It is written atomically.
+
+        Returns:
+            JSON object with the number of entries per database
+            ("coreMaterials", "coreShapes", "wires", "bobbins",
+            "insulationMaterials", "wireMaterials", "cores", "magnetics")
+            and the file size in "bytes".
+
+        Example:
+            >>> PyMKF.read_databases(mas_path, True)
+            >>> PyMKF.load_cores(None, True, False)
+            >>> PyMKF.save_state_snapshot("/var/cache/pyom/state.snap")
+        )pbdoc",
+        py::arg("path"),
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("load_state_snapshot", &load_state_snapshot,
+        R"pbdoc(
+        Replace the loaded databases and magnetics cache with a snapshot.
+
+        The snapshot is memory-mapped and decoded on all hardware threads:
+        the databases first, then the cores and magnetics that refer to
+        them. A corrupt or incompatible file leaves the current state
+        untouched. Also clears
+        the simulate() cache and the core feature index.
+
+        Args:
+            path: File written by save_state_snapshot().
+
+        Returns:
+            JSON object with the restored entry counts and "bytes", or
+            {"data": "Exception: ..."} on error.
+        )pbdoc",
+        py::arg("path"),
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("attach_shared_state", &attach_shared_state,
+        R"pbdoc(
+        Attach a snapshot as a read-only store shared by all worker processes.
+
+        The file is memory-mapped and only its key table is read, so every
+        process attached to the same file shares one copy of it through the
+        OS page cache. While a database is not loaded in the process,
+        find_core_material_by_name(), find_core_shape_by_name() and
+        find_wire_by_name() decode the requested entry from the mapping
+        instead of loading it. Once it is loaded (by hydrate=True, a load_*
+        call or a database write-back) the in-process database answers.
+
+        Those three finders are the only readers of the store. Everything
+        that resolves names inside MKF (building a core or magnetic from
+        names, losses, simulations, advisers) uses MKF's in-process
+        databases and does not see an attached store. Pass hydrate=True to
+        fill them from the same mapping, or load them in the parent before
+        forking so workers share them copy-on-write.
+
+        Args:
+            path: File written by save_state_snapshot().
+            hydrate: Also restore the in-process databases from the snapshot.
+
+        Returns:
+            JSON object with "attached", "path", "bytes" and the entry count
+            per database, or {"data": "Exception: ..."} on error.
+        )pbdoc",
+        py::arg("path"), py::arg("hydrate") = false,
+        py::call_guard<py::gil_scoped_release>());
+
+    m.def("detach_shared_state", &detach_shared_state,
+        "Unmap the shared state store; lookups fall back to the in-process databases");
+
+    m.def("get_shared_state_info", &get_shared_state_info,
+        R"pbdoc(
+        Describe the attached shared state store.
+
+        Returns:
+            JSON object with "attached" and, when attached, "path", "bytes"
+            and the entry count per database.
+        )pbdoc");
+}
+
+} // namespace PyMKF
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "common.h"
+
+#include <optional>
+#include <string_view>
+
+namespace PyMKF {
+
+// ─── Binary state snapshots ─────────────────────────────────────────────────
+// Serialises the expensive-to-rebuild process state so a worker or a fresh
+// container can restore it without parsing NDJSON or re-running
+// magnetic_autocomplete:
+//
+//   settings, coreMaterialDatabase, coreShapeDatabase, wireDatabase,
+//   bobbinDatabase, insulationMaterialDatabase, wireMaterialDatabase,
+//   coreDatabase, magneticsCache
+//
+// Layout (native little-endian):
+//   SnapshotHeader
+//   SnapshotRecord[recordCount]   section, key length and byte range
+//   per record: key bytes, then the MessagePack blob of the value
+//
+// Every database entry is its own blob, so both saving and loading spread the
+// (de)serialisation over the native pool, and a single entry can be decoded
+// by name straight from a mapping of the file (see attach_shared_state).
+constexpr uint32_t snapshotFormatVersion = 3;
+
+enum class SnapshotSection : uint32_t {
+    SETTINGS,
+    CORE_MATERIALS,
+    CORE_SHAPES,
+    WIRES,
+    CORES,
+    MAGNETICS,
+    BOBBINS,
+    INSULATION_MATERIALS,
+    WIRE_MATERIALS,
+    COUNT
+};
+
+json save_state_snapshot(std::string path);
+json load_state_snapshot(std::string path);
+
+// Restores the state from an in-memory snapshot image, e.g. a shared mapping.
+// The databases are decoded and installed first, then the cores and magnetics
+// that refer to them by name; if anything fails the previous state is put
+// back. `origin` names the image in error messages. Caller holds a
+// StateWriteLock.
+json restore_state_snapshot(std::string_view image, const std::string& origin);
+
+// ─── Shared read-only store ─────────────────────────────────────────────────
+// Maps a snapshot read-only and indexes its keys without decoding anything.
+// The pages belong to the OS page cache, so every worker process attached to
+// the same file shares one physical copy. Only the PyMKF find_*_by_name
+// bindings fall back to it, while the in-process database is not loaded, and
+// decode just that entry, so a worker that only serves lookups never
+// materialises the databases at all. MKF's own lookups by name (building a
+// Core or Magnetic, losses, simulations, advisers) never see the store; they
+// need the databases hydrated. A loaded database always wins, so loads and
+// write-backs are never shadowed by the store.
+json attach_shared_state(std::string path, bool hydrate);
+void detach_shared_state();
+json get_shared_state_info();
+
+// JSON of the entry `name` in `section`, or nullopt when no store is
+// attached, the in-process database for `section` is loaded, or the store has
+// no such entry. Takes the shared state lock itself.
+std::optional<json> find_in_shared_state(SnapshotSection section, const std::string& name);
+
+void register_snapshot_bindings(py::module& m);
+
+} // namespace PyMKF
@@ -0,0 +1,281 @@
+#include "spice_batch.h"
+#include "mapped_file.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace PyMKF {
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) text.remove_suffix(1);
+    return text;
+}
+
+// Reads one line starting at `position` and moves past its newline.
+std::string_view next_line(std::string_view contents, size_t& position) {
+    size_t end = contents.find('\n', position);
+    if (end == std::string_view::npos) end = contents.size();
+    auto line = contents.substr(position, end - position);
+    position = std::min(end + 1, contents.size());
+    return line;
+}
+
+std::string_view header_value(std::string_view line, std::string_view key) {
+    return line.substr(0, key.size()) == key ? trim(line.substr(key.size())) : std::string_view{};
+}
+
+size_t parse_count(std::string_view value, const char* field) {
+    try {
+        return std::stoul(std::string(value));
+    }
+    catch (const std::exception&) {
+        throw std::runtime_error(std::string("Malformed rawfile: bad ") + field);
+    }
+}
+
+std::string_view next_token(std::string_view contents, size_t& position) {
+    while (position < contents.size() && std::isspace(static_cast<unsigned char>(contents[position]))) ++position;
+    size_t start = position;
+    while (position < contents.size() && !std::isspace(static_cast<unsigned char>(contents[position]))) ++position;
+    return contents.substr(start, position - start);
+}
+
+double parse_number(std::string_view token) {
+    std::string text(token);
+    char* end = nullptr;
+    double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || end != text.c_str() + text.size()) {
+        throw std::runtime_error("Malformed rawfile: bad value '" + text + "'");
+    }
+    return value;
+}
+
+int run_process(const std::vector<std::string>& arguments) {
+#ifdef _WIN32
+    std::vector<std::wstring> wideArguments;
+    for (auto& argument : arguments) {
+        std::wstring quoted = L"\"" + std::filesystem::path(argument).wstring() + L"\"";
+        wideArguments.push_back(quoted);
+    }
+    std::vector<const wchar_t*> argv;
+    for (auto& argument : wideArguments) argv.push_back(argument.c_str());
+    argv.push_back(nullptr);
+    auto executable = std::filesystem::path(arguments[0]).wstring();
+    return static_cast<int>(_wspawnv(_P_WAIT, executable.c_str(), argv.data()));
+#else
+    std::vector<char*> argv;
+    for (auto& argument : arguments) argv.push_back(const_cast<char*>(argument.c_str()));
+    argv.push_back(nullptr);
+    pid_t pid;
+    if (posix_spawn(&pid, arguments[0].c_str(), nullptr, nullptr, argv.data(), environ) != 0) {
+        return -1;
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) {
+        return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#endif
+}
+
+std::string read_text_file(const std::filesystem::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+// The wheel ships libngspice for the in-process paths, never the executable,
+// so a missing binary is the usual first-run failure; say what to install.
+const char* missingExecutableHint =
+    " (run_ngspice_batch needs a standalone ngspice install; the wheel only bundles the shared library)";
+
+} // namespace
+
+std::vector<SpicePlot> parse_ngspice_rawfile(std::string_view contents) {
+    std::vector<SpicePlot> plots;
+    size_t position = 0;
+    while (position < contents.size()) {
+        SpicePlot plot;
+        size_t numberVariables = 0;
+        size_t numberPoints = 0;
+        bool binary = false;
+        bool sawHeader = false;
+        bool sawData = false;
+        while (position < contents.size()) {
+            auto line = trim(next_line(contents, position));
+            if (line.empty()) continue;
+            sawHeader = true;
+            if (auto value = header_value(line, "Title:"); !value.empty()) plot.title = value;
+            else if (auto value = header_value(line, "Plotname:"); !value.empty()) plot.plotName = value;
+            else if (auto value = header_value(line, "Flags:"); !value.empty()) plot.complex = value.find("complex") != std::string_view::npos;
+            else if (auto value = header_value(line, "No. Variables:"); !value.empty()) numberVariables = parse_count(value, "No. Variables");
+            else if (auto value = header_value(line, "No. Points:"); !value.empty()) numberPoints = parse_count(value, "No. Points");
+            else if (line == "Variables:") {
+                for (size_t variable = 0; variable < numberVariables; ++variable) {
+                    auto variableLine = trim(next_line(contents, position));
+                    size_t cursor = 0;
+                    next_token(variableLine, cursor);
+                    plot.names.emplace_back(next_token(variableLine, cursor));
+                }
+            }
+            else if (line == "Binary:" || line == "Values:") {
+                binary = line == "Binary:";
+                sawData = true;
+                break;
+            }
+        }
+        if (!sawData) {
+            if (sawHeader) {
+                throw std::runtime_error("Truncated rawfile: header without data");
+            }
+            break;
+        }
+        if (plot.names.size() != numberVariables || numberVariables == 0) {
+            throw std::runtime_error("Malformed rawfile: variable list does not match No. Variables");
+        }
+
+        const size_t width = plot.complex ? 2 : 1;
+        plot.values.assign(numberVariables, std::vector<double>(numberPoints * width));
+        if (binary) {
+            const size_t bytes = numberPoints * numberVariables * width * sizeof(double);
+            if (contents.size() - position < bytes) {
+                throw std::runtime_error("Truncated rawfile: expected " + std::to_string(numberPoints) + " points");
+            }
+            const char* data = contents.data() + position;
+            for (size_t point = 0; point < numberPoints; ++point) {
+                for (size_t variable = 0; variable < numberVariables; ++variable) {
+                    std::memcpy(&plot.values[variable][point * width], data, width * sizeof(double));
+                    data += width * sizeof(double);
+                }
+            }
+            position += bytes;
+        }
+        else {
+            for (size_t point = 0; point < numberPoints; ++point) {
+                next_token(contents, position);  // point index
+                for (size_t variable = 0; variable < numberVariables; ++variable) {
+                    auto token = next_token(contents, position);
+                    if (token.empty()) {
+                        throw std::runtime_error("Truncated rawfile: expected " + std::to_string(numberPoints) + " points");
+                    }
+                    if (plot.complex) {
+                        size_t comma = token.find(',');
+                        if (comma == std::string_view::npos) {
+                            throw std::runtime_error("Malformed rawfile: complex value without imaginary part");
+                        }
+                        plot.values[variable][point * 2] = parse_number(token.substr(0, comma));
+                        plot.values[variable][point * 2 + 1] = parse_number(token.substr(comma + 1));
+                    }
+                    else {
+                        plot.values[variable][point] = parse_number(token);
+                    }
+                }
+            }
+        }
+        plots.push_back(std::move(plot));
+    }
+    return plots;
+}
+
+std::filesystem::path resolve_ngspice_executable(const std::string& ngspicePath) {
+    std::filesystem::path candidate(ngspicePath);
+    if (candidate.has_parent_path()) {
+        if (std::filesystem::exists(candidate)) {
+            return candidate;
+        }
+        throw std::runtime_error("ngspice executable not found: " + ngspicePath + missingExecutableHint);
+    }
+    const char* path = std::getenv("PATH");
+#ifdef _WIN32
+    const char separator = ';';
+    const std::vector<std::string> suffixes = {"", ".exe"};
+#else
+    const char separator = ':';
+    const std::vector<std::string> suffixes = {""};
+#endif
+    std::string_view directories = path ? path : "";
+    while (true) {
+        size_t end = directories.find(separator);
+        auto directory = directories.substr(0, end);
+        if (!directory.empty()) {
+            for (auto& suffix : suffixes) {
+                auto executable = std::filesystem::path(directory) / (ngspicePath + suffix);
+                if (std::filesystem::is_regular_file(executable)) {
+                    return executable;
+                }
+            }
+        }
+        if (end == std::string_view::npos) break;
+        directories.remove_prefix(end + 1);
+    }
+    throw std::runtime_error("ngspice executable not found on PATH: " + ngspicePath + missingExecutableHint);
+}
+
+std::vector<SpiceRunResult> run_ngspice_batch(const std::vector<std::string>& decks, int threads,
+                                              const std::filesystem::path& executable, bool keepFiles) {
+    static std::atomic<size_t> batchCounter{0};
+#ifdef _WIN32
+    const auto processId = _getpid();
+#else
+    const auto processId = getpid();
+#endif
+    auto scratch = std::filesystem::temp_directory_path() /
+                   ("pyom_ngspice_" + std::to_string(processId) + "_" + std::to_string(batchCounter++));
+    std::filesystem::create_directories(scratch);
+
+    std::vector<SpiceRunResult> results(decks.size());
+    parallel_for(decks.size(), resolve_thread_count(threads, decks.size()), [&](size_t index) {
+        auto& result = results[index];
+        auto stem = scratch / ("deck_" + std::to_string(index));
+        auto deckPath = stem; deckPath += ".cir";
+        auto rawPath = stem; rawPath += ".raw";
+        auto logPath = stem; logPath += ".log";
+        try {
+            {
+                std::ofstream out(deckPath, std::ios::binary | std::ios::trunc);
+                out << decks[index];
+                if (decks[index].empty() || decks[index].back() != '\n') out << '\n';
+            }
+            int exitCode = run_process({executable.string(), "-b", "-r", rawPath.string(), "-o", logPath.string(), deckPath.string()});
+            if (exitCode != 0 || !std::filesystem::exists(rawPath)) {
+                result.log = read_text_file(logPath);
+                result.error = "ngspice exited with status " + std::to_string(exitCode) +
+                               (std::filesystem::exists(rawPath) ? "" : " and wrote no rawfile");
+                return;
+            }
+            MappedFile raw(rawPath);
+            result.plots = parse_ngspice_rawfile(raw.view());
+            result.ok = true;
+        }
+        catch (const std::exception& exc) {
+            result.error = exc.what();
+            result.log = read_text_file(logPath);
+        }
+    });
+
+    if (!keepFiles) {
+        std::error_code ignored;
+        std::filesystem::remove_all(scratch, ignored);
+    }
+    return results;
+}
+
+} // namespace PyMKF
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace PyMKF {
+
+// ─── Batch ngspice runner ───────────────────────────────────────────────────
+// ngspice is not reentrant: the shared library keeps one circuit and one set
+// of plots per process, so process_converter(..., use_ngspice=True) and the
+// NgspiceRunner paths are serialised on the state lock. For sweeps over
+// hundreds of decks (from generate_ngspice_circuit) run_ngspice_batch runs
+// each deck in its own `ngspice -b` process instead, up to `threads` of them
+// at a time, and reads the binary rawfile each one writes back with no text
+// round trip. The executable is resolved once per batch. It is an external
+// dependency: the wheel bundles only the shared library, so
+// resolve_ngspice_executable throws a runtime_error saying so when ngspice is
+// not installed.
+//
+// This file has no MKF or pybind11 dependency; the binding
+// (run_ngspice_batch) is registered with the converter bindings.
+
+struct SpicePlot {
+    std::string title;
+    std::string plotName;
+    bool complex = false;
+    std::vector<std::string> names;
+    // values[variable] holds the samples of one vector; complex plots store
+    // interleaved (real, imaginary) pairs.
+    std::vector<std::vector<double>> values;
+};
+
+// Parses every plot of an ngspice rawfile, binary or ASCII. Throws
+// std::runtime_error on a malformed or truncated file.
+std::vector<SpicePlot> parse_ngspice_rawfile(std::string_view contents);
+
+struct SpiceRunResult {
+    bool ok = false;
+    std::string error;
+    std::string log;
+    std::vector<SpicePlot> plots;
+};
+
+// Finds `ngspicePath` on PATH unless it already names a file. Throws
+// std::runtime_error when it cannot be found.
+std::filesystem::path resolve_ngspice_executable(const std::string& ngspicePath);
+
+// Runs every deck in its own ngspice process, at most `threads` at a time
+// (<= 0: one per hardware thread). Results are in deck order; a failing deck
+// only fails its own entry. Scratch files live in one temporary directory
+// that is removed afterwards unless `keepFiles` is set.
+std::vector<SpiceRunResult> run_ngspice_batch(const std::vector<std::string>& decks, int threads,
+                                              const std::filesystem::path& executable, bool keepFiles);
+
+} // namespace PyMKF
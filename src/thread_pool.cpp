@@ -0,0 +1,110 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace PyMKF {
+
+namespace {
+
+struct WorkQueue {
+    std::mutex mutex;
+    std::deque<size_t> items;
+
+    std::optional<size_t> pop_back() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) {
+            return std::nullopt;
+        }
+        size_t item = items.back();
+        items.pop_back();
+        return item;
+    }
+
+    std::optional<size_t> steal_front() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) {
+            return std::nullopt;
+        }
+        size_t item = items.front();
+        items.pop_front();
+        return item;
+    }
+};
+
+} // namespace
+
+size_t resolve_thread_count(int requestedThreads, size_t count) {
+    size_t numberThreads = requestedThreads > 0
+        ? static_cast<size_t>(requestedThreads)
+        : std::max(1u, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, std::min(numberThreads, count));
+}
+
+void parallel_for(size_t count, size_t numberThreads, const std::function<void(size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    numberThreads = std::max<size_t>(1, std::min(numberThreads, count));
+    if (numberThreads == 1) {
+        for (size_t index = 0; index < count; ++index) {
+            body(index);
+        }
+        return;
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    for (size_t workerIndex = 0; workerIndex < numberThreads; ++workerIndex) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    // Deal in reverse so each worker's pop_back() starts with its lowest
+    // index; steals then take the highest remaining ones.
+    for (size_t index = count; index-- > 0;) {
+        queues[index % numberThreads]->items.push_back(index);
+    }
+
+    std::mutex errorMutex;
+    std::exception_ptr firstError;
+
+    auto worker = [&](size_t workerIndex) {
+        while (true) {
+            auto item = queues[workerIndex]->pop_back();
+            for (size_t offset = 1; !item && offset < numberThreads; ++offset) {
+                item = queues[(workerIndex + offset) % numberThreads]->steal_front();
+            }
+            if (!item) {
+                return;
+            }
+            try {
+                body(*item);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t workerIndex = 1; workerIndex < numberThreads; ++workerIndex) {
+        workers.emplace_back(worker, workerIndex);
+    }
+    worker(0);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+
+    if (firstError) {
+        std::rethrow_exception(firstError);
+    }
+}
+
+} // namespace PyMKF
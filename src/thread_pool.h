@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace PyMKF {
+
+// ─── Native worker pool ─────────────────────────────────────────────────────
+// Batch entry points (sweeps, plot_batch, Steinmetz refits, snapshot and
+// NDJSON decoding, the conversion of adviser results to dicts) fan independent
+// items out over native threads with the GIL released. The adviser searches
+// themselves stay serial: they work on MKF's global settings and databases.
+// Items are pre-dealt round-robin into one deque per worker; a worker pops
+// from the back of its own deque and, once empty, steals from the front of the
+// others, so a few slow items (a litz plot, a dense sweep point) do not leave
+// the remaining workers idle behind them.
+//
+// `body(index)` is called exactly once for every index in [0, count). The
+// first exception thrown by any body is rethrown on the calling thread after
+// all workers have joined; the remaining items still run.
+
+// Resolve a user-facing `threads` argument: <= 0 means "one per hardware
+// thread", and the result is never larger than `count` nor smaller than 1.
+size_t resolve_thread_count(int requestedThreads, size_t count);
+
+void parallel_for(size_t count, size_t numberThreads, const std::function<void(size_t)>& body);
+
+} // namespace PyMKF
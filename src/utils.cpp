@@ -1,4 +1,11 @@
 #include "utils.h"
+#include "concurrency.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
 
 namespace PyMKF {
 
@@ -16,12 +23,137 @@ json calculate_basic_processed_data(json waveformJson) {
     return result;
 }
 
-json calculate_harmonics(json waveformJson, double frequency) {
+// One period of `waveform`, linearly interpolated at `numberSamples` equally
+// spaced instants from its first time.
+static Waveform sample_period(const Waveform& waveform, double frequency, size_t numberSamples) {
+    auto& time = waveform.get_time().value();
+    auto& data = waveform.get_data();
+    double period = 1 / frequency;
+    std::vector<double> sampledTime(numberSamples);
+    std::vector<double> sampledData(numberSamples);
+    size_t segment = 0;
+    for (size_t index = 0; index < numberSamples; ++index) {
+        double instant = time.front() + period * static_cast<double>(index) / static_cast<double>(numberSamples);
+        while (segment + 2 < time.size() && time[segment + 1] <= instant) {
+            ++segment;
+        }
+        double span = time[segment + 1] - time[segment];
+        double fraction = span > 0 ? std::clamp((instant - time[segment]) / span, 0.0, 1.0) : 0.0;
+        sampledTime[index] = instant;
+        sampledData[index] = data[segment] + fraction * (data[segment + 1] - data[segment]);
+    }
+    Waveform sampled;
+    sampled.set_time(sampledTime);
+    sampled.set_data(sampledData);
+    return sampled;
+}
+
+static double ac_energy(const std::vector<double>& amplitudes, size_t from = 1) {
+    double energy = 0;
+    for (size_t index = std::max<size_t>(from, 1); index < amplitudes.size(); ++index) {
+        energy += amplitudes[index] * amplitudes[index];
+    }
+    return energy;
+}
+
+HarmonicTruncation truncate_harmonics(const Harmonics& harmonics, double energyThreshold) {
+    if (!(energyThreshold > 0 && energyThreshold < 1)) {
+        throw std::invalid_argument("harmonic energy threshold must be between 0 and 1, got " + std::to_string(energyThreshold));
+    }
+    auto& amplitudes = harmonics.get_amplitudes();
+    auto& frequencies = harmonics.get_frequencies();
+    HarmonicTruncation truncation;
+    truncation.totalHarmonics = amplitudes.size();
+
+    // Largest AC harmonics first until all but energyThreshold of the AC
+    // energy is kept; DC is always kept.
+    std::vector<size_t> order;
+    for (size_t index = 1; index < amplitudes.size(); ++index) {
+        order.push_back(index);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::abs(amplitudes[a]) > std::abs(amplitudes[b]);
+    });
+    double totalEnergy = ac_energy(amplitudes);
+    double keptEnergy = 0;
+    std::vector<size_t> kept;
+    if (!amplitudes.empty()) {
+        kept.push_back(0);
+    }
+    for (auto index : order) {
+        if (totalEnergy <= 0 || keptEnergy >= (1 - energyThreshold) * totalEnergy) {
+            break;
+        }
+        keptEnergy += amplitudes[index] * amplitudes[index];
+        kept.push_back(index);
+    }
+    std::sort(kept.begin(), kept.end());
+
+    std::vector<double> keptAmplitudes;
+    std::vector<double> keptFrequencies;
+    for (auto index : kept) {
+        keptAmplitudes.push_back(amplitudes[index]);
+        keptFrequencies.push_back(frequencies[index]);
+    }
+    truncation.harmonics.set_amplitudes(keptAmplitudes);
+    truncation.harmonics.set_frequencies(keptFrequencies);
+    truncation.truncationError = totalEnergy > 0 ? std::sqrt(std::max(totalEnergy - keptEnergy, 0.0) / totalEnergy) : 0;
+    return truncation;
+}
+
+HarmonicTruncation adaptive_harmonics(const Waveform& waveform, double frequency, double energyThreshold) {
+    // The sample ceiling is a setting; keep a concurrent set_settings out.
+    StateReadLock stateLock;
+    size_t maximumSamples = OpenMagnetics::settings.get_inputs_number_points_sampled_waveforms();
+    if (!waveform.get_time() || waveform.get_time()->size() < 2) {
+        // Equidistant data: keep MKF's sampling, only truncate.
+        auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
+        auto truncation = truncate_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency), energyThreshold);
+        truncation.numberSamples = sampledWaveform.get_data().size();
+        return truncation;
+    }
+
+    // Double the samples until the upper half of the resolved band holds no
+    // more than energyThreshold of the AC energy, so that what is cut off or
+    // aliased is below the truncation itself.
+    size_t numberSamples = std::min<size_t>(minimumAdaptiveSamples, std::max<size_t>(maximumSamples, 2));
+    Harmonics harmonics;
+    while (true) {
+        harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(sample_period(waveform, frequency, numberSamples), frequency);
+        auto& amplitudes = harmonics.get_amplitudes();
+        double totalEnergy = ac_energy(amplitudes);
+        double tailEnergy = ac_energy(amplitudes, amplitudes.size() / 2);
+        if (numberSamples * 2 > maximumSamples || tailEnergy <= energyThreshold * totalEnergy) {
+            break;
+        }
+        numberSamples *= 2;
+    }
+    auto truncation = truncate_harmonics(harmonics, energyThreshold);
+    truncation.numberSamples = numberSamples;
+    return truncation;
+}
+
+json harmonic_truncation_report(const HarmonicTruncation& truncation) {
+    json report;
+    report["numberSamples"] = truncation.numberSamples;
+    report["totalHarmonics"] = truncation.totalHarmonics;
+    report["retainedHarmonics"] = truncation.harmonics.get_amplitudes().size();
+    report["truncationError"] = truncation.truncationError;
+    return report;
+}
+
+json calculate_harmonics(json waveformJson, double frequency, std::optional<double> energyThreshold) {
     try {
         Waveform waveform(waveformJson);
+        json result;
+        if (energyThreshold) {
+            auto truncation = adaptive_harmonics(waveform, frequency, energyThreshold.value());
+            to_json(result, truncation.harmonics);
+            result.update(harmonic_truncation_report(truncation));
+            return result;
+        }
         auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
         auto harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency);
-        json result;
         to_json(result, harmonics);
         return result;
     }
@@ -63,6 +195,107 @@ json calculate_processed_data(json signalDescriptorJson, json sampledWaveformJso
     }
 }
 
+Waveform waveform_from_numpy(const NumpyArray& time, const NumpyArray& data) {
+    if (time.ndim() != 1 || data.ndim() != 1) {
+        throw std::invalid_argument("time and data must be one-dimensional arrays");
+    }
+    if (time.size() != data.size()) {
+        throw std::invalid_argument("time and data must have the same length, got " +
+                                    std::to_string(time.size()) + " and " + std::to_string(data.size()));
+    }
+    if (data.size() < 2) {
+        throw std::invalid_argument("waveform needs at least two samples");
+    }
+    // One memcpy per buffer: MKF's Waveform owns std::vectors.
+    Waveform waveform;
+    waveform.set_time(std::vector<double>(time.data(), time.data() + time.size()));
+    waveform.set_data(std::vector<double>(data.data(), data.data() + data.size()));
+    return waveform;
+}
+
+SignalDescriptor signal_descriptor_from_waveform(Waveform waveform, double frequency) {
+    SignalDescriptor signalDescriptor;
+    signalDescriptor.set_waveform(waveform);
+    auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
+    signalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency));
+    signalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(signalDescriptor, sampledWaveform, true));
+    return signalDescriptor;
+}
+
+py::array_t<double> vector_to_numpy(std::vector<double>&& values) {
+    // Hand the vector's buffer to NumPy; the capsule frees it with the array.
+    auto* owned = new std::vector<double>(std::move(values));
+    py::capsule owner(owned, [](void* pointer) { delete static_cast<std::vector<double>*>(pointer); });
+    return py::array_t<double>(owned->size(), owned->data(), owner);
+}
+
+py::dict calculate_harmonics_numpy(NumpyArray time, NumpyArray data, double frequency) {
+    auto waveform = waveform_from_numpy(time, data);
+    std::vector<double> amplitudes;
+    std::vector<double> frequencies;
+    {
+        py::gil_scoped_release release;
+        StateReadLock stateLock;
+        auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
+        auto harmonics = OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency);
+        amplitudes = harmonics.get_amplitudes();
+        frequencies = harmonics.get_frequencies();
+    }
+    py::dict result;
+    result["amplitudes"] = vector_to_numpy(std::move(amplitudes));
+    result["frequencies"] = vector_to_numpy(std::move(frequencies));
+    return result;
+}
+
+py::tuple calculate_sampled_waveform_numpy(NumpyArray time, NumpyArray data, double frequency) {
+    auto waveform = waveform_from_numpy(time, data);
+    std::vector<double> sampledTime;
+    std::vector<double> sampledData;
+    {
+        py::gil_scoped_release release;
+        StateReadLock stateLock;
+        auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
+        sampledData = sampledWaveform.get_data();
+        if (sampledWaveform.get_time()) {
+            sampledTime = sampledWaveform.get_time().value();
+        }
+    }
+    return py::make_tuple(vector_to_numpy(std::move(sampledTime)), vector_to_numpy(std::move(sampledData)));
+}
+
+json calculate_processed_data_numpy(NumpyArray time, NumpyArray data, double frequency, bool includeDcComponent) {
+    auto waveform = waveform_from_numpy(time, data);
+    py::gil_scoped_release release;
+    StateReadLock stateLock;
+    SignalDescriptor signalDescriptor;
+    signalDescriptor.set_waveform(waveform);
+    auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(waveform, frequency);
+    signalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency));
+    auto processed = OpenMagnetics::Inputs::calculate_processed_data(signalDescriptor, sampledWaveform, includeDcComponent);
+    json result;
+    to_json(result, processed);
+    return result;
+}
+
+std::function<bool(const std::string&)> parse_output_selection(const json& outputsJson, const std::vector<std::string>& available) {
+    if (outputsJson.is_null()) {
+        return [](const std::string&) { return true; };
+    }
+    std::set<std::string> selected;
+    for (auto& output : outputsJson) {
+        auto name = output.get<std::string>();
+        if (std::find(available.begin(), available.end(), name) == available.end()) {
+            std::string names;
+            for (auto& availableName : available) {
+                names += (names.empty() ? "" : ", ") + availableName;
+            }
+            throw std::invalid_argument("Unknown output: " + name + " (available: " + names + ")");
+        }
+        selected.insert(name);
+    }
+    return [selected = std::move(selected)](const std::string& name) { return selected.contains(name); };
+}
+
 double calculate_instantaneous_power(json excitationJson) {
     OperatingPointExcitation excitation(excitationJson);
 
@@ -105,70 +338,173 @@ double calculate_rms_power(json excitationJson) {
     return rmsPower;
 }
 
-json calculate_reflected_secondary(json primaryExcitationJson, double turnRatio) {
-    OperatingPointExcitation primaryExcitation(primaryExcitationJson);
+// Sampled waveform, harmonics and processed data of a signal from its
+// waveform, each computed once.
+static void complete_signal(SignalDescriptor& signal, double frequency) {
+    auto sampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(signal.get_waveform().value(), frequency);
+    signal.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(sampledWaveform, frequency));
+    signal.set_processed(OpenMagnetics::Inputs::calculate_processed_data(signal, sampledWaveform, true));
+}
 
-    OperatingPointExcitation excitationOfThisWinding(primaryExcitation);
-    auto voltageSignalDescriptor = OpenMagnetics::Inputs::reflect_waveform(primaryExcitation.get_voltage().value(), 1.0 / turnRatio);
-    
-    auto voltageSignalDescriptorProcessed = voltageSignalDescriptor.get_processed();
-    if (!voltageSignalDescriptorProcessed) {
-        auto voltageSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(voltageSignalDescriptor.get_waveform().value(), excitationOfThisWinding.get_frequency());
-        voltageSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(voltageSampledWaveform, excitationOfThisWinding.get_frequency()));
-        voltageSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(voltageSignalDescriptor, voltageSampledWaveform, true));
+std::vector<ExcitationStep> parse_excitation_steps(const json& stepsJson) {
+    static const std::map<std::string, std::pair<ExcitationStep::Kind, std::string>> kinds = {
+        {"reflectToSecondary", {ExcitationStep::Kind::REFLECT_TO_SECONDARY, "turnRatio"}},
+        {"reflectToPrimary", {ExcitationStep::Kind::REFLECT_TO_PRIMARY, "turnRatio"}},
+        {"scaleToFrequency", {ExcitationStep::Kind::SCALE_TO_FREQUENCY, "frequency"}},
+        {"inducedVoltage", {ExcitationStep::Kind::INDUCED_VOLTAGE, "magnetizingInductance"}},
+        {"inducedCurrent", {ExcitationStep::Kind::INDUCED_CURRENT, "magnetizingInductance"}},
+    };
+    std::vector<ExcitationStep> steps;
+    for (auto& stepJson : stepsJson) {
+        std::string operation = stepJson.at("operation");
+        auto kind = kinds.find(operation);
+        if (kind == kinds.end()) {
+            throw std::invalid_argument("Unknown excitation operation: " + operation);
+        }
+        steps.push_back({kind->second.first, stepJson.at(kind->second.second).get<double>()});
     }
+    return steps;
+}
 
-    auto currentSignalDescriptorProcessed = primaryExcitation.get_current().value().get_processed();
-    if (!currentSignalDescriptorProcessed) {
-        auto currentSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(primaryExcitation.get_current().value().get_waveform().value(), excitationOfThisWinding.get_frequency());
-        auto currentSignalDescriptor = primaryExcitation.get_current().value();
-        currentSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(currentSampledWaveform, excitationOfThisWinding.get_frequency()));
-        currentSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(currentSignalDescriptor, currentSampledWaveform, true));
-        primaryExcitation.set_current(currentSignalDescriptor);
-        currentSignalDescriptorProcessed = currentSignalDescriptor.get_processed();
+void apply_excitation_steps(OperatingPointExcitation& excitation, const std::vector<ExcitationStep>& steps) {
+    // Steps only transform waveforms; a signal is marked stale and its
+    // harmonics and processed data are recomputed once, after the last step,
+    // or before a step that reads them.
+    bool voltageStale = false;
+    bool currentStale = false;
+    std::optional<double> currentDutyCycle;
+    auto complete = [&](bool& stale, bool isVoltage) {
+        if (!stale) {
+            return;
+        }
+        auto signal = isVoltage ? excitation.get_voltage().value() : excitation.get_current().value();
+        complete_signal(signal, excitation.get_frequency());
+        if (!isVoltage && currentDutyCycle) {
+            auto processed = signal.get_processed().value();
+            processed.set_duty_cycle(currentDutyCycle.value());
+            signal.set_processed(processed);
+        }
+        if (isVoltage) {
+            excitation.set_voltage(std::move(signal));
+        }
+        else {
+            excitation.set_current(std::move(signal));
+        }
+        stale = false;
+    };
+
+    for (auto& step : steps) {
+        switch (step.kind) {
+            case ExcitationStep::Kind::REFLECT_TO_SECONDARY:
+            case ExcitationStep::Kind::REFLECT_TO_PRIMARY: {
+                bool toSecondary = step.kind == ExcitationStep::Kind::REFLECT_TO_SECONDARY;
+                double voltageRatio = toSecondary ? 1.0 / step.value : step.value;
+                if (excitation.get_voltage()) {
+                    excitation.set_voltage(OpenMagnetics::Inputs::reflect_waveform(excitation.get_voltage().value(), voltageRatio));
+                    voltageStale = true;
+                }
+                if (excitation.get_current()) {
+                    if (toSecondary) {
+                        // The reflection keeps the shape named by the label.
+                        if (!excitation.get_current()->get_processed()) {
+                            currentStale = true;
+                        }
+                        complete(currentStale, false);
+                        auto label = excitation.get_current()->get_processed()->get_label();
+                        excitation.set_current(OpenMagnetics::Inputs::reflect_waveform(excitation.get_current().value(), step.value, label));
+                    }
+                    else {
+                        excitation.set_current(OpenMagnetics::Inputs::reflect_waveform(excitation.get_current().value(), 1.0 / step.value));
+                    }
+                    currentStale = true;
+                }
+                break;
+            }
+            case ExcitationStep::Kind::SCALE_TO_FREQUENCY:
+                OpenMagnetics::Inputs::scale_time_to_frequency(excitation, step.value, false, false);
+                voltageStale = excitation.get_voltage().has_value();
+                currentStale = excitation.get_current().has_value();
+                break;
+            case ExcitationStep::Kind::INDUCED_VOLTAGE:
+                complete(currentStale, false);
+                excitation.set_voltage(OpenMagnetics::Inputs::calculate_induced_voltage(excitation, step.value));
+                voltageStale = true;
+                break;
+            case ExcitationStep::Kind::INDUCED_CURRENT: {
+                complete(voltageStale, true);
+                auto current = OpenMagnetics::Inputs::calculate_magnetizing_current(excitation, step.value, true, 0.0);
+                currentDutyCycle.reset();
+                if (excitation.get_voltage() && excitation.get_voltage()->get_processed() && excitation.get_voltage()->get_processed()->get_duty_cycle()) {
+                    currentDutyCycle = excitation.get_voltage()->get_processed()->get_duty_cycle().value();
+                }
+                excitation.set_current(std::move(current));
+                currentStale = true;
+                break;
+            }
+        }
     }
+    complete(voltageStale, true);
+    complete(currentStale, false);
+}
 
-    auto currentSignalDescriptor = OpenMagnetics::Inputs::reflect_waveform(primaryExcitation.get_current().value(), turnRatio, currentSignalDescriptorProcessed.value().get_label());
-
-    auto voltageSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(voltageSignalDescriptor.get_waveform().value(), excitationOfThisWinding.get_frequency());
-    voltageSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(voltageSampledWaveform, excitationOfThisWinding.get_frequency()));
-    voltageSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(voltageSignalDescriptor, voltageSampledWaveform, true));
-
-    auto currentSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(currentSignalDescriptor.get_waveform().value(), excitationOfThisWinding.get_frequency());
-    currentSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(currentSampledWaveform, excitationOfThisWinding.get_frequency()));
-    currentSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(currentSignalDescriptor, currentSampledWaveform, true));
-
-    excitationOfThisWinding.set_voltage(voltageSignalDescriptor);
-    excitationOfThisWinding.set_current(currentSignalDescriptor);
-
+json calculate_reflected_secondary(json primaryExcitationJson, double turnRatio) {
+    OperatingPointExcitation excitation(primaryExcitationJson);
+    apply_excitation_steps(excitation, {{ExcitationStep::Kind::REFLECT_TO_SECONDARY, turnRatio}});
     json result;
-    to_json(result, excitationOfThisWinding);
+    to_json(result, excitation);
     return result;
 }
 
 json calculate_reflected_primary(json secondaryExcitationJson, double turnRatio) {
-    OperatingPointExcitation secondaryExcitation(secondaryExcitationJson);
-
-    OperatingPointExcitation excitationOfThisWinding(secondaryExcitation);
-    auto voltageSignalDescriptor = OpenMagnetics::Inputs::reflect_waveform(secondaryExcitation.get_voltage().value(), turnRatio);
-    auto currentSignalDescriptor = OpenMagnetics::Inputs::reflect_waveform(secondaryExcitation.get_current().value(), 1.0 / turnRatio);
-
-    auto voltageSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(voltageSignalDescriptor.get_waveform().value(), excitationOfThisWinding.get_frequency());
-    voltageSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(voltageSampledWaveform, excitationOfThisWinding.get_frequency()));
-    voltageSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(voltageSignalDescriptor, voltageSampledWaveform, true));
-
-    auto currentSampledWaveform = OpenMagnetics::Inputs::calculate_sampled_waveform(currentSignalDescriptor.get_waveform().value(), excitationOfThisWinding.get_frequency());
-    currentSignalDescriptor.set_harmonics(OpenMagnetics::Inputs::calculate_harmonics_data(currentSampledWaveform, excitationOfThisWinding.get_frequency()));
-    currentSignalDescriptor.set_processed(OpenMagnetics::Inputs::calculate_processed_data(currentSignalDescriptor, currentSampledWaveform, true));
-
-    excitationOfThisWinding.set_voltage(voltageSignalDescriptor);
-    excitationOfThisWinding.set_current(currentSignalDescriptor);
-
+    OperatingPointExcitation excitation(secondaryExcitationJson);
+    apply_excitation_steps(excitation, {{ExcitationStep::Kind::REFLECT_TO_PRIMARY, turnRatio}});
     json result;
-    to_json(result, excitationOfThisWinding);
+    to_json(result, excitation);
     return result;
 }
 
+py::list transform_excitations(py::list excitations, json stepsJson, int threads) {
+    size_t count = excitations.size();
+    // One list of steps for all excitations, or one list per excitation.
+    bool perExcitation = stepsJson.is_array() && !stepsJson.empty() && stepsJson[0].is_array();
+    if (perExcitation && stepsJson.size() != count) {
+        throw std::invalid_argument("steps has " + std::to_string(stepsJson.size()) + " lists for " + std::to_string(count) + " excitations");
+    }
+    std::vector<std::vector<ExcitationStep>> steps;
+    if (perExcitation) {
+        for (auto& excitationSteps : stepsJson) {
+            steps.push_back(parse_excitation_steps(excitationSteps));
+        }
+    }
+    else {
+        steps.push_back(parse_excitation_steps(stepsJson));
+    }
+
+    std::vector<json> buffer(count);
+    for (size_t index = 0; index < count; ++index) {
+        buffer[index] = excitations[index].cast<json>();
+    }
+    {
+        py::gil_scoped_release release;
+        StateReadLock stateLock;
+        parallel_for(count, resolve_thread_count(threads, count), [&](size_t index) {
+            try {
+                OperatingPointExcitation excitation(buffer[index]);
+                apply_excitation_steps(excitation, steps[perExcitation ? index : 0]);
+                buffer[index] = json();
+                to_json(buffer[index], excitation);
+            }
+            catch (const std::exception &exc) {
+                buffer[index] = json{{"data", "Exception: " + std::string{exc.what()}}};
+            }
+        });
+    }
+    for (size_t index = 0; index < count; ++index) {
+        excitations[index] = py::cast(std::move(buffer[index]));
+    }
+    return excitations;
+}
+
 py::list list_of_list_to_python_list(std::vector<std::vector<double>> arrayOfArrays) {
     py::list outerList;
     for (const auto& innerArray : arrayOfArrays) {
@@ -380,14 +716,52 @@ void register_utils_bindings(py::module& m) {
         Calculate harmonic content of a waveform.
         
         Performs FFT analysis to extract harmonic amplitudes and phases.
+
+        With energy_threshold, the sample count and the harmonics are chosen
+        per waveform: samples are doubled from 32 up to
+        inputsNumberPointsSampledWaveforms until the upper half of the band
+        holds at most that fraction of the AC energy, then the smallest
+        harmonics are dropped while the dropped energy stays within it. The
+        amplitudes and frequencies then list the retained harmonics only.
         
         Args:
             waveform_json: JSON object with waveform data.
             frequency: Fundamental frequency in Hz.
+            energy_threshold: Optional fraction of AC energy that may be
+                dropped, e.g. 1e-4. None keeps every harmonic.
         
         Returns:
-            JSON object with harmonic amplitudes and frequencies.
-        )pbdoc");
+            JSON object with harmonic amplitudes and frequencies. With
+            energy_threshold, also numberSamples, totalHarmonics,
+            retainedHarmonics and truncationError (RMS of the dropped
+            harmonics over the AC RMS).
+
+        Example:
+            >>> harmonics = PyMKF.calculate_harmonics(waveform, 100e3, energy_threshold=1e-4)
+            >>> harmonics["retainedHarmonics"], harmonics["truncationError"]
+        )pbdoc",
+        py::arg("waveform_json"), py::arg("frequency"), py::arg("energy_threshold") = py::none());
+
+    m.def("calculate_harmonics", &calculate_harmonics_numpy,
+        R"pbdoc(
+        Calculate harmonic content of a sampled waveform given as NumPy arrays.
+
+        Same result as the JSON overload, without converting the samples to
+        and from JSON. Use it for long captured waveforms.
+
+        Args:
+            time: 1-D float64 array of sample times in seconds.
+            data: 1-D float64 array of sample values, same length as time.
+            frequency: Fundamental frequency in Hz.
+
+        Returns:
+            Dict with "amplitudes" and "frequencies" as NumPy arrays.
+
+        Example:
+            >>> harmonics = PyMKF.calculate_harmonics(t, i, 100e3)
+            >>> harmonics["amplitudes"][1]
+        )pbdoc",
+        py::arg("time"), py::arg("data"), py::arg("frequency"));
     
     m.def("calculate_sampled_waveform", &calculate_sampled_waveform,
         R"pbdoc(
@@ -402,6 +776,20 @@ void register_utils_bindings(py::module& m) {
         Returns:
             JSON object with uniformly sampled waveform.
         )pbdoc");
+
+    m.def("calculate_sampled_waveform", &calculate_sampled_waveform_numpy,
+        R"pbdoc(
+        Resample a waveform given as NumPy arrays at regular intervals.
+
+        Args:
+            time: 1-D float64 array of sample times in seconds.
+            data: 1-D float64 array of sample values, same length as time.
+            frequency: Frequency for determining sample period.
+
+        Returns:
+            Tuple (time, data) of NumPy arrays with the uniform samples.
+        )pbdoc",
+        py::arg("time"), py::arg("data"), py::arg("frequency"));
     
     m.def("calculate_processed_data", &calculate_processed_data,
         R"pbdoc(
@@ -418,6 +806,24 @@ void register_utils_bindings(py::module& m) {
             JSON object with complete processed data.
         )pbdoc",
         py::arg("signalDescriptorJson"), py::arg("sampledWaveformJson"), py::arg("includeDcComponent"));
+
+    m.def("calculate_processed_data", &calculate_processed_data_numpy,
+        R"pbdoc(
+        Calculate processed data for a waveform given as NumPy arrays.
+
+        Resamples the waveform and computes its harmonics internally, then
+        returns the same processed data as the JSON overload.
+
+        Args:
+            time: 1-D float64 array of sample times in seconds.
+            data: 1-D float64 array of sample values, same length as time.
+            frequency: Fundamental frequency in Hz.
+            include_dc_component: Whether to include DC in calculations.
+
+        Returns:
+            JSON object with complete processed data.
+        )pbdoc",
+        py::arg("time"), py::arg("data"), py::arg("frequency"), py::arg("include_dc_component"));
     
     m.def("calculate_instantaneous_power", &calculate_instantaneous_power,
         R"pbdoc(
@@ -479,6 +885,41 @@ void register_utils_bindings(py::module& m) {
             JSON object with primary excitation.
         )pbdoc");
 
+    m.def("transform_excitations", &transform_excitations,
+        R"pbdoc(
+        Apply a chain of reflections, rescalings and inductive conversions to
+        many excitations, in place.
+
+        Each step only transforms the waveforms; harmonics and processed data
+        are recomputed once per signal after the last step (or before a step
+        that reads them), instead of after every single-step helper call.
+        Excitations are processed on worker threads with the GIL released,
+        and every entry of `excitations` is replaced with its result.
+
+        Args:
+            excitations: List of OperatingPointExcitation dicts; overwritten.
+            steps: List of steps applied to every excitation, or one such list
+                per excitation. Each step is one of:
+                - {"operation": "reflectToSecondary", "turnRatio": n}
+                - {"operation": "reflectToPrimary", "turnRatio": n}
+                - {"operation": "scaleToFrequency", "frequency": f}
+                - {"operation": "inducedVoltage", "magnetizingInductance": L}
+                - {"operation": "inducedCurrent", "magnetizingInductance": L}
+                The reflections and induced signals match
+                calculate_reflected_secondary, calculate_reflected_primary,
+                calculate_induced_voltage and calculate_induced_current.
+            threads: Worker threads; 0 or less uses all hardware threads.
+
+        Returns:
+            The same list. An entry that failed holds {"data": "Exception: ..."}.
+
+        Example:
+            >>> secondaries = [primary] * 3
+            >>> PyMKF.transform_excitations(secondaries, [
+            ...     [{"operation": "reflectToSecondary", "turnRatio": n}] for n in (4, 8, 12)])
+        )pbdoc",
+        py::arg("excitations"), py::arg("steps"), py::arg("threads") = 0);
+
     m.def("standardize_signal_descriptor", &standardize_signal_descriptor,
         R"pbdoc(
         Standardize a signal descriptor by computing waveform, harmonics, and processed data.
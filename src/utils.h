@@ -1,15 +1,55 @@
 #pragma once
 #include "common.h"
+#include <pybind11/numpy.h>
+#include <functional>
 
 namespace PyMKF {
 
 // Utility functions for processing and calculations
 double resolve_dimension_with_tolerance(json dimensionWithToleranceJson, std::string preferredValue = "Nominal");
 json calculate_basic_processed_data(json waveformJson);
-json calculate_harmonics(json waveformJson, double frequency);
+json calculate_harmonics(json waveformJson, double frequency, std::optional<double> energyThreshold = std::nullopt);
 json calculate_sampled_waveform(json waveformJson, double frequency);
 json calculate_processed_data(json signalDescriptorJson, json sampledWaveformJson, bool includeDcComponent);
 
+// ─── Adaptive harmonics ─────────────────────────────────────────────────────
+// A fixed inputsNumberPointsSampledWaveforms gives smooth waveforms hundreds
+// of harmonics that carry no energy, and every loss model loops over all of
+// them. The adaptive mode keeps, per waveform, the fewest harmonics holding
+// all but `energyThreshold` of the AC energy, sampled no finer than needed.
+// Harmonics keeps parallel amplitude / frequency vectors, so the retained set
+// is stored sparsely and downstream models iterate only it.
+constexpr size_t minimumAdaptiveSamples = 32;
+
+struct HarmonicTruncation {
+    Harmonics harmonics;          // retained harmonics only, DC first
+    size_t numberSamples = 0;     // samples per period the spectrum came from
+    size_t totalHarmonics = 0;    // harmonics before truncation
+    double truncationError = 0;   // RMS of the dropped harmonics / AC RMS
+};
+
+// Throw std::invalid_argument unless 0 < energyThreshold < 1.
+HarmonicTruncation truncate_harmonics(const Harmonics& harmonics, double energyThreshold);
+HarmonicTruncation adaptive_harmonics(const Waveform& waveform, double frequency, double energyThreshold);
+// {"numberSamples", "totalHarmonics", "retainedHarmonics", "truncationError"}
+json harmonic_truncation_report(const HarmonicTruncation& truncation);
+
+// NumPy waveform path: same computations as the json overloads above, but the
+// samples cross the boundary as contiguous float64 buffers instead of being
+// walked element by element through Python lists and nlohmann::json.
+using NumpyArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+Waveform waveform_from_numpy(const NumpyArray& time, const NumpyArray& data);
+SignalDescriptor signal_descriptor_from_waveform(Waveform waveform, double frequency);
+py::array_t<double> vector_to_numpy(std::vector<double>&& values);
+py::dict calculate_harmonics_numpy(NumpyArray time, NumpyArray data, double frequency);
+py::tuple calculate_sampled_waveform_numpy(NumpyArray time, NumpyArray data, double frequency);
+json calculate_processed_data_numpy(NumpyArray time, NumpyArray data, double frequency, bool includeDcComponent);
+
+// outputs=[...] selectors: returns a predicate that is true for every name
+// when outputsJson is null, and for the listed names otherwise. Throws
+// std::invalid_argument on a name that is not in `available`.
+std::function<bool(const std::string&)> parse_output_selection(const json& outputsJson, const std::vector<std::string>& available);
+
 // Power calculation utilities  
 double calculate_instantaneous_power(json excitationJson);
 double calculate_rms_power(json excitationJson);
@@ -18,6 +58,30 @@ double calculate_rms_power(json excitationJson);
 json calculate_reflected_secondary(json primaryExcitationJson, double turnRatio);
 json calculate_reflected_primary(json secondaryExcitationJson, double turnRatio);
 
+// ─── Excitation transforms ──────────────────────────────────────────────────
+// The reflection / rescaling / induced-signal helpers chained on one
+// excitation. Every step works on the waveforms only; harmonics and processed
+// data are recomputed once per signal at the end, or before a step that
+// reads them, rather than after each step.
+struct ExcitationStep {
+    enum class Kind {
+        REFLECT_TO_SECONDARY,
+        REFLECT_TO_PRIMARY,
+        SCALE_TO_FREQUENCY,
+        INDUCED_VOLTAGE,
+        INDUCED_CURRENT,
+    };
+    Kind kind;
+    double value;  // turn ratio, frequency or magnetizing inductance
+};
+
+// Throws std::invalid_argument on an unknown operation.
+std::vector<ExcitationStep> parse_excitation_steps(const json& stepsJson);
+void apply_excitation_steps(OperatingPointExcitation& excitation, const std::vector<ExcitationStep>& steps);
+// Transforms every excitation of the list in parallel and writes the results
+// back into it.
+py::list transform_excitations(py::list excitations, json stepsJson, int threads = 0);
+
 // Array conversion utilities
 py::list list_of_list_to_python_list(std::vector<std::vector<double>> arrayOfArrays);
 std::vector<double> python_list_to_vector(py::list pythonList);
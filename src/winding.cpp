@@ -1,8 +1,12 @@
 #include "winding.h"
+#include "concurrency.h"
+#include "name_index.h"
+#include "profiling.h"
 
 namespace PyMKF {
 
 json wind(json coilJson, size_t repetitions, json proportionPerWindingJson, json patternJson, json marginPairsJson) {
+    PYMKF_PROFILE_SCOPE("Coil::wind");
     try {
         std::vector<std::vector<double>> marginPairs;
         for (auto elem : marginPairsJson) {
@@ -141,7 +145,9 @@ json wind(json coilJson, size_t repetitions, json proportionPerWindingJson, json
 }
 
 json wind_planar(json coilJson, json stackUpJson, double borderToWireDistance, json wireToWireDistanceJson, json insulationThicknessJson, double coreToLayerDistance) {
+    PYMKF_PROFILE_SCOPE("Coil::wind");
     try {
+        StateWriteLock stateLock;
         OpenMagnetics::settings.set_coil_wind_even_if_not_fit(true);
         auto coil = OpenMagnetics::Coil(coilJson, false);
         std::vector<size_t> stackUp = stackUpJson;
@@ -163,6 +169,7 @@ json wind_planar(json coilJson, json stackUpJson, double borderToWireDistance, j
 }
 
 json wind_by_sections(json coilJson, size_t repetitions, json proportionPerWindingJson, json patternJson, double insulationThickness) {
+    PYMKF_PROFILE_SCOPE("Coil::wind");
     try {
 
         std::vector<double> proportionPerWinding = proportionPerWindingJson;
@@ -229,6 +236,7 @@ json wind_by_sections(json coilJson, size_t repetitions, json proportionPerWindi
 }
 
 json wind_by_layers(json coilJson, json insulationLayersJson, double insulationThickness) {
+    PYMKF_PROFILE_SCOPE("Coil::wind");
     try {
         std::map<std::pair<size_t, size_t>, std::vector<Layer>> insulationLayers;
 
@@ -292,6 +300,7 @@ json wind_by_layers(json coilJson, json insulationLayersJson, double insulationT
 }
 
 json wind_by_turns(json coilJson) {
+    PYMKF_PROFILE_SCOPE("Coil::wind");
     try {
 
         std::vector<OpenMagnetics::Winding> winding;
@@ -538,10 +547,13 @@ json get_insulation_material_names() {
 
 json find_insulation_material_by_name(json insulationMaterialName) {
     try {
-        auto insulationMaterialData = OpenMagnetics::find_insulation_material_by_name(insulationMaterialName);
-        json result;
-        to_json(result, insulationMaterialData);
-        return result;
+        return find_by_name_indexed(NameIndexDatabase::INSULATION_MATERIALS, insulationMaterialName.dump(), [&] {
+            StateReadLockWithDatabases stateLock;
+            auto insulationMaterialData = OpenMagnetics::find_insulation_material_by_name(insulationMaterialName);
+            json result;
+            to_json(result, insulationMaterialData);
+            return result;
+        });
     }
     catch (const std::exception &exc) {
         json exception;
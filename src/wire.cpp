@@ -1,4 +1,8 @@
 #include "wire.h"
+#include "concurrency.h"
+#include "name_index.h"
+#include "snapshot.h"
+#include "wire_index.h"
 
 namespace PyMKF {
 
@@ -22,12 +26,15 @@ json get_wires() {
 
 json get_wire_names() {
     try {
-        auto wireNames = OpenMagnetics::get_wire_names();
-        json result = json::array();
-        for (auto elem : wireNames) {
-            result.push_back(elem);
-        }
-        return result;
+        return names_indexed(NameList::WIRES, [] {
+            StateReadLockWithDatabases stateLock;
+            auto wireNames = OpenMagnetics::get_wire_names();
+            json result = json::array();
+            for (auto elem : wireNames) {
+                result.push_back(elem);
+            }
+            return result;
+        });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -72,10 +79,18 @@ json get_wire_material_names() {
 
 json find_wire_by_name(json wireName) {
     try {
-        auto wireData = OpenMagnetics::find_wire_by_name(wireName);
-        json result;
-        to_json(result, wireData);
-        return result;
+        if (wireName.is_string()) {
+            if (auto shared = find_in_shared_state(SnapshotSection::WIRES, wireName.get<std::string>())) {
+                return *shared;
+            }
+        }
+        return find_by_name_indexed(NameIndexDatabase::WIRES, wireName.dump(), [&] {
+            StateReadLockWithDatabases stateLock;
+            auto wireData = OpenMagnetics::find_wire_by_name(wireName);
+            json result;
+            to_json(result, wireData);
+            return result;
+        });
     }
     catch (const std::exception &exc) {
         json exception;
@@ -561,6 +576,38 @@ void register_wire_bindings(py::module& m) {
         )pbdoc",
         py::arg("dimension"), py::arg("wire_type_json"), py::arg("wire_standard_json"));
 
+    m.def("query_wire_index", &query_wire_index,
+        R"pbdoc(
+        Search the sorted wire index by size and skin effect.
+
+        The index groups the wire database by type and standard and sorts
+        each group by conducting area, so a query is a binary search. It is
+        built on first use and rebuilt after the wire database is loaded or
+        cleared; queries on a built index run concurrently. It is a lookup
+        of its own: calculate_advised_wires, find_wire_by_dimension and
+        get_equivalent_wire run inside MKF and still walk the database.
+
+        Args:
+            query_json: JSON object, every key optional:
+                - type: Wire type ("round", "litz", "rectangular", "foil", ...)
+                - standard: Wire standard ("IEC 60317", ...)
+                - conductingArea: [minimum, maximum] in m²; null is open
+                - outerDimension: [minimum, maximum] in m, the larger of the
+                  outer width and height
+                - frequency: Hz; adds "skinAcFactor" (Rac/Rdc of a sine at
+                  25 °C) to every match, interpolated between 1 kHz and 10 MHz
+                - maximumSkinAcFactor: Drop wires above this factor at
+                  "frequency", and wires whose factor cannot be computed
+                - maximumNumberResults: Keep the smallest N matches
+
+        Returns:
+            JSON object with "data" (matches ordered by conducting area, each
+            with "name", "conductingArea", "outerDimension" and optionally
+            "skinAcFactor"), "count" and "total" (wires indexed).
+        )pbdoc",
+        py::arg("query_json"),
+        py::call_guard<py::gil_scoped_release>());
+
     // Wire data functions
     m.def("get_wire_data", &get_wire_data,
         R"pbdoc(
@@ -0,0 +1,324 @@
+#include "wire_index.h"
+#include "concurrency.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace PyMKF {
+
+namespace {
+
+std::optional<WireIndex> wireIndex;
+
+// Points per period of the sinusoidal skin-factor current.
+constexpr size_t skinFactorWaveformPoints = 64;
+
+std::string enum_json_string(const WireType& type) {
+    json typeJson;
+    to_json(typeJson, type);
+    return typeJson.get<std::string>();
+}
+
+std::string enum_json_string(const WireStandard& standard) {
+    json standardJson;
+    to_json(standardJson, standard);
+    return standardJson.get<std::string>();
+}
+
+std::string group_key(const WireType& type, const std::optional<WireStandard>& standard) {
+    return enum_json_string(type) + "|" + (standard ? enum_json_string(standard.value()) : "");
+}
+
+double dimension(const json& wireJson, const std::string& key) {
+    if (!wireJson.contains(key) || wireJson[key].is_null()) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (wireJson[key].is_number()) {
+        return wireJson[key].get<double>();
+    }
+    return OpenMagnetics::resolve_dimensional_values(DimensionWithTolerance(wireJson[key]));
+}
+
+// Conducting cross-section from the wire's own fields: round and litz from
+// the (strand) conducting diameter, the flat types from width × height.
+double conducting_area(const json& wireJson) {
+    double area = dimension(wireJson, "conductingArea");
+    if (!std::isnan(area)) {
+        return area;
+    }
+    std::string type = wireJson.value("type", "");
+    if (type == "round") {
+        double diameter = dimension(wireJson, "conductingDiameter");
+        return M_PI / 4 * diameter * diameter;
+    }
+    if (type == "litz" && wireJson.contains("strand")) {
+        json strandJson = wireJson["strand"];
+        if (strandJson.is_string()) {
+            to_json(strandJson, OpenMagnetics::find_wire_by_name(strandJson.get<std::string>()));
+        }
+        double diameter = dimension(strandJson, "conductingDiameter");
+        return wireJson.value("numberConductors", 1) * M_PI / 4 * diameter * diameter;
+    }
+    return dimension(wireJson, "conductingWidth") * dimension(wireJson, "conductingHeight");
+}
+
+double outer_dimension(OpenMagnetics::Wire& wire) {
+    try {
+        return std::max(wire.get_maximum_outer_width(), wire.get_maximum_outer_height());
+    }
+    catch (const std::exception&) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+std::pair<double, double> parse_bounds(const json& boundsJson, const std::string& key) {
+    if (!boundsJson.is_array() || boundsJson.size() != 2) {
+        throw std::invalid_argument(key + " must be [minimum, maximum]");
+    }
+    return {boundsJson[0].is_null() ? 0 : boundsJson[0].get<double>(),
+            boundsJson[1].is_null() ? std::numeric_limits<double>::infinity() : boundsJson[1].get<double>()};
+}
+
+bool searches(const WireIndexGroup& group, const WireIndexQuery& query) {
+    return (!query.type || group.type == query.type.value()) && (!query.standard || group.standard == query.standard);
+}
+
+json wire_index_matches(const WireIndex& index, const WireIndexQuery& query) {
+    json result;
+    result["data"] = json::array();
+    for (auto& [group, entry] : index.search(query)) {
+        auto& wire = group->entries[entry];
+        json match;
+        match["name"] = wire.name;
+        match["conductingArea"] = wire.conductingArea;
+        match["outerDimension"] = std::isnan(wire.outerDimension) ? json() : json(wire.outerDimension);
+        if (query.frequency) {
+            match["skinAcFactor"] = group->skin_ac_factor(entry, query.frequency.value());
+        }
+        result["data"].push_back(std::move(match));
+    }
+    result["count"] = result["data"].size();
+    result["total"] = index.size();
+    return result;
+}
+
+} // namespace
+
+void WireIndexGroup::ensure_skin_ac_factors() {
+    if (skinAcFactors.size() == entries.size()) {
+        return;
+    }
+    std::vector<SignalDescriptor> currents;
+    for (double frequency : skinFactorFrequencies) {
+        Waveform waveform;
+        std::vector<double> time;
+        std::vector<double> data;
+        for (size_t point = 0; point <= skinFactorWaveformPoints; ++point) {
+            double fraction = static_cast<double>(point) / skinFactorWaveformPoints;
+            time.push_back(fraction / frequency);
+            data.push_back(std::sin(2 * M_PI * fraction));
+        }
+        waveform.set_time(time);
+        waveform.set_data(data);
+        currents.push_back(signal_descriptor_from_waveform(waveform, frequency));
+    }
+
+    skinAcFactors.assign(entries.size(), {});
+    for (size_t entry = 0; entry < entries.size(); ++entry) {
+        auto wire = OpenMagnetics::wireDatabase.at(entries[entry].name);
+        for (size_t slot = 0; slot < currents.size(); ++slot) {
+            try {
+                auto dcLossesPerMeter = OpenMagnetics::WindingOhmicLosses::calculate_ohmic_losses_per_meter(wire, currents[slot], skinFactorReferenceTemperature);
+                auto [skinLossesPerMeter, _] = OpenMagnetics::WindingSkinEffectLosses::calculate_skin_effect_losses_per_meter(wire, currents[slot], skinFactorReferenceTemperature);
+                skinAcFactors[entry][slot] = (skinLossesPerMeter + dcLossesPerMeter) / dcLossesPerMeter;
+            }
+            catch (const std::exception&) {
+                skinAcFactors[entry][slot] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+}
+
+double WireIndexGroup::skin_ac_factor(size_t entry, double frequency) const {
+    auto& factors = skinAcFactors[entry];
+    if (frequency <= skinFactorFrequencies.front()) {
+        return factors.front();
+    }
+    if (frequency >= skinFactorFrequencies.back()) {
+        return factors.back();
+    }
+    size_t upper = std::upper_bound(skinFactorFrequencies.begin(), skinFactorFrequencies.end(), frequency) - skinFactorFrequencies.begin();
+    double fraction = std::log(frequency / skinFactorFrequencies[upper - 1]) / std::log(skinFactorFrequencies[upper] / skinFactorFrequencies[upper - 1]);
+    return std::exp(std::log(factors[upper - 1]) + fraction * (std::log(factors[upper]) - std::log(factors[upper - 1])));
+}
+
+WireIndexQuery parse_wire_index_query(const json& queryJson) {
+    static const std::vector<std::string> keys = {"type", "standard", "conductingArea", "outerDimension",
+                                                  "frequency", "maximumSkinAcFactor", "maximumNumberResults"};
+    WireIndexQuery query;
+    for (auto& [key, value] : queryJson.items()) {
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            throw std::invalid_argument("Unknown wire index query key: " + key);
+        }
+        if (value.is_null()) {
+            continue;
+        }
+        if (key == "type") {
+            WireType type;
+            from_json(value, type);
+            query.type = type;
+        }
+        else if (key == "standard") {
+            WireStandard standard;
+            from_json(value, standard);
+            query.standard = standard;
+        }
+        else if (key == "conductingArea") {
+            std::tie(query.minimumConductingArea, query.maximumConductingArea) = parse_bounds(value, key);
+        }
+        else if (key == "outerDimension") {
+            std::tie(query.minimumOuterDimension, query.maximumOuterDimension) = parse_bounds(value, key);
+        }
+        else if (key == "frequency") {
+            query.frequency = value.get<double>();
+        }
+        else if (key == "maximumSkinAcFactor") {
+            query.maximumSkinAcFactor = value.get<double>();
+        }
+        else {
+            query.maximumNumberResults = value.get<size_t>();
+        }
+    }
+    if (query.maximumSkinAcFactor && !query.frequency) {
+        throw std::invalid_argument("maximumSkinAcFactor needs a frequency");
+    }
+    return query;
+}
+
+WireIndex WireIndex::build() {
+    WireIndex index;
+    for (auto& [name, wire] : OpenMagnetics::wireDatabase) {
+        try {
+            json wireJson;
+            to_json(wireJson, wire);
+            double area = conducting_area(wireJson);
+            if (std::isnan(area) || area <= 0) {
+                continue;
+            }
+            auto& group = index._groups[group_key(wire.get_type(), wire.get_standard())];
+            group.type = wire.get_type();
+            group.standard = wire.get_standard();
+            group.entries.push_back({name, area, outer_dimension(wire)});
+            ++index._size;
+        }
+        catch (const std::exception&) {}
+    }
+    for (auto& [key, group] : index._groups) {
+        std::stable_sort(group.entries.begin(), group.entries.end(), [](const WireIndexEntry& a, const WireIndexEntry& b) {
+            return a.conductingArea < b.conductingArea;
+        });
+    }
+    return index;
+}
+
+bool WireIndex::prepared(const WireIndexQuery& query) const {
+    if (!query.frequency) {
+        return true;
+    }
+    for (auto& [key, group] : _groups) {
+        if (searches(group, query) && group.skinAcFactors.size() != group.entries.size()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WireIndex::prepare(const WireIndexQuery& query) {
+    if (!query.frequency) {
+        return;
+    }
+    for (auto& [key, group] : _groups) {
+        if (searches(group, query)) {
+            group.ensure_skin_ac_factors();
+        }
+    }
+}
+
+std::vector<std::pair<const WireIndexGroup*, size_t>> WireIndex::search(const WireIndexQuery& query) const {
+    std::vector<std::pair<const WireIndexGroup*, size_t>> matches;
+    for (auto& [key, group] : _groups) {
+        if (!searches(group, query)) {
+            continue;
+        }
+        auto& entries = group.entries;
+        auto first = std::lower_bound(entries.begin(), entries.end(), query.minimumConductingArea,
+                                      [](const WireIndexEntry& entry, double area) { return entry.conductingArea < area; });
+        auto last = std::upper_bound(first, entries.end(), query.maximumConductingArea,
+                                     [](double area, const WireIndexEntry& entry) { return area < entry.conductingArea; });
+        for (auto it = first; it != last; ++it) {
+            size_t entry = it - entries.begin();
+            double outer = it->outerDimension;
+            if (!std::isnan(outer) && (outer < query.minimumOuterDimension || outer > query.maximumOuterDimension)) {
+                continue;
+            }
+            if (query.maximumSkinAcFactor) {
+                // A factor MKF could not work out cannot be shown to be under the limit.
+                double skinAcFactor = group.skin_ac_factor(entry, query.frequency.value());
+                if (std::isnan(skinAcFactor) || skinAcFactor > query.maximumSkinAcFactor.value()) {
+                    continue;
+                }
+            }
+            matches.emplace_back(&group, entry);
+        }
+    }
+    std::stable_sort(matches.begin(), matches.end(), [](const auto& a, const auto& b) {
+        return a.first->entries[a.second].conductingArea < b.first->entries[b.second].conductingArea;
+    });
+    if (query.maximumNumberResults && matches.size() > query.maximumNumberResults.value()) {
+        matches.resize(query.maximumNumberResults.value());
+    }
+    return matches;
+}
+
+WireIndex* built_wire_index() {
+    return wireIndex ? &wireIndex.value() : nullptr;
+}
+
+WireIndex& ensure_wire_index() {
+    if (!wireIndex) {
+        load_missing_databases();
+        wireIndex = WireIndex::build();
+    }
+    return *wireIndex;
+}
+
+void invalidate_wire_index() {
+    wireIndex.reset();
+}
+
+json query_wire_index(json queryJson) {
+    try {
+        auto query = parse_wire_index_query(queryJson);
+        {
+            // A built index is only read, so queries share the lock; building
+            // it or its skin factors is exclusive.
+            StateReadLock stateLock;
+            auto index = built_wire_index();
+            if (index && index->prepared(query)) {
+                return wire_index_matches(*index, query);
+            }
+        }
+        StateWriteLock stateLock;
+        auto& index = ensure_wire_index();
+        index.prepare(query);
+        return wire_index_matches(index, query);
+    }
+    catch (const std::exception &exc) {
+        json exception;
+        exception["data"] = "Exception: " + std::string{exc.what()};
+        return exception;
+    }
+}
+
+} // namespace PyMKF
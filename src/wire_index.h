@@ -0,0 +1,106 @@
+#pragma once
+
+#include "common.h"
+
+#include <array>
+#include <limits>
+#include <map>
+#include <optional>
+
+namespace PyMKF {
+
+// ─── Sorted wire index ──────────────────────────────────────────────────────
+// Choosing a wire by size means walking all of wireDatabase and building
+// every Wire's dimensions, once per winding and per section. The index does
+// that once: wires are grouped by (type, standard) and each group is sorted
+// by conducting area, so a size query is two binary searches and a scan of
+// the matching window only, where the outer dimension is checked.
+//
+// Skin-effect AC factors (Rac/Rdc for a sinusoidal current at
+// skinFactorReferenceTemperature) are computed per group at the
+// skinFactorFrequencies the first time a query asks for them, and
+// interpolated log-log in between; frequencies outside that span use the
+// nearest end.
+//
+// Wires whose conducting area cannot be worked out are left out of the
+// index; a missing outer dimension is stored as NaN and never excluded. A
+// skin factor that cannot be worked out is NaN too, and such a wire never
+// passes a maximumSkinAcFactor bound.
+//
+// The index only serves query_wire_index. MKF's wire adviser and finders
+// (calculate_advised_wires and its batch, find_wire_by_dimension,
+// get_equivalent_wire) walk wireDatabase themselves inside MKF and do not
+// consult it.
+constexpr std::array<double, 11> skinFactorFrequencies = {1e3, 1e4, 2e4, 5e4, 1e5, 2e5, 5e5, 1e6, 2e6, 5e6, 1e7};
+constexpr double skinFactorReferenceTemperature = 25;
+
+struct WireIndexEntry {
+    std::string name;
+    double conductingArea;
+    double outerDimension;
+};
+
+struct WireIndexGroup {
+    WireType type;
+    std::optional<WireStandard> standard;
+    // Sorted by conducting area.
+    std::vector<WireIndexEntry> entries;
+    // One row of skinFactorFrequencies.size() factors per entry, once computed.
+    std::vector<std::array<double, skinFactorFrequencies.size()>> skinAcFactors;
+
+    // Skin factors of every entry; computed on first use.
+    void ensure_skin_ac_factors();
+    double skin_ac_factor(size_t entry, double frequency) const;
+};
+
+struct WireIndexQuery {
+    std::optional<WireType> type;
+    std::optional<WireStandard> standard;
+    double minimumConductingArea = 0;
+    double maximumConductingArea = std::numeric_limits<double>::infinity();
+    double minimumOuterDimension = 0;
+    double maximumOuterDimension = std::numeric_limits<double>::infinity();
+    std::optional<double> frequency;
+    std::optional<double> maximumSkinAcFactor;
+    std::optional<size_t> maximumNumberResults;
+};
+
+// Parses {"type", "standard", "conductingArea": [min, max],
+// "outerDimension": [min, max], "frequency", "maximumSkinAcFactor",
+// "maximumNumberResults"}; null bounds are open. Throws
+// std::invalid_argument on unknown keys.
+WireIndexQuery parse_wire_index_query(const json& queryJson);
+
+class WireIndex {
+  public:
+    // Indexes the wires now in wireDatabase. Requires a StateWriteLock.
+    static WireIndex build();
+
+    size_t size() const { return _size; }
+    const std::map<std::string, WireIndexGroup>& groups() const { return _groups; }
+
+    // Whether search(query) can run: when the query has a frequency, the
+    // skin factors of the groups it searches must have been computed.
+    bool prepared(const WireIndexQuery& query) const;
+    // Computes what prepared() checks. Requires a StateWriteLock.
+    void prepare(const WireIndexQuery& query);
+
+    // Matching wires ordered by conducting area, as (group, entry) pairs.
+    // Requires prepared(query) and a StateReadLock.
+    std::vector<std::pair<const WireIndexGroup*, size_t>> search(const WireIndexQuery& query) const;
+
+  private:
+    std::map<std::string, WireIndexGroup> _groups;
+    size_t _size = 0;
+};
+
+// Process-wide index over wireDatabase. built_wire_index() is null until the
+// index is built and requires a StateReadLock; the other two require a
+// StateWriteLock.
+WireIndex* built_wire_index();
+WireIndex& ensure_wire_index();
+void invalidate_wire_index();
+
+json query_wire_index(json queryJson);
+
+} // namespace PyMKF
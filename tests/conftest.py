@@ -311,3 +311,43 @@ def reset_settings():
     PyOpenMagnetics.reset_settings()
     yield
     PyOpenMagnetics.reset_settings()
+
+
+# ============================================================================
+# Sample Magnetics
+# ============================================================================
+
+def _wound_e42(gapping):
+    """An E 42/21/15 in 3C95 with 20 turns of Round 0.5 - Grade 1."""
+    core = PyOpenMagnetics.calculate_core_data({
+        "functionalDescription": {
+            "type": "two-piece set",
+            "material": "3C95",
+            "shape": "E 42/21/15",
+            "gapping": gapping,
+            "numberStacks": 1
+        }
+    }, True)
+    bobbin = PyOpenMagnetics.create_basic_bobbin(core, True)
+    coil = PyOpenMagnetics.wind({
+        "bobbin": bobbin,
+        "functionalDescription": [{
+            "name": "Primary",
+            "numberTurns": 20,
+            "numberParallels": 1,
+            "isolationSide": "primary",
+            "wire": PyOpenMagnetics.find_wire_by_name("Round 0.5 - Grade 1")
+        }]
+    }, 1, [1.0], [0], [[0.001, 0.001]])
+    if "data" in core or "data" in coil:
+        pytest.skip("could not build the sample magnetic")
+    return {"core": core, "coil": coil}
+
+
+@pytest.fixture(scope="session")
+def wound_inductor():
+    """
+    A gapped E 42/21/15 in 3C95 with 20 turns of Round 0.5 - Grade 1,
+    built once for the tests that only need some complete magnetic.
+    """
+    return _wound_e42([{"type": "subtractive", "length": 0.0005}])
@@ -0,0 +1,107 @@
+"""
+Tests for calling PyOpenMagnetics from several Python threads.
+
+Long-running bindings release the GIL; shared MKF state (settings,
+databases, caches) is coordinated by the reader/writer lock in
+src/concurrency.h. These tests check the observable guarantees.
+"""
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+import PyOpenMagnetics
+
+
+class TestSettingsScope:
+    """Advisers restore the caller's settings instead of resetting them."""
+
+    def test_advised_cores_preserves_settings(self, inductor_inputs, balanced_weights, reset_settings):
+        PyOpenMagnetics.set_settings({"useToroidalCores": False})
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        PyOpenMagnetics.calculate_advised_cores(processed_inputs, balanced_weights, 2, "standard cores")
+
+        assert PyOpenMagnetics.get_settings()["useToroidalCores"] is False
+
+    def test_per_call_settings_are_undone(self, inductor_inputs, balanced_weights, reset_settings):
+        PyOpenMagnetics.set_settings({"useToroidalCores": False})
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        result = PyOpenMagnetics.calculate_advised_cores(
+            processed_inputs, balanced_weights, 2, "standard cores", settings={"useToroidalCores": True})
+
+        assert isinstance(result["data"], list)
+        assert PyOpenMagnetics.get_settings()["useToroidalCores"] is False
+
+
+class TestConcurrentCalls:
+    """Concurrent calls give the same answers as serial ones."""
+
+    def test_process_inputs_in_threads_matches_serial(self, inductor_inputs):
+        expected = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            results = list(executor.map(lambda _: PyOpenMagnetics.process_inputs(inductor_inputs), range(8)))
+
+        for result in results:
+            assert result == expected
+
+    def test_winding_losses_while_an_adviser_runs(self, inductor_inputs, balanced_weights, wound_inductor, reset_settings):
+        # calculate_winding_losses reads the settings the adviser flips.
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        operating_point = processed_inputs["operatingPoints"][0]
+        expected = PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, 25)
+
+        with ThreadPoolExecutor(max_workers=4) as executor:
+            adviser = executor.submit(PyOpenMagnetics.calculate_advised_cores, processed_inputs, balanced_weights, 2, "standard cores")
+            losses = list(executor.map(
+                lambda _: PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, 25), range(8)))
+            adviser.result()
+
+        for result in losses:
+            assert result["windingLosses"] == pytest.approx(expected["windingLosses"], rel=1e-12)
+
+    def test_settings_writes_are_atomic(self, reset_settings):
+        errors = []
+
+        def toggle(value):
+            try:
+                for _ in range(50):
+                    PyOpenMagnetics.set_settings({"useOnlyCoresInStock": value})
+                    assert isinstance(PyOpenMagnetics.get_settings()["useOnlyCoresInStock"], bool)
+            except Exception as exc:  # pragma: no cover - reported below
+                errors.append(exc)
+
+        threads = [threading.Thread(target=toggle, args=(index % 2 == 0,)) for index in range(4)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        assert errors == []
+
+    def test_progress_callback_with_other_threads_waiting(self, inductor_inputs, reset_settings):
+        # The callback needs the GIL while the search holds the state lock;
+        # the other thread must wait for that lock without holding the GIL.
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        reports = []
+        stop = threading.Event()
+
+        def hammer():
+            while not stop.is_set():
+                PyOpenMagnetics.set_settings({"useOnlyCoresInStock": False})
+                PyOpenMagnetics.get_core_shape_names(False)
+
+        worker = threading.Thread(target=hammer)
+        worker.start()
+        try:
+            result = PyOpenMagnetics.calculate_advised_magnetics_fast(
+                processed_inputs, 2, "standard cores", 0, 128,
+                progress_callback=reports.append, interruptible=True)
+        finally:
+            stop.set()
+            worker.join(timeout=60)
+
+        assert not worker.is_alive()
+        assert reports[-1]["phase"] == "done"
+        assert isinstance(result["data"], list)
@@ -1,5 +1,8 @@
 """Tests for converter topology endpoints."""
 import json
+import shutil
+
+import pytest
 import PyOpenMagnetics as PyMKF
 
 
@@ -71,6 +74,51 @@ def test_process_boost():
     print("✓ Boost converter processed successfully")
 
 
+_SPLIT_OPERATING_POINTS = [
+    {"outputVoltages": [12.0], "outputCurrents": [2.0],
+     "switchingFrequency": 100000, "ambientTemperature": 25},
+    {"outputVoltages": [12.0], "outputCurrents": [0.5],
+     "switchingFrequency": 100000, "ambientTemperature": 25},
+]
+
+_SPLIT_SPECS = {
+    "flyback": {
+        "inputVoltage": {"nominal": 230, "minimum": 120, "maximum": 375},
+        "diodeVoltageDrop": 0.7,
+        "maximumDutyCycle": 0.5,
+        "efficiency": 0.9,
+        "currentRippleRatio": 0.5,
+        "operatingPoints": _SPLIT_OPERATING_POINTS,
+    },
+    "buck": {
+        "inputVoltage": {"nominal": 36, "minimum": 24, "maximum": 48},
+        "diodeVoltageDrop": 0.7,
+        "currentRippleRatio": 0.3,
+        "operatingPoints": _SPLIT_OPERATING_POINTS,
+    },
+    "boost": {
+        "inputVoltage": {"nominal": 5, "minimum": 3.3, "maximum": 9},
+        "diodeVoltageDrop": 0.7,
+        "currentRippleRatio": 0.3,
+        "operatingPoints": _SPLIT_OPERATING_POINTS,
+    },
+}
+
+
+@pytest.mark.parametrize("topology", sorted(_SPLIT_SPECS))
+def test_process_converter_threads_match_sequential(topology):
+    """Splitting a base spec's input voltages over threads gives the sequential result.
+
+    Every topology process_converter splits must have a case here.
+    """
+    spec = _SPLIT_SPECS[topology]
+    sequential = PyMKF.process_converter(topology, spec, use_ngspice=False)
+    parallel = PyMKF.process_converter(topology, spec, use_ngspice=False, threads=0)
+    assert "error" not in sequential, f"Error: {sequential.get('error')}"
+    assert parallel == sequential
+    print(f"✓ Parallel input-voltage processing matches sequential for {topology}")
+
+
 def test_design_magnetics_from_flyback():
     """Test full magnetic design from Flyback converter."""
     flyback = {
@@ -95,6 +143,127 @@ def test_design_magnetics_from_flyback():
     print("  Use design_magnetics_from_converter() for full magnetic design")
 
 
+def test_design_pipeline_caches_processed_inputs():
+    """DesignPipeline processes the converter once and reuses it."""
+    buck = {
+        "inputVoltage": {"minimum": 12, "maximum": 12},
+        "desiredInductance": 10e-6,
+        "diodeVoltageDrop": 0.7,
+        "operatingPoints": [{
+            "outputVoltages": [5.0],
+            "outputCurrents": [2.0],
+            "switchingFrequency": 100000,
+            "ambientTemperature": 25
+        }]
+    }
+
+    pipeline = PyMKF.DesignPipeline("buck", buck, False)
+    first = pipeline.inputs()
+    assert "error" not in first, f"Error: {first.get('error')}"
+    assert pipeline.inputs() == first == PyMKF.process_converter("buck", buck, use_ngspice=False)
+    assert pipeline.info() == {"inputsCached": True, "designs": 0, "maxDesigns": 16, "hits": 1, "misses": 1}
+    assert "error" in pipeline.rerank({"COST": 1.0})
+
+    pipeline.clear()
+    assert pipeline.info()["inputsCached"] is False
+    assert "Unknown topology" in PyMKF.DesignPipeline("invalid_topology", {}, False).inputs()["error"]
+    print("✓ DesignPipeline input caching works")
+
+
+def test_design_pipeline_serves_only_repeated_designs():
+    """Only a design() with the same max_results is served from the cache."""
+    buck = {
+        "inputVoltage": {"minimum": 12, "maximum": 12},
+        "desiredInductance": 10e-6,
+        "diodeVoltageDrop": 0.7,
+        "operatingPoints": [{
+            "outputVoltages": [5.0],
+            "outputCurrents": [2.0],
+            "switchingFrequency": 100000,
+            "ambientTemperature": 25
+        }]
+    }
+
+    pipeline = PyMKF.DesignPipeline("buck", buck, False)
+    designs = pipeline.design(2, "standard cores")
+    assert "error" not in designs, f"Error: {designs.get('error')}"
+    # The inputs stage missed once, feeding the adviser run.
+    assert pipeline.info() == {"inputsCached": True, "designs": 1, "maxDesigns": 16, "hits": 0, "misses": 2}
+
+    assert pipeline.design(2, "standard cores") == designs
+    assert pipeline.info()["hits"] == 1
+
+    # A new run reuses the processed inputs.
+    fewer = pipeline.design(1, "standard cores")
+    assert "error" not in fewer, f"Error: {fewer.get('error')}"
+    assert len(fewer["data"]) <= 1
+    assert pipeline.info() == {"inputsCached": True, "designs": 2, "maxDesigns": 16, "hits": 2, "misses": 3}
+    print("✓ DesignPipeline design caching works")
+
+
+def test_design_pipeline_keeps_at_most_max_designs():
+    """The least recently used design() run is dropped past max_designs."""
+    buck = {
+        "inputVoltage": {"minimum": 12, "maximum": 12},
+        "desiredInductance": 10e-6,
+        "diodeVoltageDrop": 0.7,
+        "operatingPoints": [{
+            "outputVoltages": [5.0],
+            "outputCurrents": [2.0],
+            "switchingFrequency": 100000,
+            "ambientTemperature": 25
+        }]
+    }
+
+    with pytest.raises(ValueError, match="max_designs"):
+        PyMKF.DesignPipeline("buck", buck, False, max_designs=0)
+
+    pipeline = PyMKF.DesignPipeline("buck", buck, False, max_designs=2)
+    for max_results in (1, 2, 1, 3):
+        designs = pipeline.design(max_results, "standard cores")
+        assert "error" not in designs, f"Error: {designs.get('error')}"
+    # The run for 2 was the least recently used when the one for 3 came in.
+    assert pipeline.info()["designs"] == 2
+    hits = pipeline.info()["hits"]
+    pipeline.design(1, "standard cores")
+    assert pipeline.info()["hits"] == hits + 1
+    pipeline.design(2, "standard cores")
+    assert pipeline.info()["hits"] == hits + 2  # the inputs stage, not the run
+    print("✓ DesignPipeline bounds its cached designs")
+
+
+def test_design_pipeline_rerank_orders_by_weighted_scorings():
+    """rerank() orders the last full design by its weighted per-filter scorings."""
+    buck = {
+        "inputVoltage": {"minimum": 12, "maximum": 12},
+        "desiredInductance": 10e-6,
+        "diodeVoltageDrop": 0.7,
+        "operatingPoints": [{
+            "outputVoltages": [5.0],
+            "outputCurrents": [2.0],
+            "switchingFrequency": 100000,
+            "ambientTemperature": 25
+        }]
+    }
+    weights = {"COST": 3.0}
+
+    pipeline = PyMKF.DesignPipeline("buck", buck, False)
+    designs = pipeline.design(3, "standard cores")
+    assert "error" not in designs, f"Error: {designs.get('error')}"
+    reranked = pipeline.rerank(weights)
+    assert "error" not in reranked, f"Error: {reranked.get('error')}"
+
+    def weighted(item):
+        return sum(weights.get(name, 1.0) * score for name, score in item.get("scoringPerFilter", {}).items())
+
+    expected = sorted(designs["data"], key=weighted, reverse=True)
+    assert [item["mas"] for item in reranked["data"]] == [item["mas"] for item in expected]
+    assert [item["scoring"] for item in reranked["data"]] == pytest.approx([weighted(item) for item in expected])
+    assert len(pipeline.rerank(weights, 1)["data"]) == min(1, len(designs["data"]))
+    assert pipeline.info()["misses"] == 2  # the inputs and the one adviser run
+    print("✓ DesignPipeline rerank ordering works")
+
+
 def test_per_topology_wrappers():
     """Test per-topology wrapper functions."""
 
@@ -148,6 +317,48 @@ def test_invalid_topology():
     print("✓ Invalid topology error handling works")
 
 
+def test_design_batch_reports_per_item_errors():
+    """Batch design returns one item per spec, errors included, in spec order."""
+    specs = [("invalid_topology", {"some": "data"}), ("another_invalid_topology", {})]
+    seen = []
+
+    results = PyMKF.design_magnetics_from_converter_batch(
+        specs, 1, "standard cores", False, None, True, 2, seen.append)
+
+    assert [item["index"] for item in results] == [0, 1]
+    assert [item["index"] for item in seen] == [0, 1]
+    for item in results:
+        assert item["topologyName"] == specs[item["index"]][0]
+        assert "Unknown topology" in item["error"]
+    print("✓ Batch design per-item error handling works")
+
+
+def test_ngspice_batch_runs_decks_in_order():
+    """Each deck runs in its own ngspice process; results keep deck order."""
+    if shutil.which("ngspice") is None:
+        pytest.skip("ngspice executable not on PATH")
+    decks = [
+        f"rc\nV1 in 0 DC {volts}\nR1 in out 1k\nC1 out 0 1n\n.tran 10n 5u\n.end\n"
+        for volts in (1.0, 2.0, 3.0)
+    ]
+    broken = "broken\nX1 nowhere\n.tran 1n 1u\n.end\n"
+
+    results = PyMKF.run_ngspice_batch(decks + [broken], threads=2)
+
+    assert [item["index"] for item in results] == [0, 1, 2, 3]
+    for volts, item in zip((1.0, 2.0, 3.0), results):
+        assert item["ok"], item.get("log")
+        assert item["vectors"]["v(out)"][-1] == pytest.approx(volts, rel=1e-3)
+        assert len(item["vectors"]["time"]) == len(item["vectors"]["v(out)"])
+    assert not results[3]["ok"]
+    print("✓ ngspice batch runner works")
+
+
+def test_ngspice_batch_missing_executable():
+    with pytest.raises(RuntimeError, match="standalone ngspice install"):
+        PyMKF.run_ngspice_batch(["x\n.end\n"], ngspice_path="no-such-ngspice-binary")
+
+
 def test_llc_converter():
     """Test LLC resonant converter."""
     llc = {
@@ -228,6 +439,7 @@ if __name__ == "__main__":
     test_forward_converters()
     test_per_topology_wrappers()
     test_invalid_topology()
+    test_design_batch_reports_per_item_errors()
     
     print("\n--- Full Design Flow Test ---")
     test_design_magnetics_from_flyback()
@@ -4,6 +4,8 @@ Tests for PyOpenMagnetics Core data retrieval and calculations.
 These tests mirror TestCore.cpp and TestCoreAdviser.cpp from MKF,
 verifying core shape, material, and gapping calculations.
 """
+import struct
+
 import pytest
 import PyOpenMagnetics
 
@@ -53,6 +55,17 @@ class TestCoreShapes:
             assert isinstance(shape, dict)
             assert "family" in shape
 
+    def test_memoised_lookups_survive_database_reload(self):
+        """Cached names and lookups must match a fresh load after clear_databases."""
+        names = PyOpenMagnetics.get_core_shape_names(True)
+        shape = PyOpenMagnetics.find_core_shape_by_name(names[0])
+        assert PyOpenMagnetics.get_core_shape_names(True) == names
+        assert PyOpenMagnetics.find_core_shape_by_name(names[0]) == shape
+
+        PyOpenMagnetics.clear_databases()
+        assert PyOpenMagnetics.get_core_shape_names(True) == names
+        assert PyOpenMagnetics.find_core_shape_by_name(names[0]) == shape
+
 
 class TestCoreMaterials:
     """Test suite for core materials - mirrors material tests in TestCore.cpp"""
@@ -302,3 +315,153 @@ class TestCoreProcessedDescription:
             if "windingWindows" in processed:
                 assert isinstance(processed["windingWindows"], list)
                 assert len(processed["windingWindows"]) > 0
+
+
+class TestStateSnapshot:
+    """save_state_snapshot / load_state_snapshot round trip."""
+
+    def test_round_trip_restores_databases(self, tmp_path):
+        PyOpenMagnetics.get_core_shapes()
+        path = str(tmp_path / "state.snap")
+
+        saved = PyOpenMagnetics.save_state_snapshot(path)
+        assert saved["coreShapes"] > 0
+
+        PyOpenMagnetics.clear_databases()
+        restored = PyOpenMagnetics.load_state_snapshot(path)
+
+        for key in ("coreMaterials", "coreShapes", "wires", "bobbins", "insulationMaterials",
+                    "wireMaterials", "cores", "magnetics"):
+            assert restored[key] == saved[key]
+        assert len(PyOpenMagnetics.get_core_shapes()) > 0
+
+    def test_rejects_foreign_file(self, tmp_path):
+        path = tmp_path / "not_a_snapshot"
+        path.write_bytes(b"{}")
+        result = PyOpenMagnetics.load_state_snapshot(str(path))
+        assert "Exception" in result["data"]
+
+    def test_rejects_oversized_record_count(self, tmp_path):
+        path = tmp_path / "huge_count.snap"
+        header = b"PYOMSNAP" + struct.pack("<IIQ", 3, 0, 2**61)
+        path.write_bytes(header + bytes(24))
+        result = PyOpenMagnetics.load_state_snapshot(str(path))
+        assert "truncated" in result["data"]
+
+    def test_shared_state_serves_lookups(self, tmp_path):
+        name = PyOpenMagnetics.get_core_shape_names(True)[0]
+        expected = PyOpenMagnetics.find_core_shape_by_name(name)
+        path = str(tmp_path / "shared.snap")
+        PyOpenMagnetics.save_state_snapshot(path)
+
+        info = PyOpenMagnetics.attach_shared_state(path)
+        try:
+            assert info["attached"]
+            assert info["coreShapes"] > 0
+            assert PyOpenMagnetics.find_core_shape_by_name(name) == expected
+        finally:
+            PyOpenMagnetics.detach_shared_state()
+        assert not PyOpenMagnetics.get_shared_state_info()["attached"]
+
+    def test_shared_state_is_only_a_fallback(self, tmp_path):
+        name = PyOpenMagnetics.get_core_shape_names(True)[0]
+        expected = PyOpenMagnetics.find_core_shape_by_name(name)
+        path = str(tmp_path / "fallback.snap")
+        PyOpenMagnetics.save_state_snapshot(path)
+
+        PyOpenMagnetics.clear_databases()
+        PyOpenMagnetics.attach_shared_state(path)
+        try:
+            assert PyOpenMagnetics.is_core_shape_database_empty()
+            assert PyOpenMagnetics.find_core_shape_by_name(name) == expected
+            assert PyOpenMagnetics.is_core_shape_database_empty()
+
+            PyOpenMagnetics.get_core_shapes()
+            assert not PyOpenMagnetics.is_core_shape_database_empty()
+            assert PyOpenMagnetics.find_core_shape_by_name(name) == expected
+        finally:
+            PyOpenMagnetics.detach_shared_state()
+            PyOpenMagnetics.load_state_snapshot(path)
+
+
+class TestSteinmetzBatchFit:
+    """fit_steinmetz_coefficients_batch over database materials."""
+
+    def _fitted(self, names):
+        fits = PyOpenMagnetics.fit_steinmetz_coefficients_batch([{"material": name} for name in names], threads=2)
+        assert [fit["material"] for fit in fits["data"]] == names
+        for fit in fits["data"]:
+            assert "error" in fit or len(fit["coefficientsPerRange"]) == len(fit["errorPerRange"])
+        return [fit for fit in fits["data"] if "error" not in fit]
+
+    def test_results_match_single_fit(self):
+        names = PyOpenMagnetics.get_core_material_names()[:8]
+        fitted = self._fitted(names)
+        if not fitted:
+            pytest.skip("no material with measured volumetric losses among the first names")
+        material = PyOpenMagnetics.find_core_material_by_name(fitted[0]["material"])
+        points = [point for elements in material["volumetricLosses"].values()
+                  for element in elements if isinstance(element, list) for point in element]
+        ranges = [[r["minimumFrequency"], r["maximumFrequency"]] for r in fitted[0]["coefficientsPerRange"]]
+
+        single = PyOpenMagnetics.calculate_steinmetz_coefficients_with_error(points, ranges)
+        assert fitted[0]["errorPerRange"] == pytest.approx(single["errorPerRange"])
+
+    def test_update_database(self, tmp_path):
+        fitted = self._fitted(PyOpenMagnetics.get_core_material_names()[:8])
+        if not fitted:
+            pytest.skip("no material with measured volumetric losses among the first names")
+        path = str(tmp_path / "before.snap")
+        PyOpenMagnetics.save_state_snapshot(path)
+        try:
+            fit = PyOpenMagnetics.fit_steinmetz_coefficients_batch(
+                [{"material": fitted[0]["material"]}], update_database=True)["data"][0]
+            assert fit["updated"]
+            first = fit["coefficientsPerRange"][0]
+            frequency = (first["minimumFrequency"] + first["maximumFrequency"]) / 2
+            coefficients = PyOpenMagnetics.get_core_material_steinmetz_coefficients(fit["material"], frequency)
+            assert coefficients["k"] == pytest.approx(first["k"])
+
+            material = PyOpenMagnetics.find_core_material_by_name(fit["material"])
+            steinmetz = [element for elements in material["volumetricLosses"].values()
+                         for element in elements if isinstance(element, dict) and element.get("method") == "steinmetz"]
+            assert len(steinmetz) == 1
+            assert steinmetz[0]["ranges"][0]["k"] == pytest.approx(first["k"])
+            assert steinmetz[0]["ranges"][0]["alpha"] == pytest.approx(first["alpha"])
+        finally:
+            PyOpenMagnetics.load_state_snapshot(path)
+
+    def test_missing_material_is_reported_per_job(self):
+        fits = PyOpenMagnetics.fit_steinmetz_coefficients_batch([{"material": "not a material"}])
+        assert "Exception" in fits["data"][0]["error"]
+
+
+class TestMaterialPropertyTable:
+    """MaterialPropertyTable must agree with the direct material functions."""
+
+    def test_permeability_matches_direct(self):
+        np = pytest.importorskip("numpy")
+        table = PyOpenMagnetics.MaterialPropertyTable("3C95", temperature_range=(25, 100),
+                                                      frequency_range=(10e3, 1e6), max_relative_error=1e-3)
+        temperatures = np.linspace(25, 100, 7)
+        mu = table.permeability(temperatures, 0.0, 100e3)
+
+        assert mu.shape == temperatures.shape
+        for temperature, value in zip(temperatures, mu):
+            expected = PyOpenMagnetics.get_material_permeability("3C95", float(temperature), 0.0, 100e3)
+            assert value == pytest.approx(expected, rel=1e-2)
+        assert table.info()["permeability"]["errorEstimate"] >= 0
+
+    def test_resistivity_and_out_of_range_points(self):
+        np = pytest.importorskip("numpy")
+        table = PyOpenMagnetics.MaterialPropertyTable("3C95", temperature_range=(25, 100))
+        rho = table.resistivity(np.array([50.0, 150.0]))
+        assert rho[0] == pytest.approx(PyOpenMagnetics.get_material_resistivity("3C95", 50.0), rel=1e-2)
+        assert rho[1] == pytest.approx(PyOpenMagnetics.get_material_resistivity("3C95", 150.0))
+        assert "permeability" not in table.info()
+
+    def test_mismatched_lengths_raise(self):
+        np = pytest.importorskip("numpy")
+        table = PyOpenMagnetics.MaterialPropertyTable("3C95")
+        with pytest.raises(ValueError):
+            table.permeability(np.zeros(3) + 25, np.zeros(2), 100e3)
@@ -63,6 +63,16 @@ class TestCoreAdviserBasic:
                 assert isinstance(result, dict)
 
 
+    def test_threaded_results_match_serial(self, inductor_inputs, balanced_weights, reset_settings):
+        """Parallel result building must not change the ranking."""
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        serial = PyOpenMagnetics.calculate_advised_cores(processed_inputs, balanced_weights, 5, "standard cores", 1)
+        threaded = PyOpenMagnetics.calculate_advised_cores(processed_inputs, balanced_weights, 5, "standard cores", 4)
+
+        assert threaded == serial
+
+
 class TestCoreAdviserWithDifferentInputs:
     """Test core adviser with various input configurations."""
 
@@ -147,3 +157,19 @@ class TestCoreAdviserFiltering:
         # Both should return lists
         assert isinstance(results_available, list)
         assert isinstance(results_standard, list)
+
+    def test_prefilter_restricts_candidates(self, inductor_inputs, balanced_weights, reset_settings):
+        """Only cores accepted by the index pre-filter should be advised."""
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        prefilter = {"effectiveArea": [1e-5, 1e-4]}
+
+        allowed = set(PyOpenMagnetics.query_core_index(prefilter)["names"])
+        results = parse_json_result(PyOpenMagnetics.calculate_advised_cores(
+            processed_inputs, balanced_weights, 5, "available cores", 1, prefilter))
+
+        for result in results:
+            assert result["mas"]["magnetic"]["core"]["name"] in allowed
+
+        empty = PyOpenMagnetics.calculate_advised_cores(
+            processed_inputs, balanced_weights, 5, "available cores", 1, {"effectiveArea": [1, None]})
+        assert empty["data"] == []
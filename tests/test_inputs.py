@@ -197,3 +197,131 @@ class TestDesignRequirements:
         ratios = result["designRequirements"]["turnsRatios"]
         assert len(ratios) == 1
         assert abs(ratios[0]["nominal"] - 0.307692) < 0.001
+
+
+class TestNumpyWaveforms:
+    """The NumPy overloads must agree with the JSON ones."""
+
+    def test_harmonics_match_json_overload(self):
+        np = pytest.importorskip("numpy")
+        frequency = 100e3
+        time = np.linspace(0, 1 / frequency, 2049)
+        data = 5 * np.sin(2 * np.pi * frequency * time) + 1
+
+        expected = PyOpenMagnetics.calculate_harmonics({"time": time.tolist(), "data": data.tolist()}, frequency)
+        harmonics = PyOpenMagnetics.calculate_harmonics(time, data, frequency)
+
+        assert isinstance(harmonics["amplitudes"], np.ndarray)
+        np.testing.assert_allclose(harmonics["amplitudes"], expected["amplitudes"])
+        np.testing.assert_allclose(harmonics["frequencies"], expected["frequencies"])
+
+        sampled_time, sampled_data = PyOpenMagnetics.calculate_sampled_waveform(time, data, frequency)
+        assert len(sampled_time) == len(sampled_data)
+
+    def test_mismatched_lengths_raise(self):
+        np = pytest.importorskip("numpy")
+        with pytest.raises(ValueError):
+            PyOpenMagnetics.calculate_harmonics(np.zeros(10), np.zeros(11), 100e3)
+
+
+class TestAdaptiveHarmonics:
+    """energy_threshold / harmonic_energy_threshold keep only the harmonics that matter."""
+
+    def test_sine_keeps_fundamental_with_few_samples(self):
+        frequency = 100e3
+        points = 256
+        time = [i / (points * frequency) for i in range(points + 1)]
+        data = [5 * math.sin(2 * math.pi * frequency * t) + 1 for t in time]
+
+        full = PyOpenMagnetics.calculate_harmonics({"time": time, "data": data}, frequency)
+        adaptive = PyOpenMagnetics.calculate_harmonics({"time": time, "data": data}, frequency, energy_threshold=1e-6)
+
+        assert "data" not in adaptive
+        assert adaptive["retainedHarmonics"] == len(adaptive["amplitudes"]) == 2
+        assert adaptive["retainedHarmonics"] < len(full["amplitudes"])
+        assert adaptive["numberSamples"] == 32
+        assert adaptive["frequencies"][1] == pytest.approx(frequency)
+        assert adaptive["amplitudes"][1] == pytest.approx(full["amplitudes"][1], rel=1e-2)
+        assert adaptive["truncationError"] < 1e-3
+
+    def test_process_inputs_reports_truncation(self, inductor_inputs):
+        full = PyOpenMagnetics.process_inputs(inductor_inputs)
+        adaptive = PyOpenMagnetics.process_inputs(inductor_inputs, harmonic_energy_threshold=1e-4)
+
+        assert "harmonicTruncation" not in full
+        report = adaptive["harmonicTruncation"][0][0]["current"]
+        assert report["retainedHarmonics"] <= report["totalHarmonics"]
+        assert 0 <= report["truncationError"] <= 1e-2
+        harmonics = adaptive["operatingPoints"][0]["excitationsPerWinding"][0]["current"]["harmonics"]
+        assert len(harmonics["amplitudes"]) == report["retainedHarmonics"]
+        full_harmonics = full["operatingPoints"][0]["excitationsPerWinding"][0]["current"]["harmonics"]
+        assert len(harmonics["amplitudes"]) < len(full_harmonics["amplitudes"])
+
+    def test_truncated_harmonics_keep_winding_losses(self, inductor_inputs, wound_inductor):
+        full = PyOpenMagnetics.process_inputs(inductor_inputs)["operatingPoints"][0]
+        adaptive = PyOpenMagnetics.process_inputs(inductor_inputs, harmonic_energy_threshold=1e-4)["operatingPoints"][0]
+        temperature = full["conditions"]["ambientTemperature"]
+
+        full_losses = PyOpenMagnetics.calculate_winding_losses(wound_inductor, full, temperature)
+        adaptive_losses = PyOpenMagnetics.calculate_winding_losses(wound_inductor, adaptive, temperature)
+
+        assert "data" not in full_losses and "data" not in adaptive_losses
+        assert adaptive_losses["windingLosses"] == pytest.approx(full_losses["windingLosses"], rel=1e-2)
+
+    def test_invalid_threshold_is_reported(self, inductor_inputs):
+        result = PyOpenMagnetics.process_inputs(inductor_inputs, harmonic_energy_threshold=2.0)
+        assert "Exception" in result["data"]
+
+
+def _primary_excitation():
+    return {
+        "frequency": 100000,
+        "voltage": {
+            "waveform": {
+                "data": [10, 10, -10, -10, 10],
+                "time": [0, 0.000005, 0.000005, 0.00001, 0.00001]
+            }
+        },
+        "current": {
+            "waveform": {
+                "data": [-5, 5, -5],
+                "time": [0, 0.000005, 0.00001]
+            }
+        }
+    }
+
+
+class TestTransformExcitations:
+    """transform_excitations must match the single-step helpers."""
+
+    def test_reflection_matches_single_calls(self):
+        primary = _primary_excitation()
+        turn_ratios = [2, 4]
+        excitations = [_primary_excitation() for _ in turn_ratios]
+
+        result = PyOpenMagnetics.transform_excitations(
+            excitations, [[{"operation": "reflectToSecondary", "turnRatio": n}] for n in turn_ratios])
+
+        assert result is excitations
+        for turn_ratio, secondary in zip(turn_ratios, excitations):
+            expected = PyOpenMagnetics.calculate_reflected_secondary(primary, turn_ratio)
+            for signal in ("voltage", "current"):
+                assert secondary[signal]["processed"]["rms"] == pytest.approx(expected[signal]["processed"]["rms"])
+                assert secondary[signal]["harmonics"]["amplitudes"] == pytest.approx(expected[signal]["harmonics"]["amplitudes"])
+
+    def test_round_trip_restores_primary(self):
+        primary = PyOpenMagnetics.calculate_reflected_primary(
+            PyOpenMagnetics.calculate_reflected_secondary(_primary_excitation(), 3), 3)
+        excitations = [_primary_excitation()]
+
+        PyOpenMagnetics.transform_excitations(excitations, [
+            {"operation": "reflectToSecondary", "turnRatio": 3},
+            {"operation": "reflectToPrimary", "turnRatio": 3},
+        ], threads=1)
+
+        assert excitations[0]["voltage"]["processed"]["rms"] == pytest.approx(primary["voltage"]["processed"]["rms"])
+        assert excitations[0]["current"]["processed"]["rms"] == pytest.approx(primary["current"]["processed"]["rms"])
+
+    def test_unknown_operation_raises(self):
+        with pytest.raises(ValueError):
+            PyOpenMagnetics.transform_excitations([_primary_excitation()], [{"operation": "rotate", "turnRatio": 1}])
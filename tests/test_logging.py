@@ -257,3 +257,36 @@ class TestMultipleLogMessages:
         pos_third = logs.find("CCC_THIRD")
         
         assert pos_first < pos_second < pos_third
+
+
+class TestProfiling:
+    """Tests for enable_profiling / get_profile."""
+
+    def test_profile_records_adviser_scopes(self, inductor_inputs, reset_settings):
+        """An adviser run shows up as a scope tree with counters."""
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        PyOpenMagnetics.enable_profiling()
+        try:
+            PyOpenMagnetics.calculate_advised_magnetics_fast(processed_inputs, 1, "standard cores", 0, 64)
+            profile = PyOpenMagnetics.get_profile()
+        finally:
+            PyOpenMagnetics.disable_profiling()
+
+        assert profile["enabled"] is True
+        paths = {scope["path"]: scope for scope in profile["scopes"]}
+        assert paths["MagneticAdviser::fast"]["calls"] == 1
+        step = paths["MagneticAdviser::fast;MagneticAdviser::step"]
+        assert step["depth"] == 1
+        assert step["totalMs"] <= paths["MagneticAdviser::fast"]["totalMs"]
+        assert profile["counters"]["adviserCoresEvaluated"] > 0
+        assert "MagneticAdviser::fast;MagneticAdviser::step " in profile["folded"]
+
+    def test_reset_and_disabled_profile(self):
+        """Nothing is recorded while profiling is off."""
+        PyOpenMagnetics.reset_profile()
+        PyOpenMagnetics.disable_profiling()
+        PyOpenMagnetics.calculate_winding_losses({}, {}, 25)
+        profile = PyOpenMagnetics.get_profile()
+        assert profile["enabled"] is False
+        assert profile["scopes"] == []
+        assert profile["counters"] == {}
@@ -0,0 +1,74 @@
+"""
+Tests for PyOpenMagnetics loss and field bindings.
+
+These run on the shared wound_inductor fixture rather than on an advised
+design, so they neither depend on nor pay for an adviser search.
+"""
+import pytest
+import PyOpenMagnetics
+
+
+@pytest.fixture
+def operating_point(inductor_inputs):
+    return PyOpenMagnetics.process_inputs(inductor_inputs)["operatingPoints"][0]
+
+
+class TestFieldSolutionCache:
+    """Winding-window field solutions shared between field and loss bindings."""
+
+    def test_winding_losses_reuse_field_solution(self, operating_point, wound_inductor, reset_settings):
+        temperature = operating_point["conditions"]["ambientTemperature"]
+        uncached = PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, temperature)
+
+        PyOpenMagnetics.configure_field_solution_cache(8)
+        try:
+            PyOpenMagnetics.clear_field_solution_cache()
+            before = PyOpenMagnetics.get_field_solution_cache_stats()
+            field = PyOpenMagnetics.calculate_magnetic_field_strength_field(operating_point, wound_inductor)
+            cached = PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, temperature)
+            after = PyOpenMagnetics.get_field_solution_cache_stats()
+
+            assert "data" not in field
+            assert after["misses"] == before["misses"] + 1
+            assert after["hits"] == before["hits"] + 1
+            assert cached["windingLosses"] == pytest.approx(uncached["windingLosses"], rel=1e-9)
+        finally:
+            PyOpenMagnetics.configure_field_solution_cache(0)
+
+    def test_plots_share_the_cache(self, operating_point, wound_inductor, reset_settings):
+        temperature = operating_point["conditions"]["ambientTemperature"]
+        PyOpenMagnetics.configure_field_solution_cache(8)
+        try:
+            PyOpenMagnetics.clear_field_solution_cache()
+            before = PyOpenMagnetics.get_field_solution_cache_stats()
+            PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, temperature)
+            wire_losses = PyOpenMagnetics.plot_wire_losses(wound_inductor, operating_point)
+            first = PyOpenMagnetics.plot_magnetic_field(wound_inductor, operating_point)
+            second = PyOpenMagnetics.plot_magnetic_field(wound_inductor, operating_point)
+            after = PyOpenMagnetics.get_field_solution_cache_stats()
+
+            assert wire_losses["success"] and first["success"]
+            assert second["svg"] == first["svg"]
+            # The turn field once for the losses and the wire-loss plot, the
+            # painter-grid field once for both field plots.
+            assert after["misses"] == before["misses"] + 2
+            assert after["hits"] == before["hits"] + 2
+            assert after["entries"] == 2
+        finally:
+            PyOpenMagnetics.configure_field_solution_cache(0)
+
+
+class TestMagneticSession:
+    """A session must agree with the stateless loss bindings."""
+
+    def test_session_matches_stateless_winding_losses(self, operating_point, wound_inductor, reset_settings):
+        temperature = operating_point["conditions"]["ambientTemperature"]
+
+        session = PyOpenMagnetics.MagneticSession(wound_inductor)
+        evaluated = session.evaluate(operating_point)
+        stateless = PyOpenMagnetics.calculate_winding_losses(wound_inductor, operating_point, temperature)
+
+        assert "data" not in evaluated
+        assert evaluated["windingLosses"] == pytest.approx(stateless["windingLosses"], rel=1e-9)
+        assert evaluated["totalLosses"] == pytest.approx(evaluated["coreLosses"] + evaluated["windingLosses"])
+        assert session.evaluate(operating_point)["coreLosses"] == pytest.approx(evaluated["coreLosses"])
@@ -271,3 +271,145 @@ class TestMagneticAdviserFromCache:
         else:
             result_data = parse_json_result(result)
             assert isinstance(result_data, (dict, list))
+
+    def test_load_magnetics_from_string_reports_bad_record(self):
+        """A malformed NDJSON record is reported by its position."""
+        PyOpenMagnetics.clear_magnetic_cache()
+        result = PyOpenMagnetics.load_magnetics_from_string('{"coil": {}}\n\nnot json\n')
+
+        assert "record 2" in result
+
+    def test_load_magnetics_from_string_reports_unbuildable_record(self):
+        """A record that parses but cannot be built stops the load by default."""
+        PyOpenMagnetics.clear_magnetic_cache()
+        result = PyOpenMagnetics.load_magnetics_from_string('{"coil": {}}\n')
+
+        assert result.startswith("record 1: ")
+
+    def test_load_magnetics_from_string_skips_unbuildable_record(self):
+        """With skip_invalid a record that cannot be built is skipped and logged."""
+        PyOpenMagnetics.clear_magnetic_cache()
+        level = PyOpenMagnetics.get_log_level()
+        PyOpenMagnetics.set_log_level("WARNING")
+        PyOpenMagnetics.enable_string_sink()
+        PyOpenMagnetics.clear_logs()
+        try:
+            result = PyOpenMagnetics.load_magnetics_from_string('{"coil": {}}\n', skip_invalid=True)
+            logs = PyOpenMagnetics.get_logs()
+        finally:
+            PyOpenMagnetics.disable_string_sink()
+            PyOpenMagnetics.set_log_level(level)
+
+        assert result == "0"
+        assert "record 1 skipped" in logs
+
+
+class TestBudgetedFastAdviser:
+    """time_budget_ms / max_evaluations on the fast adviser."""
+
+    def test_max_evaluations_truncates_search(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        result = PyOpenMagnetics.calculate_advised_magnetics_fast(processed_inputs, 3, "available cores", 0, 64)
+
+        assert isinstance(result["data"], list)
+        assert result["evaluatedCores"] == min(64, result["totalCores"])
+        assert result["truncated"] == (result["totalCores"] > 64)
+        scorings = [item["scoring"] for item in result["data"]]
+        assert scorings == sorted(scorings)
+        assert len(scorings) <= 3
+
+
+class TestAdviserProgress:
+    """progress_callback / cancellation_token on the magnetic advisers."""
+
+    def test_cancelled_token_returns_immediately(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        token = PyOpenMagnetics.CancellationToken()
+        token.cancel()
+        result = PyOpenMagnetics.calculate_advised_magnetics(
+            processed_inputs, 3, "standard cores", cancellation_token=token, interruptible=True)
+
+        assert result["cancelled"] is True
+        assert result["evaluatedCores"] == 0
+        assert result["data"] == []
+
+        plain = PyOpenMagnetics.calculate_advised_magnetics(
+            processed_inputs, 3, "standard cores", cancellation_token=token)
+        assert plain["cancelled"] is True
+        assert plain["data"] == []
+
+        token.reset()
+        assert token.cancelled is False
+
+    def test_callback_receives_progress_and_can_stop(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        reports = []
+
+        def on_progress(progress):
+            reports.append(progress)
+            return False
+
+        result = PyOpenMagnetics.calculate_advised_magnetics_fast(
+            processed_inputs, 3, "standard cores", progress_callback=on_progress, interruptible=True)
+
+        # The stop is seen before the next step, if there is one.
+        assert result["cancelled"] == (result["evaluatedCores"] < result["totalCores"])
+        assert reports[0]["phase"] == "screening"
+        assert reports[-1]["phase"] == "done"
+        assert set(reports[0]) == {"phase", "evaluated", "total", "bestScore", "elapsedMs"}
+        assert result["evaluatedCores"] == reports[0]["evaluated"]
+
+    def test_callback_alone_keeps_the_plain_search(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        reports = []
+
+        expected = PyOpenMagnetics.calculate_advised_magnetics_fast(processed_inputs, 3, "standard cores")
+        result = PyOpenMagnetics.calculate_advised_magnetics_fast(
+            processed_inputs, 3, "standard cores", progress_callback=reports.append)
+
+        assert [report["phase"] for report in reports] == ["search", "done"]
+        assert result["cancelled"] is False
+        assert "evaluatedCores" not in result
+        assert result["data"] == expected["data"]
+
+
+class TestAdviserResultHandles:
+    """return_handles=True must describe the same designs as the dict results."""
+
+    def test_handles_match_dict_results(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        dicts = extract_magnetics_list(PyOpenMagnetics.calculate_advised_magnetics(processed_inputs, 2, "available cores"))
+        handles = PyOpenMagnetics.calculate_advised_magnetics(processed_inputs, 2, "available cores", return_handles=True)["data"]
+        if not dicts:
+            pytest.skip("adviser returned no design")
+
+        assert len(handles) == len(dicts)
+        for handle, expected in zip(handles, dicts):
+            assert isinstance(handle, PyOpenMagnetics.MasHandle)
+            assert handle.scoring == pytest.approx(expected["scoring"])
+            assert handle["scoring"] == handle.scoring
+            assert handle.to_dict()["magnetic"]["core"]["name"] == expected["mas"]["magnetic"]["core"]["name"]
+            assert handle.magnetic.core_name == expected["mas"]["magnetic"]["core"]["name"]
+            functional_description = expected["mas"]["magnetic"]["coil"]["functionalDescription"]
+            assert handle.magnetic.number_turns == [winding["numberTurns"] for winding in functional_description]
+            if "scoringPerFilter" in expected:
+                assert handle.scoring_per_filter == pytest.approx(expected["scoringPerFilter"])
+
+    def test_fast_handles_have_no_filter_scorings(self, inductor_inputs, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+        result = PyOpenMagnetics.calculate_advised_magnetics_fast(processed_inputs, 2, "standard cores", 0, 40, return_handles=True)
+        if not result["data"]:
+            pytest.skip("adviser returned no design")
+
+        assert "evaluatedCores" in result
+        best = result["data"][0]
+        assert best.scoring_per_filter is None
+        assert "scoringPerFilter" not in best
+        assert best.to_result_dict()["scoring"] == best.scoring
+        with pytest.raises(KeyError):
+            best["unknown"]
+
+    def test_handle_errors_use_dict_envelope(self, reset_settings):
+        result = PyOpenMagnetics.calculate_advised_magnetics({}, 1, "available cores", return_handles=True)
+        assert isinstance(result["data"], str)
+        assert result["data"].startswith("Exception")
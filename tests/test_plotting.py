@@ -464,6 +464,53 @@ def test_plot_electric_field():
         return False
 
 
+def test_plot_batch():
+    """Test rendering several plots in one parallel batch."""
+    print("\n=== Testing plot_batch ===")
+
+    round_wire = pom.find_wire_by_name("Round 1.00 - Grade 1")
+    rectangular_wire = pom.find_wire_by_name("Rectangular 2.36x1.12 - Grade 1")
+    items = [
+        {"kind": "wire", "wire": round_wire},
+        {"kind": "wire", "wire": rectangular_wire},
+        {"kind": "not_a_plot", "wire": round_wire},
+        {"kind": "wire", "wire": round_wire},
+    ]
+    leftovers_before = set(f for f in os.listdir(_temp_dir) if f.startswith("pyom_plot_"))
+
+    results = pom.plot_batch(items, threads=4)
+
+    assert len(results) == len(items)
+    assert results[0]["success"] and "<svg" in results[0]["svg"]
+    assert results[1]["success"] and "<svg" in results[1]["svg"]
+    assert not results[2]["success"]
+    assert "not_a_plot" in results[2]["error"]
+    # Same input, same SVG, whatever worker rendered it
+    assert results[3]["svg"] == results[0]["svg"]
+    assert results[0]["svg"] == pom.plot_wire(round_wire)["svg"]
+
+    leftovers_after = set(f for f in os.listdir(_temp_dir) if f.startswith("pyom_plot_"))
+    assert leftovers_after <= leftovers_before
+    print("✓ Batch of 4 rendered, bad kind reported in place")
+
+    return True
+
+
+def test_plot_turns_keeps_litz_settings(wound_inductor):
+    """Turn plots paint litz in the simple style without changing the settings."""
+    pom.reset_settings()
+    pom.set_settings({"painterSimpleLitz": False, "painterAdvancedLitz": True})
+    try:
+        result = pom.plot_turns(wound_inductor)
+        settings = pom.get_settings()
+    finally:
+        pom.reset_settings()
+
+    assert result["success"], result.get("error")
+    assert settings["painterSimpleLitz"] is False
+    assert settings["painterAdvancedLitz"] is True
+
+
 def run_all_tests():
     """Run all plotting tests and report results."""
     print("=" * 60)
@@ -478,6 +525,7 @@ def run_all_tests():
         ("Bobbin", test_plot_bobbin),
         ("Magnetic Field", test_plot_magnetic_field),
         ("Electric Field", test_plot_electric_field),
+        ("Batch", test_plot_batch),
     ]
     
     results = []
@@ -0,0 +1,101 @@
+"""
+Tests for PyOpenMagnetics simulation and sweep bindings.
+
+These run on the shared wound_inductor fixture rather than on an advised
+design, so they neither depend on nor pay for an adviser search.
+"""
+import pytest
+import PyOpenMagnetics
+
+
+MODELS = {"coreLosses": "IGSE", "reluctance": "ZHANG"}
+
+
+class TestSimulationCache:
+    """simulate() result cache."""
+
+    def test_repeated_simulate_hits_cache(self, inductor_inputs, wound_inductor, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        PyOpenMagnetics.configure_simulation_cache(8)
+        try:
+            PyOpenMagnetics.clear_simulation_cache()
+            before = PyOpenMagnetics.get_simulation_cache_stats()
+            first = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS)
+            second = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS)
+            after = PyOpenMagnetics.get_simulation_cache_stats()
+
+            assert "data" not in first
+            assert second == first
+            assert after["hits"] == before["hits"] + 1
+            assert after["entries"] == 1
+        finally:
+            PyOpenMagnetics.configure_simulation_cache(0)
+
+    def test_different_requests_do_not_share_an_entry(self, inductor_inputs, wound_inductor, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        PyOpenMagnetics.configure_simulation_cache(8)
+        try:
+            PyOpenMagnetics.clear_simulation_cache()
+            igse = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS)
+            steinmetz = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, dict(MODELS, coreLosses="STEINMETZ"))
+            stats = PyOpenMagnetics.get_simulation_cache_stats()
+
+            assert stats["entries"] == 2
+            assert stats["hits"] == 0
+            assert PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS) == igse
+            assert PyOpenMagnetics.simulate(processed_inputs, wound_inductor, dict(MODELS, coreLosses="STEINMETZ")) == steinmetz
+        finally:
+            PyOpenMagnetics.configure_simulation_cache(0)
+
+    def test_simulate_outputs_selector(self, inductor_inputs, wound_inductor, reset_settings):
+        processed_inputs = PyOpenMagnetics.process_inputs(inductor_inputs)
+
+        full = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS)
+        selected = PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS, ["coreLosses"])
+
+        assert set(selected["outputs"][0].keys()) == {"coreLosses"}
+        assert selected["outputs"][0]["coreLosses"]["coreLosses"] == pytest.approx(full["outputs"][0]["coreLosses"]["coreLosses"], rel=1e-6)
+        assert "data" in PyOpenMagnetics.simulate(processed_inputs, wound_inductor, MODELS, ["notAnOutput"])
+
+
+class TestParallelSweeps:
+    """Chunked sweeps must reproduce the serial curve."""
+
+    def test_threaded_impedance_sweep_matches_serial(self, wound_inductor, reset_settings):
+        serial = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 1e3, 1e7, 200, "log", "Z", 1)
+        threaded = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 1e3, 1e7, 200, "log", "Z", 4)
+
+        assert len(threaded["xPoints"]) == len(serial["xPoints"]) == 200
+        assert threaded["xPoints"] == pytest.approx(serial["xPoints"], rel=1e-9)
+        assert threaded["yPoints"] == pytest.approx(serial["yPoints"], rel=1e-9)
+
+    def test_threaded_linear_sweep_matches_serial(self, wound_inductor, reset_settings):
+        serial = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 1e3, 1e6, 64, "linear", "Z", 1)
+        threaded = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 1e3, 1e6, 64, "linear", "Z", 4)
+
+        assert threaded["xPoints"] == pytest.approx(serial["xPoints"], rel=1e-9)
+        assert threaded["yPoints"] == pytest.approx(serial["yPoints"], rel=1e-9)
+
+    @pytest.mark.parametrize("threads", [1, 4])
+    def test_unknown_sweep_mode_is_rejected(self, wound_inductor, threads):
+        result = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 1e3, 1e7, 200, "logarithmic", "Z", threads)
+        assert "Unknown sweep mode" in result["data"]
+
+    def test_log_sweep_needs_positive_bounds(self, wound_inductor):
+        result = PyOpenMagnetics.sweep_impedance_over_frequency(wound_inductor, 0, 1e7, 200, "log", "Z", 4)
+        assert "positive" in result["data"]
+
+    def test_sweep_grid_shape_and_threads(self, inductor_inputs, wound_inductor, reset_settings):
+        operating_point = PyOpenMagnetics.process_inputs(inductor_inputs)["operatingPoints"][0]
+        axes = [("temperature", [25, 100]), ("frequency", [50e3, 100e3, 200e3])]
+
+        serial = PyOpenMagnetics.sweep_grid(wound_inductor, operating_point, axes, None, 1)
+        threaded = PyOpenMagnetics.sweep_grid(wound_inductor, operating_point, axes, None, 4)
+
+        assert serial["axes"] == ["temperature", "frequency"]
+        assert serial["coreLosses"].shape == (2, 3)
+        assert serial["failedPoints"] == 0
+        assert threaded["coreLosses"].tolist() == pytest.approx(serial["coreLosses"].tolist(), rel=1e-9)
+        assert threaded["windingLosses"].tolist() == pytest.approx(serial["windingLosses"].tolist(), rel=1e-9)
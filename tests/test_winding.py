@@ -3,6 +3,8 @@ Tests for PyOpenMagnetics Winding functions.
 
 These tests verify wire, bobbin, and insulation material retrieval.
 """
+from concurrent.futures import ThreadPoolExecutor
+
 import pytest
 import PyOpenMagnetics
 
@@ -38,6 +40,49 @@ class TestWires:
             assert "type" in wire
 
 
+class TestWireIndex:
+    """query_wire_index must agree with the wire database."""
+
+    def test_area_window_is_sorted_and_bounded(self):
+        everything = PyOpenMagnetics.query_wire_index({"type": "round"})
+        assert everything["count"] > 0
+        areas = [wire["conductingArea"] for wire in everything["data"]]
+        assert areas == sorted(areas)
+
+        low, high = areas[len(areas) // 4], areas[len(areas) // 2]
+        window = PyOpenMagnetics.query_wire_index({"type": "round", "conductingArea": [low, high]})
+        assert 0 < window["count"] <= everything["count"]
+        assert all(low <= wire["conductingArea"] <= high for wire in window["data"])
+        wire = PyOpenMagnetics.find_wire_by_name(window["data"][0]["name"])
+        assert wire["type"] == "round"
+
+    def test_skin_factor_filter(self):
+        query = {"type": "round", "frequency": 200e3, "maximumNumberResults": 20}
+        result = PyOpenMagnetics.query_wire_index(query)
+        assert len(result["data"]) <= 20
+        assert all(wire["skinAcFactor"] >= 1 - 1e-9 for wire in result["data"])
+
+        limited = PyOpenMagnetics.query_wire_index(dict(query, maximumSkinAcFactor=1.05))
+        assert all(wire["skinAcFactor"] <= 1.05 for wire in limited["data"])
+
+    def test_concurrent_queries_match_serial(self):
+        queries = [{"type": "round", "maximumNumberResults": 10},
+                   {"type": "round", "frequency": 100e3, "maximumNumberResults": 10}] * 4
+        serial = [PyOpenMagnetics.query_wire_index(query) for query in queries]
+        with ThreadPoolExecutor(max_workers=4) as pool:
+            concurrent = list(pool.map(PyOpenMagnetics.query_wire_index, queries))
+        assert concurrent == serial
+
+    def test_unknown_key_is_reported(self):
+        result = PyOpenMagnetics.query_wire_index({"diameter": [0, 1]})
+        assert "Exception" in result["data"]
+
+    def test_batch_advice_reports_errors_per_request(self):
+        result = PyOpenMagnetics.calculate_advised_wires_batch([{"winding": {}}, {}], 1)
+        assert len(result["data"]) == 2
+        assert all("error" in item for item in result["data"])
+
+
 class TestWireMaterials:
     """Test wire material data."""
 